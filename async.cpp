@@ -0,0 +1,218 @@
+#include "Async.h"
+#include <algorithm>
+
+namespace {
+    // Awaitable giving a bulk coroutine its own progress state without suspending
+    struct StateOf {
+        std::shared_ptr<BulkTask::State> state;
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<BulkTask::promise_type> self) {
+            state = self.promise().state;
+            return false;
+        }
+        std::shared_ptr<BulkTask::State> await_resume() { return std::move(state); }
+    };
+
+    // Throws an exception if the options cannot drive a bulk operation
+    void validate(const AsyncOptions& options) {
+        if (options.chunk == 0) {
+            throw std::invalid_argument("Chunk size must be positive");
+        }
+    }
+
+    // Apply items [0, total) in chunks, yielding to the executor between chunks
+    // apply(from, to, processed) handles one chunk and counts what it applied in processed;
+    // prepare() runs in the first step, before any item
+    template <typename Prepare, typename Apply>
+    BulkTask runChunks(size_t total, Executor& executor, AsyncOptions options, Prepare prepare, Apply apply) {
+        const auto state = co_await StateOf{};
+        state->progress.total = total;
+        co_await Reschedule{ executor };
+        prepare();
+        for (size_t from = 0; from < total; from += options.chunk) {
+            if (from != 0) {
+                co_await Reschedule{ executor };
+            }
+            if (state->cancel_requested) {
+                state->progress.cancelled = true;
+                co_return;
+            }
+            apply(from, std::min(total, from + options.chunk), state->progress.processed);
+        }
+    }
+}
+
+// Destructor; abandons work still queued, which marks those operations cancelled
+QueueExecutor::~QueueExecutor() {
+    while (!queue.empty()) {
+        std::coroutine_handle<> work = queue.front();
+        queue.pop_front();
+        work.destroy();
+    }
+}
+
+// Queue work to run after everything already queued
+void QueueExecutor::post(std::coroutine_handle<> work) {
+    queue.push_back(work);
+}
+
+// Run the oldest queued work until it yields or finishes
+// Returns false if nothing was queued
+bool QueueExecutor::runOne() {
+    if (queue.empty()) {
+        return false;
+    }
+    std::coroutine_handle<> work = queue.front();
+    queue.pop_front();
+    work.resume();
+    return true;
+}
+
+// Run queued work, including work queued meanwhile, until the queue is empty
+// Returns the number of steps run
+size_t QueueExecutor::runUntilIdle() {
+    size_t steps = 0;
+    while (runOne()) {
+        ++steps;
+    }
+    return steps;
+}
+
+// Get the number of queued steps
+size_t QueueExecutor::pending() const {
+    return queue.size();
+}
+
+// An operation whose frame is destroyed before it finished counts as cancelled
+BulkTask::promise_type::~promise_type() {
+    if (!state->progress.done) {
+        state->progress.cancelled = true;
+        state->progress.done = true;
+    }
+}
+
+void BulkTask::promise_type::return_void() {
+    state->progress.done = true;
+}
+
+void BulkTask::promise_type::unhandled_exception() {
+    state->error = std::current_exception();
+    state->progress.failed = true;
+    state->progress.done = true;
+}
+
+// Get a snapshot of the operation's progress
+BulkProgress BulkTask::getProgress() const {
+    return state->progress;
+}
+
+bool BulkTask::done() const {
+    return state->progress.done;
+}
+
+// Ask the operation to stop at its next chunk boundary
+void BulkTask::cancel() {
+    state->cancel_requested = true;
+}
+
+// Rethrow the exception that stopped the operation, if any
+void BulkTask::rethrowIfFailed() const {
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+// Add members to the club in chunks
+// Room for all of them is reserved up front, so no chunk pays for growing the indexes
+// Throws an exception if the options are invalid
+BulkTask addMembersAsync(Club& club, std::vector<Member*> members, Executor& executor, AsyncOptions options) {
+    validate(options);
+    const size_t total = members.size();
+    return runChunks(total, executor, options, [&club, total]() { club.reserveMembers(total); },
+                     [&club, members = std::move(members)](size_t from, size_t to, size_t& processed) {
+        for (size_t i = from; i < to; ++i) {
+            club.addMember(members[i]);
+            ++processed;
+        }
+        });
+}
+
+// Sign members up for an event in chunks, one addMembersToEvent call per chunk
+// Throws an exception if the options are invalid
+BulkTask addMembersToEventAsync(Club& club, std::string event_name, std::vector<Member*> members,
+                                Executor& executor, AsyncOptions options) {
+    validate(options);
+    const size_t total = members.size();
+    return runChunks(total, executor, options, []() {},
+                     [&club, event_name = std::move(event_name), members = std::move(members)](size_t from, size_t to,
+                                                                                              size_t& processed) {
+        club.addMembersToEvent(event_name, std::vector<Member*>(members.begin() + from, members.begin() + to));
+        processed += to - from;
+        });
+}
+
+// Add teams to an event in chunks of teams
+// Throws an exception if the options are invalid
+BulkTask addTeamsToEventAsync(Club& club, std::string event_name, std::vector<Team*> teams, Executor& executor,
+                              AsyncOptions options) {
+    validate(options);
+    const size_t total = teams.size();
+    return runChunks(total, executor, options, []() {},
+                     [&club, event_name = std::move(event_name), teams = std::move(teams)](size_t from, size_t to,
+                                                                                          size_t& processed) {
+        for (size_t i = from; i < to; ++i) {
+            club.addTeamToEvent(event_name, teams[i]);
+            ++processed;
+        }
+        });
+}
+
+// Remove members in chunks, one single-pass removeMembers cascade per chunk
+// Each cascade walks every team and event, so larger chunks finish sooner overall
+// Throws an exception if the options are invalid
+BulkTask removeMembersAsync(Club& club, std::vector<Member*> members, Executor& executor, AsyncOptions options) {
+    validate(options);
+    const size_t total = members.size();
+    return runChunks(total, executor, options, []() {},
+                     [&club, members = std::move(members)](size_t from, size_t to, size_t& processed) {
+        club.removeMembers(std::vector<Member*>(members.begin() + from, members.begin() + to));
+        processed += to - from;
+        });
+}
+
+namespace {
+    BulkTask importMembers(Club& club, BoundedChannel<Member*>& source, Executor& executor, AsyncOptions options) {
+        const auto state = co_await StateOf{};
+        co_await Reschedule{ executor };
+        while (true) {
+            if (state->cancel_requested) {
+                state->progress.cancelled = true;
+                co_return;
+            }
+            const std::optional<Member*> first = co_await source.pop();
+            if (!first) {
+                co_return;
+            }
+            std::vector<Member*> chunk = source.drain(options.chunk - 1);
+            chunk.insert(chunk.begin(), *first);
+            state->progress.total += chunk.size();
+            for (auto member : chunk) {
+                club.addMember(member);
+                ++state->progress.processed;
+            }
+            co_await Reschedule{ executor };
+        }
+    }
+}
+
+// Add members as a producer feeds them through a channel, until the channel is closed
+// The import takes at most a chunk per step, so a full channel stays full, and the
+// producer is held back, until the club has caught up. The import checks for a cancel
+// between chunks; one parked on an empty channel sees it after the next chunk arrives,
+// and items left in the channel stay there.
+// Throws an exception if the options are invalid
+BulkTask importMembersAsync(Club& club, BoundedChannel<Member*>& source, Executor& executor, AsyncOptions options) {
+    validate(options);
+    return importMembers(club, source, executor, options);
+}
@@ -0,0 +1,239 @@
+#ifndef ASYNC_H
+#define ASYNC_H
+
+// Coroutine-based bulk operations; this header and async.cpp need C++20
+#if !defined(__cpp_impl_coroutine)
+#error "async.h needs C++20 coroutines (compile with -std=c++20)"
+#endif
+
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Club.h"
+
+// Runs resumable work; the bulk operations post every chunk through one of these
+// Club does no locking, so an executor must resume work on the thread that owns the club.
+class Executor {
+public:
+    virtual ~Executor() = default;
+    virtual void post(std::coroutine_handle<> work) = 0;
+};
+
+// Executor with a FIFO run queue that the owning thread drains at its own pace
+// A server loop can call runOne() between requests, so a long import advances one
+// chunk at a time without ever holding the thread for longer than a chunk.
+class QueueExecutor : public Executor {
+private:
+    std::deque<std::coroutine_handle<>> queue;
+
+public:
+    QueueExecutor() = default;
+    QueueExecutor(const QueueExecutor&) = delete;
+    QueueExecutor& operator=(const QueueExecutor&) = delete;
+    ~QueueExecutor() override;
+
+    void post(std::coroutine_handle<> work) override;
+    bool runOne();
+    size_t runUntilIdle();
+    size_t pending() const;
+};
+
+// Tuning of a bulk operation
+struct AsyncOptions {
+    size_t chunk = 256;  // items handled between two yields to the executor
+};
+
+// Where a bulk operation stands
+struct BulkProgress {
+    size_t processed;  // items applied so far; these stay applied after a cancel or a failure
+    size_t total;      // items known so far; grows while a channel import is still open
+    bool done;
+    bool cancelled;
+    bool failed;
+};
+
+// Handle to a running bulk operation
+// The operation runs on its executor whether or not the handle is kept; dropping the
+// handle only gives up the ability to observe and cancel it.
+class BulkTask {
+public:
+    struct State {
+        BulkProgress progress{ 0, 0, false, false, false };
+        bool cancel_requested = false;
+        std::exception_ptr error;
+    };
+
+    struct promise_type {
+        std::shared_ptr<State> state = std::make_shared<State>();
+
+        ~promise_type();
+
+        BulkTask get_return_object() { return BulkTask(state); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void();
+        void unhandled_exception();
+    };
+
+private:
+    std::shared_ptr<State> state;
+
+    explicit BulkTask(std::shared_ptr<State> state) : state(std::move(state)) {}
+
+public:
+    BulkProgress getProgress() const;
+    bool done() const;
+    void cancel();
+    void rethrowIfFailed() const;
+};
+
+// Awaitable that hands the rest of a coroutine back to the executor's queue
+struct Reschedule {
+    Executor& executor;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> work) const { executor.post(work); }
+    void await_resume() const noexcept {}
+};
+
+// Bounded queue between a producer and a bulk import, for backpressure
+// tryPush() refuses items once capacity items are waiting, and a producing coroutine can
+// co_await push() to be parked until the import makes room. The import parks in turn
+// while the channel is empty. Everything runs on the executor's thread.
+template <typename T>
+class BoundedChannel {
+private:
+    Executor& executor;
+    size_t capacity;
+    std::deque<T> items;
+    bool closed;
+    std::coroutine_handle<> waiting_consumer;
+    std::deque<std::coroutine_handle<>> waiting_producers;
+
+    void wakeConsumer() {
+        if (waiting_consumer) {
+            executor.post(std::exchange(waiting_consumer, nullptr));
+        }
+    }
+
+    void wakeProducer() {
+        if (!waiting_producers.empty() && items.size() < capacity) {
+            executor.post(waiting_producers.front());
+            waiting_producers.pop_front();
+        }
+    }
+
+public:
+    // Throws an exception if capacity is zero
+    BoundedChannel(Executor& executor, size_t capacity)
+        : executor(executor), capacity(capacity), closed(false) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Channel capacity must be positive");
+        }
+    }
+
+    BoundedChannel(const BoundedChannel&) = delete;
+    BoundedChannel& operator=(const BoundedChannel&) = delete;
+
+    // Add an item unless the channel is full or closed
+    bool tryPush(T item) {
+        if (closed || items.size() >= capacity) {
+            return false;
+        }
+        items.push_back(std::move(item));
+        wakeConsumer();
+        return true;
+    }
+
+    // Awaitable push that parks the producer while the channel is full
+    // Throws an exception if the channel is closed
+    auto push(T item) {
+        struct Push {
+            BoundedChannel& channel;
+            T item;
+
+            bool await_ready() const noexcept { return channel.closed || channel.items.size() < channel.capacity; }
+            void await_suspend(std::coroutine_handle<> producer) { channel.waiting_producers.push_back(producer); }
+            void await_resume() {
+                if (channel.closed) {
+                    throw std::invalid_argument("Channel is closed");
+                }
+                channel.items.push_back(std::move(item));
+                channel.wakeConsumer();
+            }
+        };
+        return Push{ *this, std::move(item) };
+    }
+
+    // Awaitable pop that parks the consumer while the channel is empty and open
+    // Resumes with nothing once the channel is closed and drained
+    auto pop() {
+        struct Pop {
+            BoundedChannel& channel;
+
+            bool await_ready() const noexcept { return !channel.items.empty() || channel.closed; }
+            void await_suspend(std::coroutine_handle<> consumer) { channel.waiting_consumer = consumer; }
+            std::optional<T> await_resume() {
+                if (channel.items.empty()) {
+                    return std::nullopt;
+                }
+                T item = std::move(channel.items.front());
+                channel.items.pop_front();
+                channel.wakeProducer();
+                return item;
+            }
+        };
+        return Pop{ *this };
+    }
+
+    // Take every waiting item at once, up to limit
+    std::vector<T> drain(size_t limit) {
+        std::vector<T> taken;
+        while (!items.empty() && taken.size() < limit) {
+            taken.push_back(std::move(items.front()));
+            items.pop_front();
+        }
+        while (!waiting_producers.empty() && items.size() < capacity) {
+            wakeProducer();
+        }
+        return taken;
+    }
+
+    // No more items will come; the import finishes once the channel is drained
+    void close() {
+        closed = true;
+        wakeConsumer();
+        while (!waiting_producers.empty()) {
+            executor.post(waiting_producers.front());
+            waiting_producers.pop_front();
+        }
+    }
+
+    bool isClosed() const { return closed; }
+    size_t size() const { return items.size(); }
+    bool full() const { return items.size() >= capacity; }
+};
+
+// Asynchronous counterparts of the club's bulk operations
+// Each returns at once and runs on the executor from its first item on. Items are
+// applied in chunks of options.chunk, yielding to the executor between
+// chunks and stopping at the next chunk boundary once cancelled. A failing item (a
+// duplicate member, say) stops the operation; BulkTask::rethrowIfFailed() reports it.
+// The club and the items must outlive the operation.
+BulkTask addMembersAsync(Club& club, std::vector<Member*> members, Executor& executor, AsyncOptions options = {});
+BulkTask addMembersToEventAsync(Club& club, std::string event_name, std::vector<Member*> members,
+                                Executor& executor, AsyncOptions options = {});
+BulkTask addTeamsToEventAsync(Club& club, std::string event_name, std::vector<Team*> teams, Executor& executor,
+                              AsyncOptions options = {});
+BulkTask removeMembersAsync(Club& club, std::vector<Member*> members, Executor& executor, AsyncOptions options = {});
+BulkTask importMembersAsync(Club& club, BoundedChannel<Member*>& source, Executor& executor,
+                            AsyncOptions options = {});
+
+#endif // ASYNC_H
@@ -0,0 +1,305 @@
+#include "Attendance.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "Graph.h"
+
+namespace {
+    void writeVarint(std::vector<std::uint8_t>& bytes, std::uint64_t value) {
+        while (value >= 0x80) {
+            bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        bytes.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    std::uint64_t readVarint(const std::uint8_t*& data) {
+        std::uint64_t value = 0;
+        int shift = 0;
+        while (*data & 0x80) {
+            value |= static_cast<std::uint64_t>(*data++ & 0x7f) << shift;
+            shift += 7;
+        }
+        value |= static_cast<std::uint64_t>(*data++) << shift;
+        return value;
+    }
+
+    std::uint64_t zigzag(std::int64_t value) {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    std::int64_t unzigzag(std::uint64_t value) {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+}
+
+// Constructor for an empty store
+AttendanceStore::AttendanceStore() : record_count(0), last_lookup(0) {}
+
+// Get the shared table entry of an event, adding it on first use
+// Sessions are told apart by day, start time, name and location, so two sessions of an
+// event at one venue on the same day stay separate
+std::uint32_t AttendanceStore::eventId(const Event& event) {
+    const std::int32_t day = event.getCalendarDate().getDayNumber();
+    const int start_minute = event.getStartMinute();
+    std::string name = event.getName();
+    std::string location = event.getLocation();
+
+    // Callers usually record one event for many members in a row
+    if (last_lookup < event_table.size()) {
+        const EventInfo& last = event_table[last_lookup];
+        if (last.day == day && last.start_minute == start_minute && last.name == name && last.location == location) {
+            return last_lookup;
+        }
+    }
+    auto key = std::make_tuple(day, start_minute, std::move(name), std::move(location));
+    auto it = event_index.find(key);
+    if (it != event_index.end()) {
+        last_lookup = it->second;
+        return last_lookup;
+    }
+    last_lookup = static_cast<std::uint32_t>(event_table.size());
+    event_table.push_back({ day, start_minute, std::get<2>(key), std::get<3>(key) });
+    event_index.emplace(std::move(key), last_lookup);
+    return last_lookup;
+}
+
+// Append a record that is not older than the timeline's last one
+void AttendanceStore::append(Timeline& timeline, std::int32_t day, std::uint32_t event) {
+    if (timeline.count == 0) {
+        timeline.last_day = day;
+        timeline.last_event = event;
+    }
+    if (timeline.count % BLOCK_RECORDS == 0) {
+        timeline.skips.push_back({ timeline.last_day, timeline.last_event, static_cast<std::uint32_t>(timeline.bytes.size()) });
+    }
+    writeVarint(timeline.bytes, static_cast<std::uint64_t>(day - timeline.last_day));
+    writeVarint(timeline.bytes, zigzag(static_cast<std::int64_t>(event) - timeline.last_event));
+    timeline.last_day = day;
+    timeline.last_event = event;
+    ++timeline.count;
+}
+
+// Get the block holding the first record on or after the given day
+size_t AttendanceStore::firstBlock(const Timeline& timeline, std::int32_t day) {
+    auto it = std::lower_bound(timeline.skips.begin(), timeline.skips.end(), day, [](const Skip& skip, std::int32_t value) {
+        return skip.day < value;
+        });
+    const size_t index = static_cast<size_t>(it - timeline.skips.begin());
+    return index == 0 ? 0 : index - 1;
+}
+
+// Decode records in order from the start of a block until the visitor returns false
+template <typename Visit>
+void AttendanceStore::scan(const Timeline& timeline, size_t block, Visit&& visit) {
+    if (block >= timeline.skips.size()) {
+        return;
+    }
+    const Skip& skip = timeline.skips[block];
+    const std::uint8_t* data = timeline.bytes.data() + skip.offset;
+    std::int32_t day = skip.day;
+    std::int64_t event = skip.event;
+    for (size_t index = block * BLOCK_RECORDS; index < timeline.count; ++index) {
+        day += static_cast<std::int32_t>(readVarint(data));
+        event += unzigzag(readVarint(data));
+        if (!visit(index, day, static_cast<std::uint32_t>(event))) {
+            return;
+        }
+    }
+}
+
+// Check whether a timeline already holds the given event on the given day
+bool AttendanceStore::contains(const Timeline& timeline, std::int32_t day, std::uint32_t event) {
+    bool found = false;
+    scan(timeline, firstBlock(timeline, day), [&](size_t, std::int32_t record_day, std::uint32_t record_event) {
+        if (record_day == day && record_event == event) {
+            found = true;
+        }
+        return !found && record_day <= day;
+        });
+    return found;
+}
+
+// Get a member's timeline, or null if nothing was recorded for them
+const AttendanceStore::Timeline* AttendanceStore::find(int member_id) const {
+    auto it = timelines.find(member_id);
+    return it == timelines.end() ? nullptr : &it->second;
+}
+
+// Record that a member attended an event
+// Returns false if the attendance was already recorded
+bool AttendanceStore::record(int member_id, const Event& event) {
+    const bool added = insert(member_id, eventId(event));
+    record_count += added;
+    return added;
+}
+
+// Add a record for an event already in the table unless it is there
+bool AttendanceStore::insert(int member_id, std::uint32_t event) {
+    const std::int32_t day = event_table[event].day;
+    Timeline& timeline = timelines[member_id];
+    if (timeline.count == 0 || day > timeline.last_day) {
+        append(timeline, day, event);
+        return true;
+    }
+    if (contains(timeline, day, event)) {
+        return false;
+    }
+
+    if (day == timeline.last_day) {
+        append(timeline, day, event);
+    }
+    else {
+        // Back-filled history: decode, insert in date order and re-encode
+        std::vector<std::pair<std::int32_t, std::uint32_t>> records;
+        records.reserve(timeline.count + 1);
+        scan(timeline, 0, [&records](size_t, std::int32_t record_day, std::uint32_t record_event) {
+            records.emplace_back(record_day, record_event);
+            return true;
+            });
+        auto position = std::upper_bound(records.begin(), records.end(), day,
+            [](std::int32_t value, const std::pair<std::int32_t, std::uint32_t>& item) {
+                return value < item.first;
+            });
+        records.insert(position, { day, event });
+        Timeline rebuilt;
+        rebuilt.bytes.reserve(timeline.bytes.size() + 8);
+        for (const auto& item : records) {
+            append(rebuilt, item.first, item.second);
+        }
+        timeline = std::move(rebuilt);
+    }
+    return true;
+}
+
+// Record every participant of an event, including members of its teams
+// Returns the number of new records
+size_t AttendanceStore::recordEvent(const Event& event) {
+    const std::uint32_t id = eventId(event);
+    size_t added = 0;
+    for (int member_id : CoParticipationGraph::distinctIds(event)) {
+        added += insert(member_id, id);
+    }
+    record_count += added;
+    return added;
+}
+
+// Count the sessions a member attended between two dates, inclusive
+// Only the blocks at the two ends of the range are decoded
+size_t AttendanceStore::countBetween(int member_id, Date from, Date to) const {
+    const Timeline* timeline = find(member_id);
+    if (timeline == nullptr || to < from) {
+        return 0;
+    }
+    // Number of records before a given day
+    auto rank = [timeline](std::int64_t day) {
+        if (day > timeline->last_day) {
+            return static_cast<size_t>(timeline->count);
+        }
+        const std::int32_t bound = static_cast<std::int32_t>(day);
+        size_t result = 0;
+        scan(*timeline, firstBlock(*timeline, bound), [&result, bound](size_t index, std::int32_t record_day, std::uint32_t) {
+            if (record_day >= bound) {
+                result = index;
+                return false;
+            }
+            result = index + 1;
+            return true;
+            });
+        return result;
+    };
+    return rank(static_cast<std::int64_t>(to.getDayNumber()) + 1) - rank(from.getDayNumber());
+}
+
+// Get the sessions a member attended between two dates, inclusive, in date order
+std::vector<AttendanceRecord> AttendanceStore::historyBetween(int member_id, Date from, Date to) const {
+    std::vector<AttendanceRecord> result;
+    const Timeline* timeline = find(member_id);
+    if (timeline == nullptr) {
+        return result;
+    }
+    const std::int32_t first = from.getDayNumber();
+    const std::int32_t last = to.getDayNumber();
+    scan(*timeline, firstBlock(*timeline, first), [&](size_t, std::int32_t day, std::uint32_t event) {
+        if (day > last) {
+            return false;
+        }
+        if (day >= first) {
+            const EventInfo& info = event_table[event];
+            result.push_back({ Date(day), info.start_minute, info.name, info.location });
+        }
+        return true;
+        });
+    return result;
+}
+
+// Get a member's longest run of attended days where consecutive days are at most
+// max_gap_days apart (1 for back-to-back days, 7 for a weekly habit)
+// Throws an exception if the gap is not positive
+AttendanceStreak AttendanceStore::longestStreak(int member_id, int max_gap_days) const {
+    if (max_gap_days <= 0) {
+        throw std::invalid_argument("Streak gap must be positive");
+    }
+    AttendanceStreak best = { 0, Date(), Date() };
+    const Timeline* timeline = find(member_id);
+    if (timeline == nullptr) {
+        return best;
+    }
+    AttendanceStreak current = best;
+    scan(*timeline, 0, [&](size_t, std::int32_t day, std::uint32_t) {
+        if (current.days > 0 && day == current.last.getDayNumber()) {
+            return true;  // another session on the same day
+        }
+        if (current.days > 0 && day - current.last.getDayNumber() <= max_gap_days) {
+            ++current.days;
+        }
+        else {
+            current = { 1, Date(day), Date(day) };
+        }
+        current.last = Date(day);
+        if (current.days > best.days) {
+            best = current;
+        }
+        return true;
+        });
+    return best;
+}
+
+// Get the total number of attendance records
+size_t AttendanceStore::recordCount() const {
+    return record_count;
+}
+
+// Get the number of members with at least one record
+size_t AttendanceStore::memberCount() const {
+    return timelines.size();
+}
+
+// Get the number of distinct events referenced by records
+size_t AttendanceStore::eventCount() const {
+    return event_table.size();
+}
+
+// Release spare capacity left over from appends
+void AttendanceStore::shrinkToFit() {
+    for (auto& entry : timelines) {
+        entry.second.bytes.shrink_to_fit();
+        entry.second.skips.shrink_to_fit();
+    }
+    event_table.shrink_to_fit();
+}
+
+// Get the approximate heap memory used by the store in bytes
+size_t AttendanceStore::memoryUsage() const {
+    size_t total = event_table.capacity() * sizeof(EventInfo);
+    for (const auto& info : event_table) {
+        total += info.name.capacity() + info.location.capacity();
+    }
+    total += event_index.size() * (sizeof(std::tuple<std::int32_t, int, std::string, std::string>) + 4 * sizeof(void*));
+    total += timelines.bucket_count() * sizeof(void*);
+    for (const auto& entry : timelines) {
+        total += sizeof(entry) + sizeof(void*);
+        total += entry.second.bytes.capacity() + entry.second.skips.capacity() * sizeof(Skip);
+    }
+    return total;
+}
@@ -0,0 +1,91 @@
+#ifndef ATTENDANCE_H
+#define ATTENDANCE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "Date.h"
+#include "Event.h"
+
+// One attended session as read back from the store
+struct AttendanceRecord {
+    Date date;
+    int start_minute;  // minutes after midnight the session started
+    std::string event_name;
+    std::string location;
+};
+
+// The longest run of attended days with no gap longer than allowed
+struct AttendanceStreak {
+    size_t days;  // distinct attended days in the run
+    Date first;
+    Date last;
+};
+
+// Append-optimized history of which events each member attended
+// Each member has a byte timeline of (day delta, event delta) varint pairs in date order,
+// usually 2-3 bytes per record; every BLOCK_RECORDS records a skip entry stores the decoder
+// state so range queries start near the first day asked for. Event names, times and
+// locations are kept once in a shared table, so history outlives cancelled events.
+// Appending in date order is O(1); an older date rewrites that member's timeline.
+class AttendanceStore {
+private:
+    static constexpr size_t BLOCK_RECORDS = 64;
+
+    struct EventInfo {
+        std::int32_t day;
+        int start_minute;
+        std::string name;
+        std::string location;
+    };
+
+    struct Skip {
+        std::int32_t day;      // day of the last record before the block
+        std::uint32_t event;   // event of the last record before the block
+        std::uint32_t offset;  // byte offset of the block
+    };
+
+    struct Timeline {
+        std::vector<std::uint8_t> bytes;
+        std::vector<Skip> skips;
+        std::uint32_t count = 0;
+        std::int32_t last_day = 0;
+        std::uint32_t last_event = 0;
+    };
+
+    std::vector<EventInfo> event_table;
+    std::map<std::tuple<std::int32_t, int, std::string, std::string>, std::uint32_t> event_index;  // day, start, name, location
+    std::unordered_map<int, Timeline> timelines;
+    size_t record_count;
+    std::uint32_t last_lookup;  // event table entry found by the previous lookup
+
+    std::uint32_t eventId(const Event& event);
+    bool insert(int member_id, std::uint32_t event);
+    static void append(Timeline& timeline, std::int32_t day, std::uint32_t event);
+    static size_t firstBlock(const Timeline& timeline, std::int32_t day);
+    static bool contains(const Timeline& timeline, std::int32_t day, std::uint32_t event);
+    template <typename Visit>
+    static void scan(const Timeline& timeline, size_t block, Visit&& visit);
+    const Timeline* find(int member_id) const;
+
+public:
+    AttendanceStore();
+
+    bool record(int member_id, const Event& event);
+    size_t recordEvent(const Event& event);
+
+    size_t countBetween(int member_id, Date from, Date to) const;
+    std::vector<AttendanceRecord> historyBetween(int member_id, Date from, Date to) const;
+    AttendanceStreak longestStreak(int member_id, int max_gap_days = 1) const;
+
+    size_t recordCount() const;
+    size_t memberCount() const;
+    size_t eventCount() const;
+    size_t memoryUsage() const;
+    void shrinkToFit();
+};
+
+#endif // ATTENDANCE_H
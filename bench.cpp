@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Member.h"
+#include "EntityStore.h"
+
+// Benchmark of EntityStore against the vector-and-loop member table Club used before
+// Build with the entity sources, e.g. g++ -O2 -std=c++17 bench.cpp member.cpp -o bench,
+// and run as ./bench > bench_output.txt
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+    using MemberTable = EntityStore<Member, UniqueByValue<Member>, FirstByKey<Member, IdOf>, FirstByKey<Member, NameOf>>;
+
+    // The hand-written table: linear duplicate check, find and erase
+    struct LoopTable {
+        std::vector<Member*> members;
+
+        void add(Member* member) {
+            for (const auto& existing : members) {
+                if (*existing == *member) {
+                    throw std::invalid_argument("Member with this ID already exists in the club");
+                }
+            }
+            members.push_back(member);
+        }
+
+        Member* findById(int id) const {
+            for (const auto& member : members) {
+                if (member->getId() == id) {
+                    return member;
+                }
+            }
+            return nullptr;
+        }
+
+        Member* findByName(const std::string& name) const {
+            for (const auto& member : members) {
+                if (member->getName() == name) {
+                    return member;
+                }
+            }
+            return nullptr;
+        }
+
+        void remove(Member* member) {
+            auto it = std::find(members.begin(), members.end(), member);
+            if (it != members.end()) {
+                members.erase(it);
+            }
+        }
+    };
+
+    struct StoreTable {
+        MemberTable members;
+
+        void add(Member* member) {
+            if (!members.insert(member)) {
+                throw std::invalid_argument("Member with this ID already exists in the club");
+            }
+        }
+
+        Member* findById(int id) const {
+            return members.index<FirstByKey<Member, IdOf>>().find(id);
+        }
+
+        Member* findByName(const std::string& name) const {
+            return members.index<FirstByKey<Member, NameOf>>().find(name);
+        }
+
+        void remove(Member* member) {
+            members.erase(member);
+        }
+    };
+
+    double elapsedNs(Clock::time_point start, size_t operations) {
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        return ns / static_cast<double>(operations);
+    }
+
+    // Time each operation on a table of the given size, in nanoseconds per call
+    template <typename Table>
+    void run(const char* label, const std::vector<std::unique_ptr<Member>>& people, size_t lookups) {
+        std::mt19937 rng(42);
+        Table table;
+        size_t found = 0;
+
+        auto start = Clock::now();
+        for (const auto& member : people) {
+            table.add(member.get());
+        }
+        const double add = elapsedNs(start, people.size());
+
+        start = Clock::now();
+        for (size_t i = 0; i < lookups; ++i) {
+            found += table.findById(static_cast<int>(rng() % people.size())) != nullptr;
+        }
+        const double by_id = elapsedNs(start, lookups);
+
+        start = Clock::now();
+        for (size_t i = 0; i < lookups; ++i) {
+            found += table.findByName(people[rng() % people.size()]->getName()) != nullptr;
+        }
+        const double by_name = elapsedNs(start, lookups);
+
+        std::vector<Member*> order;
+        for (const auto& member : people) {
+            order.push_back(member.get());
+        }
+        std::shuffle(order.begin(), order.end(), rng);
+        start = Clock::now();
+        for (auto member : order) {
+            table.remove(member);
+        }
+        const double remove = elapsedNs(start, order.size());
+
+        std::printf("%-8s %9zu %12.1f %12.1f %12.1f %12.1f %6zu\n", label, people.size(), add, by_id, by_name, remove,
+                    found);
+    }
+}
+
+int main() {
+    std::printf("%-8s %9s %12s %12s %12s %12s %6s\n", "table", "members", "add ns", "by id ns", "by name ns",
+                "remove ns", "found");
+    for (size_t count : { 1000, 10000, 50000 }) {
+        std::vector<std::unique_ptr<Member>> people;
+        for (size_t i = 0; i < count; ++i) {
+            people.emplace_back(new Member("Member " + std::to_string(i), 18 + static_cast<int>(i % 40), "Athlete",
+                                           static_cast<int>(i)));
+        }
+        const size_t lookups = 200000000 / (count * 10);
+        run<LoopTable>("loops", people, lookups);
+        run<StoreTable>("store", people, lookups);
+    }
+    return 0;
+}
@@ -0,0 +1,548 @@
+#include "BTree.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    const std::uint8_t LEAF_PAGE = 1;
+    const std::uint8_t INNER_PAGE = 2;
+    const size_t NODE_HEADER = 8;   // u8 type, u8 unused, u16 count, u32 link
+    const size_t SLOT_BYTES = 2;    // u16 offset of each entry's cell, in key order
+    const PageId NO_PAGE = 0xFFFFFFFF;
+
+    std::system_error systemError(const char* what) {
+        return std::system_error(errno, std::generic_category(), what);
+    }
+
+    // Pages are little-endian like the wire protocol, so files move between machines
+    std::uint16_t get16(const char* at) {
+        return static_cast<std::uint16_t>(static_cast<std::uint8_t>(at[0]) | (static_cast<std::uint8_t>(at[1]) << 8));
+    }
+
+    std::uint32_t get32(const char* at) {
+        return static_cast<std::uint32_t>(get16(at)) | (static_cast<std::uint32_t>(get16(at + 2)) << 16);
+    }
+
+    void put16(char* at, size_t value) {
+        at[0] = static_cast<char>(value);
+        at[1] = static_cast<char>(value >> 8);
+    }
+
+    void put32(char* at, std::uint32_t value) {
+        put16(at, value & 0xFFFF);
+        put16(at + 2, value >> 16);
+    }
+
+    // Read access to the entries of a page without decoding it
+    struct PageView {
+        const char* page;
+
+        bool leaf() const { return static_cast<std::uint8_t>(page[0]) == LEAF_PAGE; }
+        size_t count() const { return get16(page + 2); }
+        PageId link() const { return get32(page + 4); }
+        const char* cell(size_t i) const { return page + get16(page + NODE_HEADER + SLOT_BYTES * i); }
+
+        std::string_view key(size_t i) const {
+            const char* at = cell(i);
+            return { at + (leaf() ? 4 : 6), get16(at) };
+        }
+
+        std::string_view value(size_t i) const {
+            const char* at = cell(i);
+            return { at + 4 + get16(at), get16(at + 2) };
+        }
+
+        PageId child(size_t i) const { return get32(cell(i) + 2); }
+
+        // Index of the first entry whose key is not below the given key
+        size_t lowerBound(std::string_view target) const {
+            size_t low = 0;
+            size_t high = count();
+            while (low < high) {
+                const size_t middle = (low + high) / 2;
+                if (key(middle) < target) {
+                    low = middle + 1;
+                }
+                else {
+                    high = middle;
+                }
+            }
+            return low;
+        }
+
+        // Subtree of an inner page that holds the given key
+        PageId childFor(std::string_view target) const {
+            size_t low = 0;
+            size_t high = count();
+            while (low < high) {
+                const size_t middle = (low + high) / 2;
+                if (key(middle) <= target) {
+                    low = middle + 1;
+                }
+                else {
+                    high = middle;
+                }
+            }
+            return low == 0 ? link() : child(low - 1);
+        }
+    };
+}
+
+// Open a page file, creating it empty if it does not exist
+// Throws an exception if the file cannot be opened or its size is not a whole number of pages
+PageFile::PageFile(const std::string& path) : fd(-1), page_count(0) {
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        throw systemError("open");
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        const std::system_error error = systemError("fstat");
+        ::close(fd);
+        throw error;
+    }
+    if (info.st_size % PAGE_SIZE != 0) {
+        ::close(fd);
+        throw std::invalid_argument("File is not a page file: " + path);
+    }
+    page_count = static_cast<PageId>(info.st_size / PAGE_SIZE);
+}
+
+PageFile::~PageFile() {
+    ::close(fd);
+}
+
+// Read a whole page; pages allocated but never written read as zeros
+// Throws an exception if the page was never allocated or the read fails
+void PageFile::read(PageId id, char* page) const {
+    if (id >= page_count) {
+        throw std::invalid_argument("Page is beyond the end of the file");
+    }
+    size_t done = 0;
+    while (done < PAGE_SIZE) {
+        const ssize_t got = ::pread(fd, page + done, PAGE_SIZE - done, static_cast<off_t>(id) * PAGE_SIZE + done);
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw systemError("pread");
+        }
+        if (got == 0) {
+            std::memset(page + done, 0, PAGE_SIZE - done);
+            break;
+        }
+        done += static_cast<size_t>(got);
+    }
+}
+
+// Write a whole page
+// Throws an exception if the page was never allocated or the write fails
+void PageFile::write(PageId id, const char* page) {
+    if (id >= page_count) {
+        throw std::invalid_argument("Page is beyond the end of the file");
+    }
+    size_t done = 0;
+    while (done < PAGE_SIZE) {
+        const ssize_t put = ::pwrite(fd, page + done, PAGE_SIZE - done, static_cast<off_t>(id) * PAGE_SIZE + done);
+        if (put < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw systemError("pwrite");
+        }
+        done += static_cast<size_t>(put);
+    }
+}
+
+// Add a page at the end of the file; the file grows when the page is first written
+PageId PageFile::allocate() {
+    return page_count++;
+}
+
+PageId PageFile::pageCount() const {
+    return page_count;
+}
+
+// Make everything written so far durable
+// Throws an exception if the sync fails
+void PageFile::sync() {
+    if (::fdatasync(fd) != 0) {
+        throw systemError("fdatasync");
+    }
+}
+
+// Ask the kernel to forget its cached copy of the file, so the next reads go to disk
+// Only pages already synced can be dropped; this is a hint for cold-start measurements
+void PageFile::dropOsCache() {
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+}
+
+// Constructor
+// Throws an exception if the pool cannot hold the pages one tree change pins at once
+BufferPool::BufferPool(PageFile& file, size_t capacity_pages)
+    : file(file), capacity(capacity_pages), stats{ 0, 0, 0, 0, 0, capacity_pages } {
+    if (capacity < 8) {
+        throw std::invalid_argument("Buffer pool needs at least 8 pages");
+    }
+    frames.reserve(capacity);
+}
+
+// Destructor; writes back dirty pages
+// Errors cannot be reported from here, so call flush() first to see them
+BufferPool::~BufferPool() {
+    try {
+        flush();
+    }
+    catch (...) {
+    }
+}
+
+// Give a page a pinned frame, evicting the least recently used unpinned page when full
+// Throws an exception if every frame is pinned
+size_t BufferPool::claimFrame(PageId id) {
+    size_t index;
+    if (frames.size() < capacity) {
+        index = frames.size();
+        frames.push_back({ id, std::unique_ptr<char[]>(new char[PAGE_SIZE]), 0, false, {} });
+    }
+    else {
+        if (unpinned.empty()) {
+            throw std::runtime_error("Every buffer pool page is pinned");
+        }
+        index = unpinned.front();
+        Frame& frame = frames[index];
+        if (frame.dirty) {
+            writeBack(frame);
+        }
+        unpinned.pop_front();
+        frame_of.erase(frame.id);
+        frame.id = id;
+        ++stats.evictions;
+    }
+    frames[index].pins = 1;
+    frame_of[id] = index;
+    return index;
+}
+
+void BufferPool::pin(size_t frame) {
+    if (frames[frame].pins++ == 0) {
+        unpinned.erase(frames[frame].unpinned_at);
+    }
+}
+
+void BufferPool::unpin(size_t frame) {
+    if (--frames[frame].pins == 0) {
+        frames[frame].unpinned_at = unpinned.insert(unpinned.end(), frame);
+    }
+}
+
+void BufferPool::writeBack(Frame& frame) {
+    file.write(frame.id, frame.data.get());
+    frame.dirty = false;
+    ++stats.writes;
+}
+
+// Get a page, reading it from the file unless it is cached
+// Throws an exception if the page cannot be read or every frame is pinned
+BufferPool::PageRef BufferPool::fetch(PageId id) {
+    auto it = frame_of.find(id);
+    if (it != frame_of.end()) {
+        ++stats.hits;
+        pin(it->second);
+        return PageRef(this, it->second);
+    }
+    ++stats.misses;
+    const size_t index = claimFrame(id);
+    try {
+        file.read(id, frames[index].data.get());
+    }
+    catch (...) {
+        // Hand the frame back empty, first in line for reuse
+        frame_of.erase(id);
+        frames[index].id = NO_PAGE;
+        frames[index].pins = 0;
+        frames[index].unpinned_at = unpinned.insert(unpinned.begin(), index);
+        throw;
+    }
+    return PageRef(this, index);
+}
+
+// Add a zeroed page to the file and get it pinned
+// Throws an exception if every frame is pinned
+BufferPool::PageRef BufferPool::create() {
+    const size_t index = claimFrame(file.allocate());
+    std::memset(frames[index].data.get(), 0, PAGE_SIZE);
+    frames[index].dirty = true;
+    return PageRef(this, index);
+}
+
+// Write back every dirty page and sync the file
+// Throws an exception if a write or the sync fails
+void BufferPool::flush() {
+    for (auto& frame : frames) {
+        if (frame.dirty) {
+            writeBack(frame);
+        }
+    }
+    file.sync();
+}
+
+// Flush, then drop every cached page and free the frames
+// Throws an exception if a page is still pinned
+void BufferPool::evictAll() {
+    for (const auto& frame : frames) {
+        if (frame.pins != 0) {
+            throw std::runtime_error("Cannot evict pinned pages");
+        }
+    }
+    flush();
+    stats.evictions += frame_of.size();
+    frames.clear();
+    frames.shrink_to_fit();
+    frame_of.clear();
+    unpinned.clear();
+}
+
+// Get the hit and miss counts and the number of cached pages
+BufferStats BufferPool::getStats() const {
+    BufferStats result = stats;
+    result.cached_pages = frame_of.size();
+    return result;
+}
+
+// Get the approximate heap memory used by the cached pages and their bookkeeping in bytes
+size_t BufferPool::memoryUsage() const {
+    return frames.capacity() * sizeof(Frame) + frames.size() * PAGE_SIZE + frame_of.bucket_count() * sizeof(void*) +
+           frame_of.size() * (sizeof(std::pair<PageId, size_t>) + sizeof(void*)) +
+           unpinned.size() * (sizeof(size_t) + 2 * sizeof(void*));
+}
+
+// Open the tree rooted at a page, or start a new empty tree if root is 0
+// Page 0 is never a tree page, so owners can keep a header there
+BPlusTree::BPlusTree(BufferPool& pool, PageId root) : pool(pool), root(root) {
+    if (root == 0) {
+        BufferPool::PageRef page = pool.create();
+        encode({ true, 0, {} }, page.mutableData());
+        this->root = page.id();
+    }
+}
+
+// Get the root page, which moves when the root splits
+PageId BPlusTree::getRoot() const {
+    return root;
+}
+
+BPlusTree::Node BPlusTree::decode(const char* page) {
+    const PageView view{ page };
+    Node node{ view.leaf(), view.link(), {} };
+    node.entries.reserve(view.count());
+    for (size_t i = 0; i < view.count(); ++i) {
+        if (node.leaf) {
+            node.entries.push_back({ std::string(view.key(i)), std::string(view.value(i)), 0 });
+        }
+        else {
+            node.entries.push_back({ std::string(view.key(i)), {}, view.child(i) });
+        }
+    }
+    return node;
+}
+
+size_t BPlusTree::encodedSize(const Node& node) {
+    size_t size = NODE_HEADER;
+    for (const auto& entry : node.entries) {
+        size += SLOT_BYTES + entry.key.size() + (node.leaf ? 4 + entry.value.size() : 6);
+    }
+    return size;
+}
+
+// Write a node that fits a page: slots after the header, cells packed from the end
+void BPlusTree::encode(const Node& node, char* page) {
+    page[0] = static_cast<char>(node.leaf ? LEAF_PAGE : INNER_PAGE);
+    page[1] = 0;
+    put16(page + 2, node.entries.size());
+    put32(page + 4, node.link);
+    size_t end = PAGE_SIZE;
+    for (size_t i = 0; i < node.entries.size(); ++i) {
+        const Entry& entry = node.entries[i];
+        if (node.leaf) {
+            end -= 4 + entry.key.size() + entry.value.size();
+            put16(page + end, entry.key.size());
+            put16(page + end + 2, entry.value.size());
+            std::memcpy(page + end + 4, entry.key.data(), entry.key.size());
+            std::memcpy(page + end + 4 + entry.key.size(), entry.value.data(), entry.value.size());
+        }
+        else {
+            end -= 6 + entry.key.size();
+            put16(page + end, entry.key.size());
+            put32(page + end + 2, entry.child);
+            std::memcpy(page + end + 6, entry.key.data(), entry.key.size());
+        }
+        put16(page + NODE_HEADER + SLOT_BYTES * i, end);
+    }
+}
+
+// Find the leaf that holds a key, recording the inner pages passed on the way if asked
+PageId BPlusTree::descend(std::string_view key, std::vector<PageId>* path) const {
+    PageId id = root;
+    while (true) {
+        BufferPool::PageRef page = pool.fetch(id);
+        const PageView view{ page.data() };
+        if (view.leaf()) {
+            return id;
+        }
+        if (path != nullptr) {
+            path->push_back(id);
+        }
+        id = view.childFor(key);
+    }
+}
+
+// Write a changed node back to its page, splitting it in two if it no longer fits
+// path holds the inner pages above the node, the parent last
+void BPlusTree::store(BufferPool::PageRef& page, Node& node, std::vector<PageId>& path) {
+    const size_t size = encodedSize(node);
+    if (size <= PAGE_SIZE) {
+        encode(node, page.mutableData());
+        return;
+    }
+
+    // Split near the middle by bytes; an inner split moves its middle key up
+    const size_t count = node.entries.size();
+    size_t left = 0;
+    size_t bytes = NODE_HEADER;
+    while (left < count && bytes < size / 2) {
+        bytes += SLOT_BYTES + node.entries[left].key.size() +
+                 (node.leaf ? 4 + node.entries[left].value.size() : 6);
+        ++left;
+    }
+    left = std::max<size_t>(1, std::min(left, node.leaf ? count - 1 : count - 2));
+    if (node.leaf && node.link == 0) {
+        // The last leaf gives up only its last entry when the rest still fits, so a tree
+        // filled in key order ends up with full pages rather than half-full ones
+        const Entry& last = node.entries.back();
+        if (size - (SLOT_BYTES + last.key.size() + 4 + last.value.size()) <= PAGE_SIZE) {
+            left = count - 1;
+        }
+    }
+
+    BufferPool::PageRef right_page = pool.create();
+    Node right{ node.leaf, 0, {} };
+    std::string separator;
+    if (node.leaf) {
+        right.link = node.link;
+        right.entries.assign(std::make_move_iterator(node.entries.begin() + left),
+                             std::make_move_iterator(node.entries.end()));
+        separator = right.entries.front().key;
+        node.link = right_page.id();
+    }
+    else {
+        separator = std::move(node.entries[left].key);
+        right.link = node.entries[left].child;
+        right.entries.assign(std::make_move_iterator(node.entries.begin() + left + 1),
+                             std::make_move_iterator(node.entries.end()));
+    }
+    node.entries.resize(left);
+    encode(right, right_page.mutableData());
+    encode(node, page.mutableData());
+
+    const PageId right_id = right_page.id();
+    right_page.release();
+    page.release();
+    insertSeparator(path, std::move(separator), right_id);
+}
+
+// Add the separator of a split to the parent, growing a new root above a split root
+void BPlusTree::insertSeparator(std::vector<PageId>& path, std::string key, PageId child) {
+    if (path.empty()) {
+        BufferPool::PageRef page = pool.create();
+        encode({ false, root, { { std::move(key), {}, child } } }, page.mutableData());
+        root = page.id();
+        return;
+    }
+    BufferPool::PageRef page = pool.fetch(path.back());
+    path.pop_back();
+    Node node = decode(page.data());
+    auto position = std::upper_bound(node.entries.begin(), node.entries.end(), key,
+                                     [](const std::string& target, const Entry& entry) { return target < entry.key; });
+    node.entries.insert(position, { std::move(key), {}, child });
+    store(page, node, path);
+}
+
+// Look up a key, copying its value out
+// Returns false if the key is not in the tree
+bool BPlusTree::find(std::string_view key, std::string& value) const {
+    BufferPool::PageRef page = pool.fetch(descend(key, nullptr));
+    const PageView view{ page.data() };
+    const size_t i = view.lowerBound(key);
+    if (i == view.count() || view.key(i) != key) {
+        return false;
+    }
+    value.assign(view.value(i));
+    return true;
+}
+
+// Add a key or replace its value
+// Returns true if the key is new; replacing a value with an equal one writes nothing
+// Throws an exception if the key and value together exceed MAX_ENTRY_BYTES
+bool BPlusTree::insert(std::string_view key, std::string_view value) {
+    if (key.size() + value.size() > MAX_ENTRY_BYTES) {
+        throw std::invalid_argument("Entry is too large for a tree page");
+    }
+    std::vector<PageId> path;
+    BufferPool::PageRef page = pool.fetch(descend(key, &path));
+    const PageView view{ page.data() };
+    const size_t i = view.lowerBound(key);
+    const bool exists = i < view.count() && view.key(i) == key;
+    if (exists && view.value(i) == value) {
+        return false;
+    }
+    Node node = decode(page.data());
+    if (exists) {
+        node.entries[i].value.assign(value);
+    }
+    else {
+        node.entries.insert(node.entries.begin() + i, { std::string(key), std::string(value), 0 });
+    }
+    store(page, node, path);
+    return !exists;
+}
+
+// Remove a key
+// Returns false if the key was not in the tree
+bool BPlusTree::erase(std::string_view key) {
+    BufferPool::PageRef page = pool.fetch(descend(key, nullptr));
+    const size_t i = PageView{ page.data() }.lowerBound(key);
+    Node node = decode(page.data());
+    if (i == node.entries.size() || node.entries[i].key != key) {
+        return false;
+    }
+    node.entries.erase(node.entries.begin() + i);
+    encode(node, page.mutableData());
+    return true;
+}
+
+// Visit the pairs with keys from the given one on, in key order, until the visitor
+// returns false; the visitor must not change the tree
+void BPlusTree::forEachFrom(std::string_view from, const Visitor& visit) const {
+    BufferPool::PageRef page = pool.fetch(descend(from, nullptr));
+    size_t i = PageView{ page.data() }.lowerBound(from);
+    while (true) {
+        const PageView view{ page.data() };
+        for (; i < view.count(); ++i) {
+            if (!visit(view.key(i), view.value(i))) {
+                return;
+            }
+        }
+        const PageId next = view.link();
+        if (next == 0) {
+            return;
+        }
+        page = pool.fetch(next);
+        i = 0;
+    }
+}
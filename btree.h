@@ -0,0 +1,178 @@
+#ifndef BTREE_H
+#define BTREE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Page-oriented storage for data sets larger than memory
+// A PageFile reads and writes fixed-size pages of one file, a BufferPool keeps the
+// recently used pages of it in memory, and a BPlusTree stores sorted key/value pairs in
+// those pages. Nothing here locks; a file is meant for one thread.
+
+const size_t PAGE_SIZE = 4096;
+using PageId = std::uint32_t;
+
+// A file of PAGE_SIZE pages, read and written whole at page offsets
+class PageFile {
+private:
+    int fd;
+    PageId page_count;
+
+public:
+    explicit PageFile(const std::string& path);
+    ~PageFile();
+
+    PageFile(const PageFile&) = delete;
+    PageFile& operator=(const PageFile&) = delete;
+
+    void read(PageId id, char* page) const;
+    void write(PageId id, const char* page);
+    PageId allocate();
+    PageId pageCount() const;
+    void sync();
+    void dropOsCache();
+};
+
+// Hit rate and size of a buffer pool
+struct BufferStats {
+    std::uint64_t hits;       // fetches served from memory
+    std::uint64_t misses;     // fetches that read the page from the file
+    std::uint64_t evictions;  // pages dropped to make room
+    std::uint64_t writes;     // dirty pages written back
+    size_t cached_pages;
+    size_t capacity_pages;
+};
+
+// Fixed number of page frames over a PageFile, replaced least recently used first
+// A fetched page stays pinned in its frame while a PageRef to it is alive; only
+// unpinned pages are evicted, and dirty ones are written back first.
+class BufferPool {
+private:
+    struct Frame {
+        PageId id;
+        std::unique_ptr<char[]> data;
+        unsigned pins;
+        bool dirty;
+        std::list<size_t>::iterator unpinned_at;  // position in unpinned, valid while pins == 0
+    };
+
+    PageFile& file;
+    size_t capacity;
+    std::vector<Frame> frames;
+    std::unordered_map<PageId, size_t> frame_of;
+    std::list<size_t> unpinned;  // frames nobody holds, least recently used first
+    BufferStats stats;
+
+    size_t claimFrame(PageId id);
+    void pin(size_t frame);
+    void unpin(size_t frame);
+    void writeBack(Frame& frame);
+
+public:
+    // A pinned page; the page stays in memory until the reference goes away
+    class PageRef {
+    private:
+        BufferPool* pool;
+        size_t frame;
+
+    public:
+        PageRef(BufferPool* pool, size_t frame) : pool(pool), frame(frame) {}
+        PageRef(PageRef&& other) noexcept : pool(other.pool), frame(other.frame) { other.pool = nullptr; }
+        PageRef& operator=(PageRef&& other) noexcept {
+            if (this != &other) {
+                release();
+                pool = other.pool;
+                frame = other.frame;
+                other.pool = nullptr;
+            }
+            return *this;
+        }
+        PageRef(const PageRef&) = delete;
+        PageRef& operator=(const PageRef&) = delete;
+        ~PageRef() { release(); }
+
+        void release() {
+            if (pool != nullptr) {
+                pool->unpin(frame);
+                pool = nullptr;
+            }
+        }
+
+        const char* data() const { return pool->frames[frame].data.get(); }
+        PageId id() const { return pool->frames[frame].id; }
+
+        // Get the page for writing; it is written back before its frame is reused
+        char* mutableData() {
+            pool->frames[frame].dirty = true;
+            return pool->frames[frame].data.get();
+        }
+    };
+
+    BufferPool(PageFile& file, size_t capacity_pages);
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    PageRef fetch(PageId id);
+    PageRef create();
+    void flush();
+    void evictAll();
+    BufferStats getStats() const;
+    size_t memoryUsage() const;
+};
+
+// B+tree of byte-string keys and values in the pages of a buffer pool
+// Leaves hold the pairs in key order and are chained left to right for scans; inner
+// pages hold separator keys. Pages split when full but are not merged when entries are
+// erased, so space freed by erasing is reused by later inserts into the same range.
+// Lookups binary-search the page bytes in place; changes re-encode the touched pages.
+class BPlusTree {
+public:
+    // Largest key plus value a single entry may hold, so every page fits at least three
+    static const size_t MAX_ENTRY_BYTES = 1000;
+
+    // Called with each visited pair in key order; returning false stops the visit
+    using Visitor = std::function<bool(std::string_view key, std::string_view value)>;
+
+private:
+    BufferPool& pool;
+    PageId root;
+
+    struct Entry {
+        std::string key;
+        std::string value;  // leaves only
+        PageId child;       // inner pages only, the subtree of keys >= key
+    };
+
+    struct Node {
+        bool leaf;
+        PageId link;  // next leaf, or the subtree of keys below the first key of an inner page
+        std::vector<Entry> entries;
+    };
+
+    static Node decode(const char* page);
+    static size_t encodedSize(const Node& node);
+    static void encode(const Node& node, char* page);
+    PageId descend(std::string_view key, std::vector<PageId>* path) const;
+    void insertSeparator(std::vector<PageId>& path, std::string key, PageId child);
+    void store(BufferPool::PageRef& page, Node& node, std::vector<PageId>& path);
+
+public:
+    BPlusTree(BufferPool& pool, PageId root);
+
+    PageId getRoot() const;
+    bool find(std::string_view key, std::string& value) const;
+    bool insert(std::string_view key, std::string_view value);
+    bool erase(std::string_view key);
+    void forEachFrom(std::string_view from, const Visitor& visit) const;
+};
+
+#endif // BTREE_H
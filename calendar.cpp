@@ -0,0 +1,129 @@
+#include "Calendar.h"
+#include <algorithm>
+
+namespace {
+    const long long MINUTES_PER_DAY = 24 * 60;
+
+    // First minute of the day containing the given stamp
+    long long dayStart(long long stamp) {
+        long long day = stamp / MINUTES_PER_DAY;
+        if (stamp < 0 && stamp % MINUTES_PER_DAY != 0) {
+            --day;
+        }
+        return day * MINUTES_PER_DAY;
+    }
+}
+
+// Add an event to the index under its location and start time
+// Adding an event already in the index has no effect
+void VenueCalendar::addEvent(Event* event) {
+    if (event == nullptr) {
+        throw std::invalid_argument("Event cannot be null");
+    }
+    if (placements.count(event) != 0) {
+        return;
+    }
+    const long long start = event->getStartStamp();
+    auto venue = venues.try_emplace(event->getLocation()).first;
+    const Placement placement{ &venue->first, venue->second.emplace(start, event), dayStart(start) / MINUTES_PER_DAY };
+    ++events_per_day[placement.day];
+    placements.emplace(event, placement);
+}
+
+// Remove an event from the index, from wherever it was filed when it was added
+void VenueCalendar::removeEvent(Event* event) {
+    auto placed = placements.find(event);
+    if (placed == placements.end()) {
+        return;
+    }
+    const Placement& placement = placed->second;
+    auto venue = venues.find(*placement.location);
+    venue->second.erase(placement.at);
+    if (venue->second.empty()) {
+        venues.erase(venue);
+    }
+    auto day = events_per_day.find(placement.day);
+    if (day != events_per_day.end() && --day->second == 0) {
+        events_per_day.erase(day);
+    }
+    placements.erase(placed);
+}
+
+// Check whether any event is scheduled on the given day at any venue
+bool VenueCalendar::hasEventsOn(long long day_number) const {
+    return events_per_day.count(day_number) != 0;
+}
+
+// Check whether [start, end) overlaps any event at the location
+bool VenueCalendar::hasConflict(const std::string& location, long long start, long long end, const Event* ignore) const {
+    auto venue = venues.find(location);
+    if (venue == venues.end()) {
+        return false;
+    }
+    const auto& by_start = venue->second;
+    for (auto it = by_start.lower_bound(dayStart(start)); it != by_start.end() && it->first < end; ++it) {
+        if (it->second != ignore && it->second->getEndStamp() > start) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Find all events at the location that overlap [start, end)
+std::vector<Event*> VenueCalendar::findOverlapping(const std::string& location, long long start, long long end) const {
+    std::vector<Event*> result;
+    auto venue = venues.find(location);
+    if (venue == venues.end()) {
+        return result;
+    }
+    const auto& by_start = venue->second;
+    for (auto it = by_start.lower_bound(dayStart(start)); it != by_start.end() && it->first < end; ++it) {
+        if (it->second->getEndStamp() > start) {
+            result.push_back(it->second);
+        }
+    }
+    return result;
+}
+
+// Find the gaps of at least min_length minutes between events at the location within [from, to)
+std::vector<TimeSlot> VenueCalendar::findFreeSlots(const std::string& location, long long from, long long to, long long min_length) const {
+    std::vector<TimeSlot> result;
+    long long cursor = from;
+    auto venue = venues.find(location);
+    if (venue != venues.end()) {
+        const auto& by_start = venue->second;
+        for (auto it = by_start.lower_bound(dayStart(from)); it != by_start.end() && it->first < to; ++it) {
+            const long long busy_start = std::max(it->first, from);
+            const long long busy_end = it->second->getEndStamp();
+            if (busy_start - cursor >= min_length) {
+                result.push_back({ cursor, busy_start });
+            }
+            cursor = std::max(cursor, busy_end);
+        }
+    }
+    if (to - cursor >= min_length) {
+        result.push_back({ cursor, to });
+    }
+    return result;
+}
+
+// Get the number of indexed events
+size_t VenueCalendar::size() const {
+    size_t total = 0;
+    for (const auto& venue : venues) {
+        total += venue.second.size();
+    }
+    return total;
+}
+
+// Get the approximate heap memory used by the calendar in bytes
+size_t VenueCalendar::memoryUsage() const {
+    size_t total = venues.bucket_count() * sizeof(void*);
+    for (const auto& venue : venues) {
+        total += sizeof(venue) + 2 * sizeof(void*) + (venue.first.capacity() > 15 ? venue.first.capacity() + 1 : 0);
+        total += venue.second.size() * (sizeof(std::pair<const long long, Event*>) + 4 * sizeof(void*));
+    }
+    total += placements.bucket_count() * sizeof(void*) +
+             placements.size() * (sizeof(std::pair<const Event* const, Placement>) + sizeof(void*));
+    return total + events_per_day.size() * (sizeof(std::pair<const long long, size_t>) + 4 * sizeof(void*));
+}
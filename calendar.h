@@ -0,0 +1,49 @@
+#ifndef CALENDAR_H
+#define CALENDAR_H
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Event.h"
+
+// A free interval at a venue, in minutes since 1970-01-01 00:00
+struct TimeSlot {
+    long long start;
+    long long end;
+};
+
+// Per-location index of event time ranges
+// Events never cross midnight, so every event overlapping a range starts on or after
+// the first day of that range; lookups are a map seek plus a scan of that window.
+// Each event remembers where it was filed, so removal works whatever the event's
+// details are by then.
+class VenueCalendar {
+private:
+    using Venue = std::multimap<long long, Event*>;
+
+    // Where an event was filed when it was added
+    struct Placement {
+        const std::string* location;  // key of its venue, stable while the venue exists
+        Venue::iterator at;
+        long long day;
+    };
+
+    std::unordered_map<std::string, Venue> venues;
+    std::map<long long, size_t> events_per_day;
+    std::unordered_map<const Event*, Placement> placements;
+
+public:
+    void addEvent(Event* event);
+    void removeEvent(Event* event);
+
+    bool hasEventsOn(long long day_number) const;
+    bool hasConflict(const std::string& location, long long start, long long end, const Event* ignore = nullptr) const;
+    std::vector<Event*> findOverlapping(const std::string& location, long long start, long long end) const;
+    std::vector<TimeSlot> findFreeSlots(const std::string& location, long long from, long long to, long long min_length = 1) const;
+
+    size_t size() const;
+    size_t memoryUsage() const;
+};
+
+#endif // CALENDAR_H
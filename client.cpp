@@ -0,0 +1,238 @@
+#include "Client.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    const size_t READ_CHUNK = 64 * 1024;
+
+    std::system_error systemError(const char* what) {
+        return std::system_error(errno, std::generic_category(), what);
+    }
+
+    WireReader readerOf(const ClubResponse& response) {
+        if (!response.ok()) {
+            throw std::invalid_argument("Response is not a success");
+        }
+        return WireReader(response.body.data(), response.body.size());
+    }
+}
+
+// Decode a member response
+// Throws an exception if the response is not a member
+MemberRecord ClubResponse::member() const {
+    WireReader in = readerOf(*this);
+    return in.member();
+}
+
+// Decode a member search response
+// Throws an exception if the response is not a member list
+std::vector<MemberRecord> ClubResponse::members() const {
+    WireReader in = readerOf(*this);
+    std::vector<MemberRecord> result(in.u16());
+    for (auto& record : result) {
+        record = in.member();
+    }
+    return result;
+}
+
+// Decode an event search response
+// Throws an exception if the response is not a name list
+std::vector<std::string> ClubResponse::names() const {
+    WireReader in = readerOf(*this);
+    std::vector<std::string> result(in.u16());
+    for (auto& name : result) {
+        name = in.str();
+    }
+    return result;
+}
+
+// Decode a yes/no response
+// Throws an exception if the response is not a flag
+bool ClubResponse::flag() const {
+    WireReader in = readerOf(*this);
+    return in.u8() != 0;
+}
+
+// Decode a count response
+// Throws an exception if the response is not a count
+std::uint32_t ClubResponse::count() const {
+    WireReader in = readerOf(*this);
+    return in.u32();
+}
+
+// Get the message of an error response, or an empty string for other responses
+std::string ClubResponse::error() const {
+    if (status != ClubStatus::Error) {
+        return "";
+    }
+    WireReader in(body.data(), body.size());
+    return in.str();
+}
+
+// Constructor; connects to the server's socket
+// Throws an exception if the path is too long or nothing listens there
+ClubClient::ClubClient(const std::string& socket_path) : fd(-1), consumed(0), in_flight(0) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Socket path is empty or too long");
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.size() + 1);
+    fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw systemError("socket");
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        const auto error = systemError("connect");
+        ::close(fd);
+        throw error;
+    }
+}
+
+// Destructor; closes the connection, dropping unsent requests
+ClubClient::~ClubClient() {
+    ::close(fd);
+}
+
+// Queue one request frame
+template <typename Body>
+void ClubClient::request(ClubRequest kind, Body&& body) {
+    const size_t frame = queued.beginFrame(static_cast<std::uint8_t>(kind));
+    try {
+        body(queued);
+    }
+    catch (...) {
+        queued.truncate(frame);
+        throw;
+    }
+    queued.endFrame(frame);
+    ++in_flight;
+}
+
+void ClubClient::ping() {
+    request(ClubRequest::Ping, [](WireWriter&) {});
+}
+
+void ClubClient::findMemberById(int id) {
+    request(ClubRequest::FindMemberById, [id](WireWriter& out) { out.i32(id); });
+}
+
+void ClubClient::findMemberByName(const std::string& name) {
+    request(ClubRequest::FindMemberByName, [&name](WireWriter& out) { out.str(name); });
+}
+
+// Queue a fuzzy member search; limits beyond 65535 are capped
+void ClubClient::searchMembers(const std::string& query, int max_distance, size_t limit) {
+    request(ClubRequest::SearchMembers, [&](WireWriter& out) {
+        out.str(query);
+        out.u8(static_cast<std::uint8_t>(std::max(0, std::min(max_distance, 255))));
+        out.u16(static_cast<std::uint16_t>(std::min<size_t>(limit, 0xFFFF)));
+        });
+}
+
+void ClubClient::addMember(const std::string& name, int age, const std::string& role, int id) {
+    request(ClubRequest::AddMember, [&](WireWriter& out) {
+        out.str(name);
+        out.i32(age);
+        out.str(role);
+        out.i32(id);
+        });
+}
+
+void ClubClient::removeMember(int id) {
+    request(ClubRequest::RemoveMember, [id](WireWriter& out) { out.i32(id); });
+}
+
+void ClubClient::signUp(const std::string& event_name, int member_id) {
+    request(ClubRequest::SignUp, [&](WireWriter& out) {
+        out.str(event_name);
+        out.i32(member_id);
+        });
+}
+
+void ClubClient::hasScheduleConflict(const std::string& location, const std::string& date,
+                                     const std::string& start_time, const std::string& end_time) {
+    request(ClubRequest::ScheduleConflict, [&](WireWriter& out) {
+        out.str(location);
+        out.str(date);
+        out.str(start_time);
+        out.str(end_time);
+        });
+}
+
+void ClubClient::getParticipantCount(const std::string& event_name) {
+    request(ClubRequest::ParticipantCount, [&event_name](WireWriter& out) { out.str(event_name); });
+}
+
+// Queue a full-text event search; limits beyond 65535 are capped
+void ClubClient::searchEvents(const std::string& query, size_t limit) {
+    request(ClubRequest::SearchEvents, [&](WireWriter& out) {
+        out.str(query);
+        out.u16(static_cast<std::uint16_t>(std::min<size_t>(limit, 0xFFFF)));
+        });
+}
+
+// Send every queued request
+// Throws an exception if the connection fails
+void ClubClient::flush() {
+    const std::string& bytes = queued.bytes();
+    size_t sent = 0;
+    while (sent < bytes.size()) {
+        const ssize_t put = ::send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+        if (put < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw systemError("send");
+        }
+        sent += static_cast<size_t>(put);
+    }
+    queued.truncate(0);
+}
+
+// Wait for the response to the oldest request still in flight
+// Queued requests are flushed first, so a receive never waits on an unsent request
+// Throws an exception if nothing is in flight, the connection fails or a frame is malformed
+ClubResponse ClubClient::receive() {
+    if (in_flight == 0) {
+        throw std::invalid_argument("No request is waiting for a response");
+    }
+    if (queued.size() != 0) {
+        flush();
+    }
+    while (true) {
+        const size_t length = frameLength(input.data() + consumed, input.size() - consumed);
+        if (length != 0 && input.size() - consumed >= length) {
+            ClubResponse response{ static_cast<ClubStatus>(static_cast<std::uint8_t>(input[consumed + 4])),
+                                   input.substr(consumed + 5, length - 5) };
+            consumed += length;
+            --in_flight;
+            return response;
+        }
+        if (consumed != 0) {
+            input.erase(0, consumed);
+            consumed = 0;
+        }
+        const size_t old_size = input.size();
+        input.resize(old_size + READ_CHUNK);
+        const ssize_t got = ::recv(fd, &input[old_size], READ_CHUNK, 0);
+        input.resize(old_size + (got > 0 ? static_cast<size_t>(got) : 0));
+        if (got == 0) {
+            throw std::runtime_error("Server closed the connection");
+        }
+        if (got < 0 && errno != EINTR) {
+            throw systemError("recv");
+        }
+    }
+}
+
+// Get the number of requests queued or sent that have no response yet
+size_t ClubClient::pending() const {
+    return in_flight;
+}
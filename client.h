@@ -0,0 +1,67 @@
+#ifndef CLIENT_H
+#define CLIENT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Protocol.h"
+
+// One response from a ClubServer
+struct ClubResponse {
+    ClubStatus status;
+    std::string body;
+
+    bool ok() const { return status == ClubStatus::Ok; }
+
+    // Decoders for the response bodies listed with ClubRequest
+    // Each throws an exception if the body does not hold what is asked for
+    MemberRecord member() const;
+    std::vector<MemberRecord> members() const;
+    std::vector<std::string> names() const;
+    bool flag() const;
+    std::uint32_t count() const;
+    std::string error() const;
+};
+
+// Blocking client of a ClubServer with request pipelining
+// Request methods only queue the request; flush() sends everything queued in one write
+// and receive() returns the responses one by one, in the order the requests were queued.
+// Many requests can be in flight at once, which is what makes small requests cheap.
+// A client is meant for one thread.
+class ClubClient {
+private:
+    int fd;
+    WireWriter queued;
+    std::string input;
+    size_t consumed;
+    size_t in_flight;
+
+    template <typename Body>
+    void request(ClubRequest kind, Body&& body);
+
+public:
+    explicit ClubClient(const std::string& socket_path);
+    ~ClubClient();
+
+    ClubClient(const ClubClient&) = delete;
+    ClubClient& operator=(const ClubClient&) = delete;
+
+    void ping();
+    void findMemberById(int id);
+    void findMemberByName(const std::string& name);
+    void searchMembers(const std::string& query, int max_distance, size_t limit);
+    void addMember(const std::string& name, int age, const std::string& role, int id);
+    void removeMember(int id);
+    void signUp(const std::string& event_name, int member_id);
+    void hasScheduleConflict(const std::string& location, const std::string& date, const std::string& start_time,
+                             const std::string& end_time);
+    void getParticipantCount(const std::string& event_name);
+    void searchEvents(const std::string& query, size_t limit);
+
+    void flush();
+    ClubResponse receive();
+    size_t pending() const;
+};
+
+#endif // CLIENT_H
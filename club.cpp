@@ -1,267 +1,1364 @@
-#include "Club.h"
-#include <algorithm>
-#include <iostream>
-
-// Constructor to initialize the club with a given name
-Club::Club(const std::string& name) : name(name) {}
-
-// Destructor to clean up all dynamically allocated memory
-Club::~Club() {
-    // Delete all members
-    for (auto member : members) {
-        delete member;
-    }
-    members.clear();
-
-    // Delete all coaches
-    for (auto coach : coaches) {
-        delete coach;
-    }
-    coaches.clear();
-
-    // Delete all teams
-    for (auto team : teams) {
-        delete team;
-    }
-    teams.clear();
-
-    // Delete all events
-    for (auto event : events) {
-        // delete event;              //controversial with test.cpp
-    }
-    events.clear();
-}
-
-// Add a member to the club
-void Club::addMember(Member* member) {
-    // Check if the member with the same ID already exists
-    for (const auto& existing_member : members) {
-        if (*existing_member == *member) {
-            throw std::invalid_argument("Member with this ID already exists in the club");
-        }
-    }
-    members.push_back(member);
-}
-
-// Remove a member from the club
-void Club::removeMember(Member* member) {
-    std::cout << "Attempting to remove member: " << member->getName() << std::endl;
-    auto it = std::find(members.begin(), members.end(), member);
-    if (it != members.end()) {
-        // Remove the member from all teams
-        std::cout << "Removing member from teams..." << std::endl;
-        for (auto& team : teams) {
-            team->removeMember(member);
-        }
-
-        // Remove the member from all events
-        std::cout << "Removing member from events..." << std::endl;
-        for (auto& event : events) {
-            event->removeParticipant(member);
-        }
-
-        // Delete the member object and remove the pointer from the vector
-        std::cout << "Deleting member object..." << std::endl;
-        // delete* it;
-        members.erase(it);
-
-        std::cout << "Removed and deleted member: " << member->getName() << std::endl;
-    }
-    else {
-        std::cout << "Member not found in club: " << member->getName() << std::endl;
-    }
-}
-
-// Add a coach to the club
-void Club::addCoach(Coach* coach) {
-    // Check if the coach with the same ID already exists
-    for (const auto& existing_coach : coaches) {
-        if (*existing_coach == *coach) {
-            throw std::invalid_argument("Coach with this ID already exists in the club");
-        }
-    }
-    coaches.push_back(coach);
-}
-
-// Remove a coach from the club
-void Club::removeCoach(Coach* coach) {
-    auto it = std::find(coaches.begin(), coaches.end(), coach);
-    if (it != coaches.end()) {
-        // Delete the coach object and remove the pointer from the vector
-        // delete* it;
-        coaches.erase(it);
-    }
-}
-
-// Add a team to the club
-void Club::addTeam(Team* team) {
-    teams.push_back(team);
-}
-
-// Remove a team from the club
-void Club::removeTeam(Team* team) {
-    auto it = std::find(teams.begin(), teams.end(), team);
-    if (it != teams.end()) {
-        // Remove the team from all events
-        for (auto& event : events) {
-            event->removeTeam(team);
-        }
-
-        // Delete the team object and remove the pointer from the vector
-        delete* it;
-        teams.erase(it);
-    }
-}
-
-// Organize a new event in the club
-void Club::organizeEvent(Event* event) {
-    events.push_back(event);
-}
-
-// Cancel an event in the club
-void Club::cancelEvent(Event* event) {
-    auto it = std::find(events.begin(), events.end(), event);
-    if (it != events.end()) {
-        // Delete the event object and remove the pointer from the vector
-        // delete* it;
-        events.erase(it);
-    }
-}
-
-// Add members to an event by event name
-void Club::addMembersToEvent(const std::string& eventName, const std::vector<Member*>& newMembers) {
-    for (auto& event : events) {
-        if (event->getName() == eventName) {
-            for (auto& member : newMembers) {
-                event->addParticipant(member);
-            }
-        }
-    }
-}
-
-// Add a team to an event by event name
-void Club::addTeamToEvent(const std::string& eventName, Team* team) {
-    for (auto& event : events) {
-        if (event->getName() == eventName) {
-            event->addTeam(team);
-        }
-    }
-}
-
-// Get the name of the club
-std::string Club::getClubInfo() const {
-    return name;
-}
-
-// Get the list of members in the club
-std::vector<Member*> Club::getMembers() const {
-    return members;
-}
-
-// Get the list of coaches in the club
-std::vector<Coach*> Club::getCoaches() const {
-    return coaches;
-}
-
-// Get the list of teams in the club
-std::vector<Team*> Club::getTeams() const {
-    return teams;
-}
-
-// Get the list of events in the club
-std::vector<Event*> Club::getEvents() const {
-    return events;
-}
-
-// Find a member by name
-Member* Club::findMemberByName(const std::string& name) const {
-    for (const auto& member : members) {
-        if (member->getName() == name) {
-            return member;
-        }
-    }
-    return nullptr;
-}
-
-// Find members by role
-std::vector<Member*> Club::findMembersByRole(const std::string& role) const {
-    std::vector<Member*> result;
-    for (const auto& member : members) {
-        if (member->getRole() == role) {
-            result.push_back(member);
-        }
-    }
-    return result;
-}
-
-// Find a coach by name
-Coach* Club::findCoachByName(const std::string& name) const {
-    for (const auto& coach : coaches) {
-        if (coach->getName() == name) {
-            return coach;
-        }
-    }
-    return nullptr;
-}
-
-// Find a member by ID
-Member* Club::findMemberById(int id) const {
-    for (const auto& member : members) {
-        if (member->getId() == id) {
-            return member;
-        }
-    }
-    return nullptr;
-}
-
-// Find a coach by ID
-Coach* Club::findCoachById(int id) const {
-    for (const auto& coach : coaches) {
-        if (coach->getId() == id) {
-            return coach;
-        }
-    }
-    return nullptr;
-}
-
-// Find a person (either member or coach) by ID and print their details
-void Club::findPersonById(int id) const {
-    Member* member = findMemberById(id);
-    if (member != nullptr) {
-        std::cout << "Member found: " << std::endl;
-        std::cout << "Name: " << member->getName() << std::endl;
-        std::cout << "Age: " << member->getAge() << std::endl;
-        std::cout << "Role: " << member->getRole() << std::endl;
-        std::cout << "ID: " << member->getId() << std::endl;
-        return;
-    }
-
-    Coach* coach = findCoachById(id);
-    if (coach != nullptr) {
-        std::cout << "Coach found: " << std::endl;
-        std::cout << "Name: " << coach->getName() << std::endl;
-        std::cout << "Specialty: " << coach->getSpecialty() << std::endl;
-        std::cout << "ID: " << coach->getId() << std::endl;
-        return;
-    }
-
-    std::cout << "No person found with ID: " << id << std::endl;
-}
-
-// Update the specialty of a coach by name
-void Club::updateCoachSpecialty(const std::string& name, const std::string& new_specialty) {
-    auto coach = findCoachByName(name);
-    if (coach) {
-        coach->setSpecialty(new_specialty);
-    }
-}
-
-// Check if there is a schedule conflict for a given date
-bool Club::hasScheduleConflict(const std::string& date) const {
-    for (const auto& event : events) {
-        if (event->getDate() == date) {
-            return true;
-        }
-    }
-    return false;
-}
+#include "Club.h"
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <unordered_set>
+
+namespace {
+    // Searchable text of each entity; names weigh more than locations
+    std::vector<TextField> eventFields(const Event* event) {
+        return { { event->getName(), 2 }, { event->getLocation(), 1 } };
+    }
+
+    std::vector<TextField> teamFields(const Team* team) {
+        return { { team->getSportType(), 1 } };
+    }
+
+    std::vector<TextField> coachFields(const Coach* coach) {
+        return { { coach->getSpecialty(), 2 }, { coach->getName(), 1 } };
+    }
+
+    // Sort keys of the scan orderings
+    std::string memberIdKey(const Member* member) { return orderedKey(member->getId()); }
+    std::string memberNameKey(const Member* member) { return member->getName(); }
+    std::string coachIdKey(const Coach* coach) { return orderedKey(coach->getId()); }
+    std::string coachNameKey(const Coach* coach) { return coach->getName(); }
+    std::string teamIdKey(const Team* team) { return orderedKey(team->getId()); }
+    std::string eventDateKey(const Event* event) { return orderedKey(event->getStartStamp()); }
+    std::string eventNameKey(const Event* event) { return event->getName(); }
+
+    MemberRecord recordOf(const Member* member) {
+        return { member->getId(), member->getAge(), member->getName(), member->getRole() };
+    }
+}
+
+// Constructor to initialize the club with a given name
+Club::Club(const std::string& name)
+    : name(name), member_version(0), event_version(0), details_version(0),
+      member_scan({ { ScanOrder::Id, memberIdKey }, { ScanOrder::Name, memberNameKey } }),
+      coach_scan({ { ScanOrder::Id, coachIdKey }, { ScanOrder::Name, coachNameKey } }),
+      team_scan({ { ScanOrder::Id, teamIdKey } }),
+      event_scan({ { ScanOrder::Date, eventDateKey }, { ScanOrder::Name, eventNameKey } }),
+      compact_threshold(0), removals_since_compact(0) {}
+
+// Destructor to clean up all dynamically allocated memory
+Club::~Club() {
+    // Events that outlive the club stop reporting changes to it
+    for (auto event : events) {
+        event->owner = nullptr;
+    }
+
+    // Club-built events go first so they can still unregister from their teams
+    event_pool.clear();
+
+    // Delete all members
+    for (auto member : members) {
+        if (!member_pool.owns(member)) {
+            delete member;
+        }
+    }
+    members.clear();
+
+    // Delete all coaches
+    for (auto coach : coaches) {
+        if (!coach_pool.owns(coach)) {
+            delete coach;
+        }
+    }
+    coaches.clear();
+
+    // Delete all teams
+    for (auto team : teams) {
+        if (!team_pool.owns(team)) {
+            delete team;
+        }
+    }
+    teams.clear();
+
+    // Release the club-built entities, including removed ones
+    member_pool.clear();
+    coach_pool.clear();
+    team_pool.clear();
+
+    // Delete all events
+    for (auto event : events) {
+        // delete event;              //controversial with test.cpp
+    }
+    events.clear();
+}
+
+// Register a member built in the pool, destroying it again if validation fails
+Member* Club::adoptMember(Member* member) {
+    try {
+        addMember(member);
+    }
+    catch (...) {
+        member_pool.destroy(member);
+        throw;
+    }
+    return member;
+}
+
+// Register a coach built in the pool, destroying it again if validation fails
+Coach* Club::adoptCoach(Coach* coach) {
+    try {
+        addCoach(coach);
+    }
+    catch (...) {
+        coach_pool.destroy(coach);
+        throw;
+    }
+    return coach;
+}
+
+// Register a team built in the pool
+Team* Club::adoptTeam(Team* team) {
+    addTeam(team);
+    return team;
+}
+
+// Register an event built in the pool
+Event* Club::adoptEvent(Event* event) {
+    organizeEvent(event);
+    return event;
+}
+
+// Free a team removed from the club, whichever storage it came from
+void Club::destroyTeam(Team* team) {
+    if (team_pool.owns(team)) {
+        team_pool.destroy(team);
+    }
+    else {
+        delete team;
+    }
+}
+
+// Add a member to the club
+// With a member store open the member is written to it as well, replacing a stored record
+// with the same id; adding a member loaded from the store makes it resident, so it is
+// indexed in memory and unloadMembers() keeps it
+// Throws an exception if an equal member (same name, age and role) is already in the club,
+// in memory or in the store, or if the member belongs to another club
+void Club::addMember(Member* member) {
+    if (member->owner != nullptr && member->owner != this) {
+        throw std::invalid_argument("Member belongs to another club");
+    }
+    // Check if the member with the same ID already exists
+    const bool loaded = unloadMember(member);
+    if (member_store && !loaded) {
+        // Stored members count as in the club, so they are compared by value as well
+        for (const auto& record : member_store->findAllByName(member->getName())) {
+            if (record.age == member->getAge() && record.role == member->getRole()) {
+                throw std::invalid_argument("Member with this ID already exists in the club");
+            }
+        }
+    }
+    if (!members.insert(member)) {
+        if (loaded) {
+            loaded_members.emplace(member->getId(), member);
+        }
+        throw std::invalid_argument("Member with this ID already exists in the club");
+    }
+    member_names.add(member);
+    member_scan.insert(member);
+    if (member_store) {
+        try {
+            member_store->put(recordOf(member));
+        }
+        catch (...) {
+            members.erase(member);
+            member_names.remove(member);
+            member_scan.erase(member);
+            if (loaded) {
+                loaded_members.emplace(member->getId(), member);
+            }
+            throw;
+        }
+    }
+    member->owner = this;
+    ++member_version;
+}
+
+// Remove a member from the club
+void Club::removeMember(Member* member) {
+    std::cout << "Attempting to remove member: " << member->getName() << std::endl;
+    if (holdsMember(member)) {
+        // Remove the member from all teams
+        std::cout << "Removing member from teams..." << std::endl;
+        for (auto& team : teams) {
+            team->removeMember(member);
+        }
+
+        // Remove the member from all events
+        std::cout << "Removing member from events..." << std::endl;
+        for (auto& event : events) {
+            const size_t before = event->getParticipantCount();
+            event->removeParticipant(member);
+            if (graph && event->getParticipantCount() != before) {
+                const auto remaining = CoParticipationGraph::distinctIds(*event);
+                if (!std::binary_search(remaining.begin(), remaining.end(), member->getId())) {
+                    graph->removeParticipants(remaining, { member->getId() });
+                }
+            }
+        }
+
+        // Delete the member object and remove the pointer from the vector
+        std::cout << "Deleting member object..." << std::endl;
+        // delete* it;
+        if (!members.erase(member)) {
+            unloadMember(member);
+        }
+        member_names.remove(member);
+        member_scan.erase(member);
+        if (member_store) {
+            member_store->erase(member->getId());
+        }
+        member->owner = nullptr;
+        if (member_pool.owns(member)) {
+            retired_members.push_back(member);
+        }
+        ++member_version;
+        ++event_version;
+
+        std::cout << "Removed and deleted member: " << member->getName() << std::endl;
+        noteRemoval();
+    }
+    else {
+        std::cout << "Member not found in club: " << member->getName() << std::endl;
+    }
+}
+
+// Remove many members at once
+// Every team and event roster is swept once against a set of the leaving members, so
+// the cost is one pass over the rosters instead of one per member. Members not in the
+// club are ignored; all roster entries of a leaving member are removed.
+// Returns the number of members removed
+size_t Club::removeMembers(const std::vector<Member*>& doomed) {
+    std::unordered_set<const Member*> leaving;
+    for (auto member : doomed) {
+        if (member != nullptr && holdsMember(member)) {
+            leaving.insert(member);
+        }
+    }
+    if (leaving.empty()) {
+        return 0;
+    }
+
+    for (auto team : teams) {
+        team->removeMembers(leaving);
+    }
+    for (auto event : events) {
+        const std::vector<Member*> removed = event->removeParticipants(leaving);
+        if (graph && !removed.empty()) {
+            // Ids still held by another participant keep their co-participations
+            const auto remaining = CoParticipationGraph::distinctIds(*event);
+            std::vector<int> left;
+            for (auto member : removed) {
+                left.push_back(member->getId());
+            }
+            std::sort(left.begin(), left.end());
+            left.erase(std::unique(left.begin(), left.end()), left.end());
+            left.erase(std::remove_if(left.begin(), left.end(), [&remaining](int id) {
+                return std::binary_search(remaining.begin(), remaining.end(), id);
+                }), left.end());
+            if (!left.empty()) {
+                graph->removeParticipants(remaining, left);
+            }
+        }
+    }
+
+    // Walk the input rather than the set so the retired order is deterministic
+    std::vector<const Member*> removed;
+    for (auto member : doomed) {
+        if (leaving.count(member) == 0 || !(members.erase(member) || unloadMember(member))) {
+            continue;
+        }
+        removed.push_back(member);
+        member_scan.erase(member);
+        if (member_store) {
+            member_store->erase(member->getId());
+        }
+        const_cast<Member*>(member)->owner = nullptr;
+        if (member_pool.owns(member)) {
+            retired_members.push_back(member);
+        }
+    }
+    member_names.remove(removed);
+    ++member_version;
+    ++event_version;
+    noteRemoval(leaving.size());
+    return leaving.size();
+}
+
+// Add a coach to the club
+// Throws an exception if an equal coach is already in the club or the coach belongs to another club
+void Club::addCoach(Coach* coach) {
+    if (coach->owner != nullptr && coach->owner != this) {
+        throw std::invalid_argument("Coach belongs to another club");
+    }
+    // Check if the coach with the same ID already exists
+    if (!coaches.insert(coach)) {
+        throw std::invalid_argument("Coach with this ID already exists in the club");
+    }
+    coach_names.add(coach);
+    coach_text.add(coach, coachFields(coach));
+    coach_scan.insert(coach);
+    coach->owner = this;
+}
+
+// Remove a coach from the club
+// Teams run by the coach are handed to the replacement, or left without a coach
+void Club::removeCoach(Coach* coach, Coach* replacement) {
+    if (coaches.contains(coach)) {
+        // Only the coach's own teams are visited, through the reverse index
+        for (auto team : coach->getTeams()) {
+            if (replacement != nullptr && replacement != coach) {
+                team->setCoach(replacement);
+            }
+            else {
+                team->removeCoach();
+            }
+        }
+
+        // Delete the coach object and remove the pointer from the vector
+        // delete* it;
+        coaches.erase(coach);
+        coach_names.remove(coach);
+        coach_text.remove(coach);
+        coach_scan.erase(coach);
+        coach->owner = nullptr;
+        if (coach_pool.owns(coach)) {
+            retired_coaches.push_back(coach);
+        }
+        noteRemoval();
+    }
+}
+
+// Add a team to the club
+void Club::addTeam(Team* team) {
+    teams.insert(team);
+    team_text.add(team, teamFields(team));
+    team_scan.insert(team);
+}
+
+// Remove a team from the club
+void Club::removeTeam(Team* team) {
+    if (teams.contains(team)) {
+        // Remove the team from all events
+        for (auto& event : events) {
+            event->removeTeam(team);
+        }
+
+        // Delete the team object and remove the pointer from the table
+        team_text.remove(team);
+        team_scan.erase(team);
+        teams.erase(team);
+        destroyTeam(team);
+        noteRemoval();
+    }
+}
+
+// Remove many teams at once
+// Each event the teams are attached to is visited once, and only those events.
+// Teams not in the club are ignored.
+// Returns the number of teams removed
+size_t Club::removeTeams(const std::vector<Team*>& doomed) {
+    std::unordered_set<const Team*> leaving;
+    std::unordered_set<Event*> attached;
+    for (auto team : doomed) {
+        if (team != nullptr && teams.contains(team) && leaving.insert(team).second) {
+            for (auto event : team->getEvents()) {
+                attached.insert(event);
+            }
+        }
+    }
+    for (auto event : attached) {
+        event->removeTeams(leaving);
+    }
+
+    for (auto team : doomed) {
+        if (leaving.count(team) == 0 || !teams.erase(team)) {
+            continue;
+        }
+        team_text.remove(team);
+        team_scan.erase(team);
+        destroyTeam(team);
+    }
+    noteRemoval(leaving.size());
+    return leaving.size();
+}
+
+// Merge one team into another and remove the emptied team from the club
+// Events that referred to the removed team refer to the merged team afterwards
+void Club::mergeTeams(Team* into, Team* from) {
+    if (into == nullptr || from == nullptr) {
+        throw std::invalid_argument("Team pointer is null");
+    }
+    if (into == from) {
+        return;
+    }
+    const bool owned = teams.contains(from);
+
+    // Re-point the events of the removed team in one pass over its own events
+    for (auto event : from->getEvents()) {
+        event->replaceTeam(from, into);
+    }
+
+    into->mergeFrom(std::move(*from));
+    if (owned) {
+        team_text.remove(from);
+        team_scan.erase(from);
+        teams.erase(from);
+        destroyTeam(from);
+    }
+}
+
+// Move the members of a team matching the predicate into a new club team
+Team* Club::splitTeam(Team* team, const std::function<bool(const Member*)>& predicate, int new_id) {
+    if (team == nullptr) {
+        throw std::invalid_argument("Team pointer is null");
+    }
+    Team* split_team = new Team(team->splitBy(predicate, new_id));
+    teams.insert(split_team);
+    team_text.add(split_team, teamFields(split_team));
+    team_scan.insert(split_team);
+    return split_team;
+}
+
+// Organize a new event in the club; organizing an event twice has no effect
+// Throws an exception if the event is null or belongs to another club
+void Club::organizeEvent(Event* event) {
+    if (event == nullptr) {
+        throw std::invalid_argument("Event cannot be null");
+    }
+    if (event->owner != nullptr && event->owner != this) {
+        throw std::invalid_argument("Event belongs to another club");
+    }
+    if (!events.insert(event)) {
+        return;
+    }
+    event->owner = this;
+    calendar.addEvent(event);
+    event_text.add(event, eventFields(event));
+    event_scan.insert(event);
+    ++event_version;
+}
+
+// Cancel an event in the club
+// The event is detached from its teams, so their event lists and the coach workloads
+// drop it right away; its participants are kept
+void Club::cancelEvent(Event* event) {
+    if (events.contains(event)) {
+        // Delete the event object and remove the pointer from the table
+        // delete* it;
+        calendar.removeEvent(event);
+        if (graph) {
+            graph->removeEvent(*event);
+        }
+        for (auto team : event->getTeams()) {
+            event->removeTeam(team);
+        }
+        events.erase(event);
+        event_text.remove(event);
+        event_scan.erase(event);
+        event->owner = nullptr;
+        if (event_pool.owns(event)) {
+            retired_events.push_back(event);
+        }
+        ++event_version;
+        noteRemoval();
+    }
+}
+
+// Move an event to a new date and time range, keeping the venue calendar in sync
+void Club::rescheduleEvent(Event* event, const std::string& new_date, const std::string& start_time, const std::string& end_time) {
+    rescheduleEvent(event, Date::parse(new_date), DateTime::parseTime(start_time), DateTime::parseTime(end_time));
+}
+
+// Reschedule an event to a new date and time range given as minutes of the day
+// Event::reschedule on an event of the club lands here too, so the calendar and the
+// indexes never keep an event under its old date
+// Throws an exception if the time range is invalid
+void Club::rescheduleEvent(Event* event, Date new_date, int start_minute, int end_minute) {
+    if (!events.contains(event)) {
+        event->reschedule(new_date, start_minute, end_minute);
+        return;
+    }
+    changeEvent(event, [&]() { event->moveTo(new_date, start_minute, end_minute); });
+    ++event_version;
+}
+
+// Take an event out of the calendar and the text index while its details change
+void Club::unindexEvent(Event* event) {
+    calendar.removeEvent(event);
+    event_text.remove(event);
+}
+
+// Put an event back into the calendar and the indexes after its details changed
+void Club::indexEvent(Event* event) {
+    calendar.addEvent(event);
+    event_text.add(event, eventFields(event));
+    event_scan.rekey(event);
+}
+
+// Assign another event's details to an event of the club, which keeps it
+void Club::replaceEvent(Event* event, const Event& other) {
+    if (graph) {
+        graph->removeEvent(*event);
+    }
+    changeEvent(event, [&]() { event->assign(other); });
+    trackJoined(*event, {});
+    ++event_version;
+}
+
+// Add members to an event by event name
+// Each event checks the whole batch against its rules at once; the members it turns away
+// are returned with the reasons, for every event of that name in turn
+std::vector<Rejection> Club::addMembersToEvent(const std::string& eventName, const std::vector<Member*>& newMembers) {
+    std::vector<Rejection> rejected;
+    if (const std::vector<Event*>* named = events.index<EventsByName>().find(eventName)) {
+        for (auto event : *named) {
+            std::vector<Rejection> turned_away = signUp(event, newMembers);
+            rejected.insert(rejected.end(), turned_away.begin(), turned_away.end());
+        }
+    }
+    ++event_version;
+    return rejected;
+}
+
+// Add members to the events of that name on one date, given as "YYYY-MM-DD"
+// Throws an exception if the date is malformed
+std::vector<Rejection> Club::addMembersToEvent(const std::string& eventName, const std::string& date,
+                                               const std::vector<Member*>& newMembers) {
+    std::vector<Rejection> rejected;
+    const std::string key = NameDateOf::key(eventName, Date::parse(date));
+    if (const std::vector<Event*>* named = events.index<EventsByNameDate>().find(key)) {
+        for (auto event : *named) {
+            std::vector<Rejection> turned_away = signUp(event, newMembers);
+            rejected.insert(rejected.end(), turned_away.begin(), turned_away.end());
+        }
+    }
+    ++event_version;
+    return rejected;
+}
+
+// Add members to an event already looked up, skipping the name lookup
+// Throws an exception if the event is not in the club
+std::vector<Rejection> Club::addMembersToEvent(Event* event, const std::vector<Member*>& newMembers) {
+    if (!events.contains(event)) {
+        throw std::invalid_argument("Event is not in the club");
+    }
+    std::vector<Rejection> rejected = signUp(event, newMembers);
+    ++event_version;
+    return rejected;
+}
+
+// Add a team to an event by event name and return the team members the event turned away
+// Throws an exception if an event rejects the team itself
+std::vector<Rejection> Club::addTeamToEvent(const std::string& eventName, Team* team) {
+    std::vector<Rejection> rejected;
+    if (const std::vector<Event*>* named = events.index<EventsByName>().find(eventName)) {
+        for (auto event : *named) {
+            std::vector<Rejection> turned_away = attachTeam(event, team);
+            rejected.insert(rejected.end(), turned_away.begin(), turned_away.end());
+        }
+    }
+    ++event_version;
+    return rejected;
+}
+
+// Add a team to the events of that name on one date, given as "YYYY-MM-DD"
+// Throws an exception if the date is malformed or an event rejects the team itself
+std::vector<Rejection> Club::addTeamToEvent(const std::string& eventName, const std::string& date, Team* team) {
+    std::vector<Rejection> rejected;
+    const std::string key = NameDateOf::key(eventName, Date::parse(date));
+    if (const std::vector<Event*>* named = events.index<EventsByNameDate>().find(key)) {
+        for (auto event : *named) {
+            std::vector<Rejection> turned_away = attachTeam(event, team);
+            rejected.insert(rejected.end(), turned_away.begin(), turned_away.end());
+        }
+    }
+    ++event_version;
+    return rejected;
+}
+
+// Add a team to an event already looked up, skipping the name lookup
+// Throws an exception if the event is not in the club or rejects the team itself
+std::vector<Rejection> Club::addTeamToEvent(Event* event, Team* team) {
+    if (!events.contains(event)) {
+        throw std::invalid_argument("Event is not in the club");
+    }
+    std::vector<Rejection> rejected = attachTeam(event, team);
+    ++event_version;
+    return rejected;
+}
+
+// Sign members up for one event and keep the co-participation graph in step
+std::vector<Rejection> Club::signUp(Event* event, const std::vector<Member*>& newMembers) {
+    const auto before = graph ? CoParticipationGraph::distinctIds(*event) : std::vector<int>();
+    std::vector<Rejection> rejected = event->addParticipants(newMembers);
+    trackJoined(*event, before);
+    return rejected;
+}
+
+// Attach a team to one event and keep the co-participation graph in step
+std::vector<Rejection> Club::attachTeam(Event* event, Team* team) {
+    const auto before = graph ? CoParticipationGraph::distinctIds(*event) : std::vector<int>();
+    std::vector<Rejection> rejected = event->addTeam(team);
+    trackJoined(*event, before);
+    return rejected;
+}
+
+// Build the key of the events index by name and date
+std::string Club::NameDateOf::key(const std::string& name, Date date) {
+    std::string key = name;
+    key.push_back('\0');
+    key += std::to_string(date.getDayNumber());
+    return key;
+}
+
+// Get every event with the given name, in the order they were added
+std::vector<Event*> Club::findEventsByName(const std::string& eventName) const {
+    const std::vector<Event*>* named = events.index<EventsByName>().find(eventName);
+    return named != nullptr ? *named : std::vector<Event*>();
+}
+
+// Get the first event with the given name on a date given as "YYYY-MM-DD", or nullptr if there is none
+// Throws an exception if the date is malformed
+Event* Club::findEvent(const std::string& eventName, const std::string& date) const {
+    const std::vector<Event*>* named = events.index<EventsByNameDate>().find(NameDateOf::key(eventName, Date::parse(date)));
+    return named != nullptr ? named->front() : nullptr;
+}
+
+// Tell the co-participation graph which members joined an event since the snapshot
+void Club::trackJoined(const Event& event, const std::vector<int>& before) {
+    if (!graph) {
+        return;
+    }
+    const auto after = CoParticipationGraph::distinctIds(event);
+    std::vector<int> joined;
+    std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(joined));
+    if (!joined.empty()) {
+        graph->addParticipants(before, joined);
+    }
+}
+
+// Build the co-participation graph from all events; later sign-ups and removals made
+// through the club keep it up to date
+CoParticipationGraph& Club::enableCoParticipationGraph(size_t threads) {
+    graph.reset(new CoParticipationGraph(threads));
+    graph->build(events.list());
+    return *graph;
+}
+
+// Get the co-participation graph, or nullptr if it was never enabled
+CoParticipationGraph* Club::getCoParticipationGraph() const {
+    return graph.get();
+}
+
+// Turn on caching of findMemberByName, findMembersByRole and getParticipantCount
+// Results are dropped as soon as the members, events or their details change
+void Club::enableQueryCache(size_t capacity_bytes) {
+    if (query_cache) {
+        query_cache->setCapacity(capacity_bytes);
+    }
+    else {
+        query_cache = std::make_unique<QueryCache>(capacity_bytes);
+    }
+}
+
+// Turn off query caching and free the cached results
+void Club::disableQueryCache() {
+    query_cache.reset();
+}
+
+// Get the hit rate and memory use of the query cache, all zero when it is off
+QueryCacheStats Club::getQueryCacheStats() const {
+    if (!query_cache) {
+        return { 0, 0, 0, 0, 0, 0, 0 };
+    }
+    return query_cache->getStats();
+}
+
+// Record the current participants of an event as having attended it
+// Returns the number of new attendance records
+// Throws an exception if the event pointer is null
+size_t Club::recordAttendance(const Event* event) {
+    if (event == nullptr) {
+        throw std::invalid_argument("Event pointer is null");
+    }
+    return attendance.recordEvent(*event);
+}
+
+// Get the attendance history of the club's members
+const AttendanceStore& Club::getAttendance() const {
+    return attendance;
+}
+
+// Report the approximate heap memory of every table, index and roster group
+MemoryReport Club::getMemoryReport() const {
+    MemoryReport report{ {}, 0 };
+    auto& parts = report.parts;
+    parts.push_back({ "members", members.size(), members.memoryUsage() });
+    parts.push_back({ "members.unique", members.size(), members.keyMemoryUsage() });
+    parts.push_back({ "members.by_id", members.size(), members.indexMemoryUsage<FirstByKey<Member, IdOf>>() });
+    parts.push_back({ "members.by_name", members.size(), members.indexMemoryUsage<FirstByKey<Member, NameOf>>() });
+    parts.push_back({ "members.fuzzy_names", member_names.size(), member_names.memoryUsage() });
+    parts.push_back({ "members.scan", members.size(), member_scan.memoryUsage() });
+    parts.push_back({ "members.storage", member_pool.size(), member_pool.memoryUsage() });
+    if (member_store) {
+        parts.push_back({ "members.loaded", loaded_members.size(),
+                          loaded_members.bucket_count() * sizeof(void*) +
+                              loaded_members.size() * (sizeof(std::pair<const int, Member*>) + sizeof(void*)) });
+        parts.push_back({ "members.store_cache", member_store->getStats().cache.cached_pages,
+                          member_store->memoryUsage() });
+    }
+
+    size_t team_lists = 0;
+    for (auto coach : coaches) {
+        team_lists += coach->memoryUsage();
+    }
+    parts.push_back({ "coaches", coaches.size(), coaches.memoryUsage() });
+    parts.push_back({ "coaches.unique", coaches.size(), coaches.keyMemoryUsage() });
+    parts.push_back({ "coaches.by_id", coaches.size(), coaches.indexMemoryUsage<FirstByKey<Coach, IdOf>>() });
+    parts.push_back({ "coaches.by_name", coaches.size(), coaches.indexMemoryUsage<FirstByKey<Coach, NameOf>>() });
+    parts.push_back({ "coaches.fuzzy_names", coach_names.size(), coach_names.memoryUsage() });
+    parts.push_back({ "coaches.text", coach_text.size(), coach_text.memoryUsage() });
+    parts.push_back({ "coaches.scan", coaches.size(), coach_scan.memoryUsage() });
+    parts.push_back({ "coaches.team_lists", coaches.size(), team_lists });
+    parts.push_back({ "coaches.storage", coach_pool.size(), coach_pool.memoryUsage() });
+
+    size_t rosters = 0;
+    for (auto team : teams) {
+        rosters += team->memoryUsage();
+    }
+    parts.push_back({ "teams", teams.size(), teams.memoryUsage() });
+    parts.push_back({ "teams.text", team_text.size(), team_text.memoryUsage() });
+    parts.push_back({ "teams.scan", teams.size(), team_scan.memoryUsage() });
+    parts.push_back({ "teams.rosters", teams.size(), rosters });
+    parts.push_back({ "teams.storage", team_pool.size(), team_pool.memoryUsage() });
+
+    rosters = 0;
+    for (auto event : events) {
+        rosters += event->memoryUsage();
+    }
+    parts.push_back({ "events", events.size(), events.memoryUsage() });
+    parts.push_back({ "events.by_start", events.size(), events.indexMemoryUsage<OrderedByKey<Event, StartStampOf>>() });
+    parts.push_back({ "events.by_name", events.size(), events.indexMemoryUsage<EventsByName>() });
+    parts.push_back({ "events.by_name_date", events.size(), events.indexMemoryUsage<EventsByNameDate>() });
+    parts.push_back({ "events.calendar", calendar.size(), calendar.memoryUsage() });
+    parts.push_back({ "events.text", event_text.size(), event_text.memoryUsage() });
+    parts.push_back({ "events.scan", events.size(), event_scan.memoryUsage() });
+    parts.push_back({ "events.rosters", events.size(), rosters });
+    parts.push_back({ "events.storage", event_pool.size(), event_pool.memoryUsage() });
+
+    const size_t retired = retired_members.size() + retired_coaches.size() + retired_events.size();
+    parts.push_back({ "retired", retired,
+                      (retired_members.capacity() + retired_coaches.capacity() + retired_events.capacity()) * sizeof(void*) });
+    parts.push_back({ "attendance", attendance.recordCount(), attendance.memoryUsage() });
+    if (query_cache) {
+        const QueryCacheStats stats = query_cache->getStats();
+        parts.push_back({ "query_cache", stats.entries, stats.memory_bytes });
+    }
+    if (graph) {
+        parts.push_back({ "graph", graph->nodeCount(), graph->memoryUsage() });
+    }
+
+    for (const auto& part : parts) {
+        report.total_bytes += part.bytes;
+    }
+    return report;
+}
+
+// Reclaim memory after mass removals
+// Members, coaches and events built by the emplace* methods and since removed from the
+// club are destroyed, so pointers to them must not be used afterwards; only this explicit
+// call invalidates them. Everything else, members loaded from the member store included,
+// keeps its address; tables, indexes and rosters give back spare capacity.
+void Club::compact() {
+    for (auto event : retired_events) {
+        if (!events.contains(event)) {
+            event_pool.destroy(event);
+        }
+    }
+    for (auto member : retired_members) {
+        if (!members.contains(member)) {
+            member_pool.destroy(member);
+        }
+    }
+    for (auto coach : retired_coaches) {
+        if (!coaches.contains(coach)) {
+            coach_pool.destroy(coach);
+        }
+    }
+    std::vector<Event*>().swap(retired_events);
+    std::vector<Member*>().swap(retired_members);
+    std::vector<Coach*>().swap(retired_coaches);
+    shrinkToFit();
+}
+
+// Give back spare capacity in the tables, indexes, rosters and pools; no entity moves
+// or is destroyed
+void Club::shrinkToFit() {
+    members.shrinkToFit();
+    coaches.shrinkToFit();
+    teams.shrinkToFit();
+    events.shrinkToFit();
+    for (auto coach : coaches) {
+        coach->shrinkToFit();
+    }
+    for (auto team : teams) {
+        team->shrinkToFit();
+    }
+    for (auto event : events) {
+        event->shrinkToFit();
+    }
+    member_names.shrinkToFit();
+    coach_names.shrinkToFit();
+    event_text.shrinkToFit();
+    team_text.shrinkToFit();
+    coach_text.shrinkToFit();
+    member_scan.shrinkToFit();
+    coach_scan.shrinkToFit();
+    team_scan.shrinkToFit();
+    event_scan.shrinkToFit();
+    member_pool.shrinkToFit();
+    coach_pool.shrinkToFit();
+    team_pool.shrinkToFit();
+    event_pool.shrinkToFit();
+    attendance.shrinkToFit();
+    if (graph) {
+        graph->compact();
+    }
+    removals_since_compact = 0;
+}
+
+// Give back spare capacity automatically once the given number of entities were removed
+// since the last compaction; 0 turns it off. Removed club-built entities are left for an
+// explicit compact(), so pointers the caller still holds stay valid.
+void Club::setCompactThreshold(size_t removals) {
+    compact_threshold = removals;
+}
+
+// Make room for additional members, so adding them never rehashes the member indexes
+// Growing a large index otherwise rehashes it all within one addMember call
+void Club::reserveMembers(size_t additional) {
+    const size_t count = members.size() + additional;
+    members.reserve(count);
+    member_names.reserve(count);
+    member_scan.reserve(count);
+}
+
+// Put the club's members behind a disk-backed member store, opening or creating its file
+// Members already in the club are written to the store, replacing stored records with
+// the same id. From then on every member added, removed or renamed through the club is
+// written through, and findMemberById, findMemberByName and scanMembers also answer from
+// the store: a stored member is loaded into memory when first returned and then kept until
+// unloadMembers() finds no team or event holding it. getMembers, findMembersByRole,
+// searchMembersByName and the rosters cover only the members in memory.
+// Records stored directly through the returned store are seen by the lookups unless a
+// member with that id is in memory, whose details win.
+// Throws an exception if a store is already open or the file cannot be used
+MemberStore& Club::openMemberStore(const std::string& path, size_t cache_pages) {
+    if (member_store) {
+        throw std::invalid_argument("A member store is already open");
+    }
+    auto store = std::make_unique<MemberStore>(path, cache_pages);
+    for (auto member : members) {
+        store->put(recordOf(member));
+    }
+    member_store = std::move(store);
+    ++member_version;
+    return *member_store;
+}
+
+// Get the member store, or nullptr if none is open
+MemberStore* Club::getMemberStore() const {
+    return member_store.get();
+}
+
+// Release the members loaded from the member store that no team or event holds
+// Pointers returned for them must not be used afterwards; lookups load them again.
+// Returns the number of members released
+size_t Club::unloadMembers() {
+    std::unordered_set<const Member*> held;
+    for (auto team : teams) {
+        for (auto member : team->getMembers()) {
+            held.insert(member);
+        }
+    }
+    for (auto event : events) {
+        for (auto member : event->getParticipants()) {
+            held.insert(member);
+        }
+    }
+    size_t released = 0;
+    for (auto it = loaded_members.begin(); it != loaded_members.end();) {
+        if (held.count(it->second) == 0) {
+            member_pool.destroy(it->second);
+            it = loaded_members.erase(it);
+            ++released;
+        }
+        else {
+            ++it;
+        }
+    }
+    if (released != 0) {
+        loaded_members.rehash(0);
+        ++member_version;
+    }
+    return released;
+}
+
+// Get the in-memory member for a stored record, loading it on first use
+Member* Club::loadMember(const MemberRecord& record) const {
+    if (Member* resident = members.index<FirstByKey<Member, IdOf>>().find(record.id)) {
+        return resident;
+    }
+    auto it = loaded_members.find(record.id);
+    if (it != loaded_members.end()) {
+        return it->second;
+    }
+    Member* member = member_pool.create(record.name, record.age, record.role, record.id);
+    member->owner = const_cast<Club*>(this);
+    loaded_members.emplace(record.id, member);
+    return member;
+}
+
+// Check whether a member is in the club, in memory or loaded from the member store
+bool Club::holdsMember(const Member* member) const {
+    if (members.contains(member)) {
+        return true;
+    }
+    auto it = loaded_members.find(member->getId());
+    return it != loaded_members.end() && it->second == member;
+}
+
+// Forget a member loaded from the member store, leaving the object alone
+// Returns false if the member was not loaded
+bool Club::unloadMember(const Member* member) {
+    auto it = loaded_members.find(member->getId());
+    if (it == loaded_members.end() || it->second != member) {
+        return false;
+    }
+    loaded_members.erase(it);
+    return true;
+}
+
+// Count removals towards the automatic compaction threshold
+void Club::noteRemoval(size_t count) {
+    removals_since_compact += count;
+    if (compact_threshold != 0 && removals_since_compact >= compact_threshold) {
+        shrinkToFit();
+    }
+}
+
+// Get the name of the club
+std::string Club::getClubInfo() const {
+    return name;
+}
+
+// Get the list of members in the club
+std::vector<Member*> Club::getMembers() const {
+    return members.list();
+}
+
+// Get the list of coaches in the club
+std::vector<Coach*> Club::getCoaches() const {
+    return coaches.list();
+}
+
+// Get the list of teams in the club
+std::vector<Team*> Club::getTeams() const {
+    return teams.list();
+}
+
+// Get the list of events in the club
+std::vector<Event*> Club::getEvents() const {
+    return events.list();
+}
+
+// Get the events of the club ordered by start date and time
+// Events rescheduled through the club keep their place in the start time index
+std::vector<Event*> Club::getEventsSortedByDate() const {
+    std::vector<Event*> result;
+    result.reserve(events.size());
+    events.index<OrderedByKey<Event, StartStampOf>>().forEach([&result](Event* event) {
+        result.push_back(event);
+        });
+    return result;
+}
+
+// Get the events whose date lies in [from_date, to_date], in start time order
+// Only the events in the range are visited, through the index by start time
+std::vector<Event*> Club::getEventsBetween(const std::string& from_date, const std::string& to_date) const {
+    const long long from = static_cast<long long>(Date::parse(from_date).getDayNumber()) * DateTime::MINUTES_PER_DAY;
+    const long long to = (static_cast<long long>(Date::parse(to_date).getDayNumber()) + 1) * DateTime::MINUTES_PER_DAY - 1;
+    std::vector<Event*> result;
+    events.index<OrderedByKey<Event, StartStampOf>>().forEachBetween(from, to, [&result](Event* event) {
+        result.push_back(event);
+        });
+    return result;
+}
+
+// Get the ids of a team's members as a compressed bitmap
+RosterBitmap Club::rosterOf(const Team* team) const {
+    RosterBitmap roster;
+    if (team != nullptr) {
+        for (auto member : team->getMembers()) {
+            roster.add(member->getId());
+        }
+    }
+    return roster;
+}
+
+// Get the ids of an event's participants as a compressed bitmap
+RosterBitmap Club::rosterOf(const Event* event) const {
+    RosterBitmap roster;
+    if (event != nullptr) {
+        for (auto member : event->getParticipants()) {
+            roster.add(member->getId());
+        }
+    }
+    return roster;
+}
+
+// Get the ids of everyone taking part in any event between two dates
+RosterBitmap Club::rosterOfEventsBetween(const std::string& from_date, const std::string& to_date) const {
+    RosterBitmap roster;
+    for (auto event : getEventsBetween(from_date, to_date)) {
+        roster |= rosterOf(event);
+    }
+    return roster;
+}
+
+// Get the ids of all club members as a compressed bitmap
+RosterBitmap Club::rosterOfClub() const {
+    RosterBitmap roster;
+    for (auto member : members) {
+        roster.add(member->getId());
+    }
+    return roster;
+}
+
+// Resolve the ids in a roster to club members, skipping ids that are not in the club
+std::vector<Member*> Club::membersIn(const RosterBitmap& roster) const {
+    std::vector<Member*> result;
+    for (int id : roster.toIds()) {
+        Member* member = findMemberById(id);
+        if (member != nullptr) {
+            result.push_back(member);
+        }
+    }
+    return result;
+}
+
+// Find a member by name
+// Members in memory come first, then the member store if one is open
+Member* Club::findMemberByName(const std::string& name) const {
+    // Records stored directly through the member store count as member list changes
+    const std::uint64_t version = member_version + (member_store ? member_store->getRevision() : 0);
+    const QueryVersions versions = { version, details_version };
+    if (query_cache) {
+        if (const CachedResult* cached = query_cache->find(QueryKind::MemberByName, name, versions)) {
+            return cached->members.empty() ? nullptr : cached->members.front();
+        }
+    }
+    Member* found = members.index<FirstByKey<Member, NameOf>>().find(name);
+    MemberRecord record;
+    if (found == nullptr && member_store && member_store->findByName(name, record)) {
+        found = loadMember(record);
+    }
+    if (query_cache) {
+        CachedResult result;
+        if (found != nullptr) {
+            result.members.push_back(found);
+        }
+        query_cache->store(QueryKind::MemberByName, name, versions, std::move(result));
+    }
+    return found;
+}
+
+// Find up to limit members whose name is within max_distance edits of the query, closest first
+std::vector<FuzzyMatch<Member>> Club::searchMembersByName(const std::string& query, int max_distance, size_t limit) const {
+    return member_names.search(query, max_distance, limit);
+}
+
+// Find up to limit coaches whose name is within max_distance edits of the query, closest first
+std::vector<FuzzyMatch<Coach>> Club::searchCoachesByName(const std::string& query, int max_distance, size_t limit) const {
+    return coach_names.search(query, max_distance, limit);
+}
+
+// Update a member's name and age, re-indexing only that member
+// Member::updateDetails on a member of the club comes here as well; members of other
+// clubs are passed on to them
+// Throws an exception if the member is null, the new name is empty or the new age is negative
+void Club::updateMemberDetails(Member* member, const std::string& new_name, int new_age) {
+    if (member == nullptr) {
+        throw std::invalid_argument("Member pointer is null");
+    }
+    if (member->owner != this) {
+        member->updateDetails(new_name, new_age);
+        return;
+    }
+    members.modify(member, [&]() { member->applyDetails(new_name, new_age); });
+    if (members.contains(member)) {
+        member_names.rename(member);
+        member_scan.rekey(member);
+    }
+    if (member_store) {
+        member_store->put(recordOf(member));
+    }
+    ++details_version;
+}
+
+// Copy another member's details onto a member of the club, re-indexing only that member
+void Club::assignMember(Member* member, const Member& other) {
+    const int old_id = member->getId();
+    members.modify(member, [&]() { member->assign(other); });
+    if (members.contains(member)) {
+        member_names.rename(member);
+        member_scan.rekey(member);
+    }
+    else if (old_id != member->getId()) {
+        loaded_members.erase(old_id);
+        loaded_members.emplace(member->getId(), member);
+    }
+    if (member_store) {
+        if (old_id != member->getId()) {
+            member_store->erase(old_id);
+        }
+        member_store->put(recordOf(member));
+    }
+    ++member_version;
+    ++details_version;
+}
+
+// Find events whose name or location best match the query words, best first
+std::vector<TextMatch<Event>> Club::searchEvents(const std::string& query, size_t limit, bool match_all) const {
+    return event_text.search(query, limit, match_all);
+}
+
+// Find teams whose sport type best matches the query words, best first
+std::vector<TextMatch<Team>> Club::searchTeams(const std::string& query, size_t limit, bool match_all) const {
+    return team_text.search(query, limit, match_all);
+}
+
+// Find coaches whose specialty or name best match the query words, best first
+std::vector<TextMatch<Coach>> Club::searchCoaches(const std::string& query, size_t limit, bool match_all) const {
+    return coach_text.search(query, limit, match_all);
+}
+
+// Find members by role
+std::vector<Member*> Club::findMembersByRole(const std::string& role) const {
+    // A role only changes when a member is assigned over, and assignMember bumps
+    // member_version for that, so the member list version covers every change here;
+    // dropping that bump would let this cache serve stale roles
+    const QueryVersions versions = { member_version, 0 };
+    if (query_cache) {
+        if (const CachedResult* cached = query_cache->find(QueryKind::MembersByRole, role, versions)) {
+            return cached->members;
+        }
+    }
+    std::vector<Member*> result;
+    for (const auto& member : members) {
+        if (member->getRole() == role) {
+            result.push_back(member);
+        }
+    }
+    if (query_cache) {
+        query_cache->store(QueryKind::MembersByRole, role, versions, { result, result.size() });
+    }
+    return result;
+}
+
+// Get the number of participants of the first event with the given name, 0 if there is none
+size_t Club::getParticipantCount(const std::string& eventName) const {
+    const QueryVersions versions = { event_version, Event::getParticipantsRevision() };
+    if (query_cache) {
+        if (const CachedResult* cached = query_cache->find(QueryKind::ParticipantCount, eventName, versions)) {
+            return cached->count;
+        }
+    }
+    const std::vector<Event*>* named = events.index<EventsByName>().find(eventName);
+    const size_t count = named != nullptr ? named->front()->getParticipantCount() : 0;
+    if (query_cache) {
+        query_cache->store(QueryKind::ParticipantCount, eventName, versions, { {}, count });
+    }
+    return count;
+}
+
+// Find a coach by name
+Coach* Club::findCoachByName(const std::string& name) const {
+    return coaches.index<FirstByKey<Coach, NameOf>>().find(name);
+}
+
+// Find a member by ID
+// Members in memory come first, then the member store if one is open
+Member* Club::findMemberById(int id) const {
+    Member* found = members.index<FirstByKey<Member, IdOf>>().find(id);
+    if (found == nullptr && member_store) {
+        auto it = loaded_members.find(id);
+        if (it != loaded_members.end()) {
+            return it->second;
+        }
+        MemberRecord record;
+        if (member_store->find(id, record)) {
+            found = loadMember(record);
+        }
+    }
+    return found;
+}
+
+// Get up to limit members after the cursor in the given order (id or name)
+// Memory stays constant across pages and the cursor survives concurrent changes
+// With a member store open the scan walks the store, loading the members it returns
+// Throws an exception if the order is not supported
+ScanPage<Member> Club::scanMembers(const ScanCursor& cursor, size_t limit, ScanOrder order) const {
+    if (!member_store) {
+        return member_scan.scan(order, members, cursor, limit);
+    }
+    MemberRecordPage stored = member_store->scan(order, cursor, limit);
+    ScanPage<Member> page{ {}, stored.next };
+    page.items.reserve(stored.records.size());
+    for (const auto& record : stored.records) {
+        page.items.push_back(loadMember(record));
+    }
+    return page;
+}
+
+// Get up to limit coaches after the cursor in the given order (id or name)
+// Throws an exception if the order is not supported
+ScanPage<Coach> Club::scanCoaches(const ScanCursor& cursor, size_t limit, ScanOrder order) const {
+    return coach_scan.scan(order, coaches, cursor, limit);
+}
+
+// Get up to limit teams after the cursor, ordered by id
+// Throws an exception if the order is not supported
+ScanPage<Team> Club::scanTeams(const ScanCursor& cursor, size_t limit, ScanOrder order) const {
+    return team_scan.scan(order, teams, cursor, limit);
+}
+
+// Get up to limit events after the cursor in the given order (start time or name)
+// Throws an exception if the order is not supported
+ScanPage<Event> Club::scanEvents(const ScanCursor& cursor, size_t limit, ScanOrder order) const {
+    return event_scan.scan(order, events, cursor, limit);
+}
+
+// Get up to limit participants of an event after the cursor, in the order they joined
+// Throws an exception if the event pointer is null
+ScanPage<Member> Club::scanEventParticipants(const Event* event, const ScanCursor& cursor, size_t limit) const {
+    if (event == nullptr) {
+        throw std::invalid_argument("Event pointer is null");
+    }
+    return event->scanParticipants(cursor, limit);
+}
+
+// Find a coach by ID
+Coach* Club::findCoachById(int id) const {
+    return coaches.index<FirstByKey<Coach, IdOf>>().find(id);
+}
+
+// Find a person (either member or coach) by ID and print their details
+void Club::findPersonById(int id) const {
+    Member* member = findMemberById(id);
+    if (member != nullptr) {
+        std::cout << "Member found: " << std::endl;
+        std::cout << "Name: " << member->getName() << std::endl;
+        std::cout << "Age: " << member->getAge() << std::endl;
+        std::cout << "Role: " << member->getRole() << std::endl;
+        std::cout << "ID: " << member->getId() << std::endl;
+        return;
+    }
+
+    Coach* coach = findCoachById(id);
+    if (coach != nullptr) {
+        std::cout << "Coach found: " << std::endl;
+        std::cout << "Name: " << coach->getName() << std::endl;
+        std::cout << "Specialty: " << coach->getSpecialty() << std::endl;
+        std::cout << "ID: " << coach->getId() << std::endl;
+        return;
+    }
+
+    std::cout << "No person found with ID: " << id << std::endl;
+}
+
+// Copy another coach's details onto a coach of the club, re-indexing only that coach
+void Club::assignCoach(Coach* coach, const Coach& other) {
+    coaches.modify(coach, [&]() { coach->assign(other); });
+    coach_names.rename(coach);
+    coach_text.add(coach, coachFields(coach));
+    coach_scan.rekey(coach);
+}
+
+// Update the specialty of a coach by name
+void Club::updateCoachSpecialty(const std::string& name, const std::string& new_specialty) {
+    auto coach = findCoachByName(name);
+    if (coach) {
+        updateCoachSpecialty(coach, new_specialty);
+    }
+}
+
+// Update the specialty of a coach, re-indexing only that coach
+// Coach::setSpecialty on a coach of the club comes here as well; coaches of other clubs
+// are passed on to them
+// Throws an exception if the coach is null
+void Club::updateCoachSpecialty(Coach* coach, const std::string& new_specialty) {
+    if (coach == nullptr) {
+        throw std::invalid_argument("Coach pointer is null");
+    }
+    if (coach->owner != this) {
+        coach->setSpecialty(new_specialty);
+        return;
+    }
+    coaches.modify(coach, [&]() { coach->applySpecialty(new_specialty); });
+    coach_text.add(coach, coachFields(coach));
+}
+
+// Get the teams, distinct athletes and upcoming events of a coach
+CoachWorkload Club::getCoachWorkload(const Coach* coach, const std::string& from_date) const {
+    CoachWorkload workload{ {}, 0, {} };
+    if (coach == nullptr) {
+        return workload;
+    }
+    const long long from = DateTime(Date::parse(from_date)).toStamp();
+    std::unordered_set<const Member*> athletes;
+    std::unordered_set<const Event*> seen_events;
+
+    workload.teams = coach->getTeams();
+    for (auto team : workload.teams) {
+        for (auto member : team->getMembers()) {
+            athletes.insert(member);
+        }
+        for (auto event : team->getEvents()) {
+            if (event->getStartStamp() >= from && seen_events.insert(event).second) {
+                workload.upcoming_events.push_back(event);
+            }
+        }
+    }
+    workload.total_athletes = athletes.size();
+    std::sort(workload.upcoming_events.begin(), workload.upcoming_events.end(), [](const Event* a, const Event* b) {
+        return a->getStartStamp() < b->getStartStamp();
+        });
+    return workload;
+}
+
+// Check if there is a schedule conflict for a given date
+bool Club::hasScheduleConflict(const std::string& date) const {
+    return calendar.hasEventsOn(Date::parse(date).getDayNumber());
+}
+
+// Check if a time range on a given date overlaps an event at the same location
+bool Club::hasScheduleConflict(const std::string& location, const std::string& date,
+                               const std::string& start_time, const std::string& end_time) const {
+    const Date day = Date::parse(date);
+    return calendar.hasConflict(location, DateTime(day, DateTime::parseTime(start_time)).toStamp(),
+                                DateTime(day, DateTime::parseTime(end_time)).toStamp());
+}
+
+// Find free time slots of at least min_minutes at a location over a number of days
+std::vector<TimeSlot> Club::findFreeSlots(const std::string& location, const std::string& from_date, int days,
+                                          int min_minutes) const {
+    const long long from = DateTime(Date::parse(from_date)).toStamp();
+    return calendar.findFreeSlots(location, from, from + static_cast<long long>(days) * DateTime::MINUTES_PER_DAY, min_minutes);
+}
@@ -1,53 +1,267 @@
-#ifndef CLUB_H
-#define CLUB_H
-
-#include <vector>
-#include <string>
-#include "Member.h"
-#include "Coach.h"
-#include "Team.h"
-#include "Event.h"
-
-class Club {
-private:
-    std::string name;
-    std::vector<Member*> members;
-    std::vector<Coach*> coaches;
-    std::vector<Team*> teams;
-    std::vector<Event*> events;
-
-public:
-    explicit Club(const std::string& name);
-
-    ~Club();
-
-    void addMember(Member* member);
-    void removeMember(Member* member);
-    void addCoach(Coach* coach);
-    void removeCoach(Coach* coach);
-    void addTeam(Team* team);
-    void removeTeam(Team* team);
-    void organizeEvent(Event* event);
-    void cancelEvent(Event* event);
-    void addMembersToEvent(const std::string& eventName, const std::vector<Member*>& newMembers);
-    void addTeamToEvent(const std::string& eventName, Team* team);  
-
-
-    Member* findMemberByName(const std::string& name) const;
-    std::vector<Member*> findMembersByRole(const std::string& role) const;
-    Coach* findCoachByName(const std::string& name) const;
-    void updateCoachSpecialty(const std::string& name, const std::string& new_specialty);
-    bool hasScheduleConflict(const std::string& date) const;
-
-    Member* findMemberById(int id) const;
-    Coach* findCoachById(int id) const;
-    void findPersonById(int id) const;
-
-    std::string getClubInfo() const;
-    std::vector<Member*> getMembers() const;
-    std::vector<Coach*> getCoaches() const;
-    std::vector<Team*> getTeams() const;
-    std::vector<Event*> getEvents() const;
-};
-
-#endif // CLUB_H
+#ifndef CLUB_H
+#define CLUB_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "Member.h"
+#include "Coach.h"
+#include "Team.h"
+#include "Event.h"
+#include "Calendar.h"
+#include "Pool.h"
+#include "Roster.h"
+#include "Graph.h"
+#include "Attendance.h"
+#include "QueryCache.h"
+#include "NameSearch.h"
+#include "TextSearch.h"
+#include "Scan.h"
+#include "EntityStore.h"
+#include "MemberStore.h"
+#include <memory>
+#include <unordered_map>
+
+// Summary of what a coach is responsible for
+struct CoachWorkload {
+    std::vector<Team*> teams;
+    size_t total_athletes;              // distinct members across the coach's teams
+    std::vector<Event*> upcoming_events;  // distinct events of those teams starting on or after the given date
+};
+
+// Approximate heap memory held by one part of the club
+struct MemoryUsage {
+    std::string part;  // table, index or roster group, e.g. "members.by_id"
+    size_t entries;
+    size_t bytes;
+};
+
+// Memory held by every table, index and roster of the club
+struct MemoryReport {
+    std::vector<MemoryUsage> parts;
+    size_t total_bytes;
+};
+
+class Club {
+private:
+    // Key of the events by name and date: the name, a zero byte and the day number
+    // Events report every change of date to their club, which re-keys them (see changeEvent)
+    struct NameDateOf {
+        std::string operator()(const Event* event) const { return key(event->getName(), event->getCalendarDate()); }
+        static std::string key(const std::string& name, Date date);
+    };
+
+    // Each table carries only the indexes the club looks it up by
+    using MemberTable = EntityStore<Member, UniqueByValue<Member>, FirstByKey<Member, IdOf>, FirstByKey<Member, NameOf>>;
+    using CoachTable = EntityStore<Coach, UniqueByValue<Coach>, FirstByKey<Coach, IdOf>, FirstByKey<Coach, NameOf>>;
+    using TeamTable = EntityStore<Team, AllowDuplicates<Team>>;
+    using EventsByName = AllByKey<Event, NameOf>;
+    using EventsByNameDate = AllByKey<Event, NameDateOf>;
+    using EventTable = EntityStore<Event, AllowDuplicates<Event>, OrderedByKey<Event, StartStampOf>, EventsByName, EventsByNameDate>;
+
+    std::string name;
+    MemberTable members;
+    CoachTable coaches;
+    TeamTable teams;
+    EventTable events;
+    VenueCalendar calendar;
+    std::unique_ptr<CoParticipationGraph> graph;      // built on demand, then kept in sync
+    AttendanceStore attendance;                       // kept after events are cancelled
+    std::unique_ptr<QueryCache> query_cache;          // optional, see enableQueryCache
+    std::uint64_t member_version;                     // bumped when the member list changes
+    std::uint64_t event_version;                      // bumped when events or their participants change
+    FuzzyNameIndex<Member> member_names;
+    std::uint64_t details_version;                    // bumped when a member of the club is renamed
+    FuzzyNameIndex<Coach> coach_names;
+    TextSearchIndex<Event> event_text;  // name and location
+    TextSearchIndex<Team> team_text;    // sport type
+    TextSearchIndex<Coach> coach_text;  // specialty and name
+    ScanIndex<Member> member_scan;          // by id and name
+    ScanIndex<Coach> coach_scan;            // by id and name
+    ScanIndex<Team> team_scan;              // by id
+    ScanIndex<Event> event_scan;            // by date and name
+
+    // Optional disk-backed registry behind the member lookups, see openMemberStore
+    std::unique_ptr<MemberStore> member_store;
+    mutable std::unordered_map<int, Member*> loaded_members;  // stored members brought into memory by lookups
+
+    // Storage for entities built in place by the emplace* methods, and for loaded members
+    mutable EntityPool<Member> member_pool;
+    EntityPool<Coach> coach_pool;
+    EntityPool<Team> team_pool;
+    EntityPool<Event> event_pool;
+
+    // Club-built entities removed from the club, destroyed by the next compact()
+    std::vector<Member*> retired_members;
+    std::vector<Coach*> retired_coaches;
+    std::vector<Event*> retired_events;
+    size_t compact_threshold;      // removals that trigger shrinkToFit(), 0 for never
+    size_t removals_since_compact;
+
+    void destroyTeam(Team* team);
+    void trackJoined(const Event& event, const std::vector<int>& before);
+    void unindexEvent(Event* event);
+    void indexEvent(Event* event);
+    void replaceEvent(Event* event, const Event& other);
+
+    // Apply a change to an event's date, venue or name, re-indexing it around the change
+    // The change may throw; the event is re-indexed under whatever state it is left in
+    template <typename Change>
+    void changeEvent(Event* event, Change&& change) {
+        unindexEvent(event);
+        try {
+            events.modify(event, std::forward<Change>(change));
+        }
+        catch (...) {
+            indexEvent(event);
+            throw;
+        }
+        indexEvent(event);
+    }
+
+    friend class Event;
+    friend class Member;
+    friend class Coach;
+    std::vector<Rejection> signUp(Event* event, const std::vector<Member*>& newMembers);
+    std::vector<Rejection> attachTeam(Event* event, Team* team);
+    void noteRemoval(size_t count = 1);
+    void shrinkToFit();
+    Member* loadMember(const MemberRecord& record) const;
+    bool holdsMember(const Member* member) const;
+    bool unloadMember(const Member* member);
+    void assignMember(Member* member, const Member& other);
+    void assignCoach(Coach* coach, const Coach& other);
+
+    // Turn an emplace argument into the std::string the constructor sinks, without extra copies
+    static std::string&& ownedString(std::string&& value) { return std::move(value); }
+    static std::string ownedString(const std::string& value) { return value; }
+    static std::string ownedString(std::string_view value) { return std::string(value); }
+    static std::string ownedString(const char* value) { return std::string(value); }
+    // Anything else, such as a parsed Date or minutes of the day, passes through unchanged
+    template <typename T>
+    static T&& ownedString(T&& value) { return std::forward<T>(value); }
+
+public:
+    explicit Club(const std::string& name);
+
+    ~Club();
+
+    void addMember(Member* member);
+    void removeMember(Member* member);
+    size_t removeMembers(const std::vector<Member*>& doomed);
+    void addCoach(Coach* coach);
+    void removeCoach(Coach* coach, Coach* replacement = nullptr);
+    void addTeam(Team* team);
+    void removeTeam(Team* team);
+    size_t removeTeams(const std::vector<Team*>& doomed);
+    void mergeTeams(Team* into, Team* from);
+    Team* splitTeam(Team* team, const std::function<bool(const Member*)>& predicate, int new_id);
+    void organizeEvent(Event* event);
+    void cancelEvent(Event* event);
+    void rescheduleEvent(Event* event, const std::string& new_date, const std::string& start_time, const std::string& end_time);
+    void rescheduleEvent(Event* event, Date new_date, int start_minute, int end_minute);
+    std::vector<Rejection> addMembersToEvent(const std::string& eventName, const std::vector<Member*>& newMembers);
+    std::vector<Rejection> addMembersToEvent(const std::string& eventName, const std::string& date, const std::vector<Member*>& newMembers);
+    std::vector<Rejection> addMembersToEvent(Event* event, const std::vector<Member*>& newMembers);
+    std::vector<Rejection> addTeamToEvent(const std::string& eventName, Team* team);
+    std::vector<Rejection> addTeamToEvent(const std::string& eventName, const std::string& date, Team* team);
+    std::vector<Rejection> addTeamToEvent(Event* event, Team* team);  
+
+
+    Member* findMemberByName(const std::string& name) const;
+    std::vector<Member*> findMembersByRole(const std::string& role) const;
+    size_t getParticipantCount(const std::string& eventName) const;
+    Coach* findCoachByName(const std::string& name) const;
+    std::vector<FuzzyMatch<Member>> searchMembersByName(const std::string& query, int max_distance = 2, size_t limit = 10) const;
+    std::vector<FuzzyMatch<Coach>> searchCoachesByName(const std::string& query, int max_distance = 2, size_t limit = 10) const;
+    void updateMemberDetails(Member* member, const std::string& new_name, int new_age);
+    std::vector<TextMatch<Event>> searchEvents(const std::string& query, size_t limit = 10, bool match_all = false) const;
+    std::vector<TextMatch<Team>> searchTeams(const std::string& query, size_t limit = 10, bool match_all = false) const;
+    std::vector<TextMatch<Coach>> searchCoaches(const std::string& query, size_t limit = 10, bool match_all = false) const;
+    void updateCoachSpecialty(const std::string& name, const std::string& new_specialty);
+    void updateCoachSpecialty(Coach* coach, const std::string& new_specialty);
+    CoachWorkload getCoachWorkload(const Coach* coach, const std::string& from_date) const;
+    bool hasScheduleConflict(const std::string& date) const;
+    bool hasScheduleConflict(const std::string& location, const std::string& date,
+                             const std::string& start_time, const std::string& end_time) const;
+    std::vector<TimeSlot> findFreeSlots(const std::string& location, const std::string& from_date, int days,
+                                        int min_minutes = 60) const;
+
+    Member* findMemberById(int id) const;
+    Coach* findCoachById(int id) const;
+    std::vector<Event*> findEventsByName(const std::string& eventName) const;
+    Event* findEvent(const std::string& eventName, const std::string& date) const;
+    void findPersonById(int id) const;
+
+    std::string getClubInfo() const;
+    std::vector<Member*> getMembers() const;
+    std::vector<Coach*> getCoaches() const;
+    std::vector<Team*> getTeams() const;
+    std::vector<Event*> getEvents() const;
+    std::vector<Event*> getEventsSortedByDate() const;
+    std::vector<Event*> getEventsBetween(const std::string& from_date, const std::string& to_date) const;
+
+    ScanPage<Member> scanMembers(const ScanCursor& cursor, size_t limit, ScanOrder order = ScanOrder::Id) const;
+    ScanPage<Coach> scanCoaches(const ScanCursor& cursor, size_t limit, ScanOrder order = ScanOrder::Id) const;
+    ScanPage<Team> scanTeams(const ScanCursor& cursor, size_t limit, ScanOrder order = ScanOrder::Id) const;
+    ScanPage<Event> scanEvents(const ScanCursor& cursor, size_t limit, ScanOrder order = ScanOrder::Date) const;
+    ScanPage<Member> scanEventParticipants(const Event* event, const ScanCursor& cursor, size_t limit) const;
+
+    RosterBitmap rosterOf(const Team* team) const;
+    RosterBitmap rosterOf(const Event* event) const;
+    RosterBitmap rosterOfEventsBetween(const std::string& from_date, const std::string& to_date) const;
+    RosterBitmap rosterOfClub() const;
+    std::vector<Member*> membersIn(const RosterBitmap& roster) const;
+
+    CoParticipationGraph& enableCoParticipationGraph(size_t threads = 0);
+    CoParticipationGraph* getCoParticipationGraph() const;
+
+    void enableQueryCache(size_t capacity_bytes = 1 << 20);
+    void disableQueryCache();
+    QueryCacheStats getQueryCacheStats() const;
+
+    size_t recordAttendance(const Event* event);
+    const AttendanceStore& getAttendance() const;
+
+    MemoryReport getMemoryReport() const;
+    void compact();
+    void setCompactThreshold(size_t removals);
+    void reserveMembers(size_t additional);
+
+    MemberStore& openMemberStore(const std::string& path, size_t cache_pages = 1024);
+    MemberStore* getMemberStore() const;
+    size_t unloadMembers();
+
+    // Build entities directly in club-owned storage and register them with the same
+    // validation as the add* methods; the returned pointer stays valid while the club lives
+    template <typename Name, typename Role>
+    Member* emplaceMember(Name&& name, int age, Role&& role, int id) {
+        return adoptMember(member_pool.create(ownedString(std::forward<Name>(name)), age,
+                                              ownedString(std::forward<Role>(role)), id));
+    }
+
+    template <typename Name, typename Specialty>
+    Coach* emplaceCoach(Name&& name, Specialty&& specialty, int id) {
+        return adoptCoach(coach_pool.create(ownedString(std::forward<Name>(name)),
+                                            ownedString(std::forward<Specialty>(specialty)), id));
+    }
+
+    template <typename SportType>
+    Team* emplaceTeam(SportType&& sport_type, Coach* coach, int id) {
+        return adoptTeam(team_pool.create(ownedString(std::forward<SportType>(sport_type)), coach, id));
+    }
+
+    template <typename... Args>
+    Event* emplaceEvent(Args&&... args) {
+        return adoptEvent(event_pool.create(ownedString(std::forward<Args>(args))...));
+    }
+
+private:
+    Member* adoptMember(Member* member);
+    Coach* adoptCoach(Coach* coach);
+    Team* adoptTeam(Team* team);
+    Event* adoptEvent(Event* event);
+};
+
+#endif // CLUB_H
@@ -0,0 +1,683 @@
+#include "ClubArchive.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Compress.h"
+
+namespace {
+    const char MAGIC[8] = { 'C', 'L', 'U', 'B', 'A', 'R', 'C', '1' };
+    const std::uint8_t END_OF_ARCHIVE = 0;
+    const std::uint8_t MEMBER_TABLE = 1;
+    const std::uint8_t COACH_TABLE = 2;
+    const std::uint8_t TEAM_TABLE = 3;
+    const std::uint8_t EVENT_TABLE = 4;
+    const std::uint8_t COMPRESSED = 1;
+    const size_t TABLES = 4;
+    const size_t BLOCK_HEADER = 14;            // u8 table, u8 flags, u32 rows, u32 raw bytes, u32 stored bytes
+    const std::uint32_t MAX_BLOCK_BYTES = 1u << 30;
+
+    std::uint64_t zigzag(std::int64_t value) {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    std::int64_t unzigzag(std::uint64_t code) {
+        return static_cast<std::int64_t>(code >> 1) ^ -static_cast<std::int64_t>(code & 1);
+    }
+
+    // Packed words are little-endian whatever the host
+    std::uint64_t loadWord(const char* at) {
+        std::uint64_t value;
+        std::memcpy(&value, at, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        value = __builtin_bswap64(value);
+#endif
+        return value;
+    }
+
+    void storeWord(char* at, std::uint64_t value) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        value = __builtin_bswap64(value);
+#endif
+        std::memcpy(at, &value, sizeof(value));
+    }
+
+    void putFixed(std::string& out, std::uint64_t value, size_t bytes) {
+        for (size_t i = 0; i < bytes; ++i) {
+            out.push_back(static_cast<char>(value >> (8 * i)));
+        }
+    }
+
+    std::uint64_t getFixed(const char* at, size_t bytes) {
+        std::uint64_t value = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(at[i])) << (8 * i);
+        }
+        return value;
+    }
+
+    // Appends the columns of one block
+    class ColumnWriter {
+    private:
+        std::string& out;
+
+    public:
+        explicit ColumnWriter(std::string& out) : out(out) {}
+
+        void varint(std::uint64_t value) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<char>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<char>(value));
+        }
+
+        // A width byte, then every code in that many bits, in 64-bit words
+        void pack(const std::vector<std::uint64_t>& codes) {
+            std::uint64_t all = 0;
+            for (auto code : codes) {
+                all |= code;
+            }
+            int width = 0;
+            while (width < 64 && (all >> width) != 0) {
+                ++width;
+            }
+            out.push_back(static_cast<char>(width));
+            if (width == 0) {
+                return;
+            }
+            const size_t start = out.size();
+            out.resize(start + (codes.size() * width + 63) / 64 * 8);
+            char* at = &out[start];
+            std::uint64_t word = 0;
+            int filled = 0;
+            for (auto code : codes) {
+                word |= code << filled;
+                filled += width;
+                if (filled >= 64) {
+                    storeWord(at, word);
+                    at += 8;
+                    filled -= 64;
+                    word = filled == 0 ? 0 : code >> (width - filled);
+                }
+            }
+            if (filled > 0) {
+                storeWord(at, word);
+            }
+        }
+
+        // Integers as a base and bit-packed codes: deltas from the previous value, or offsets
+        // from the smallest value
+        void ints(const std::vector<std::int64_t>& values, bool delta) {
+            std::vector<std::uint64_t> codes(values.size());
+            std::int64_t base = 0;
+            if (!values.empty()) {
+                if (delta) {
+                    base = values[0];
+                    std::int64_t previous = base;
+                    for (size_t i = 0; i < values.size(); ++i) {
+                        codes[i] = zigzag(values[i] - previous);
+                        previous = values[i];
+                    }
+                }
+                else {
+                    base = *std::min_element(values.begin(), values.end());
+                    for (size_t i = 0; i < values.size(); ++i) {
+                        codes[i] = static_cast<std::uint64_t>(values[i]) - static_cast<std::uint64_t>(base);
+                    }
+                }
+            }
+            varint(zigzag(base));
+            pack(codes);
+        }
+
+        // Strings as their lengths, then all their bytes
+        void strings(const std::vector<std::string>& values) {
+            std::vector<std::int64_t> lengths(values.size());
+            size_t total = 0;
+            for (size_t i = 0; i < values.size(); ++i) {
+                lengths[i] = static_cast<std::int64_t>(values[i].size());
+                total += values[i].size();
+            }
+            ints(lengths, false);
+            out.reserve(out.size() + total);
+            for (const auto& value : values) {
+                out.append(value);
+            }
+        }
+
+        // Strings as a dictionary of the distinct ones, in first-seen order, and a code per row
+        void dictionary(const std::vector<std::string>& values) {
+            std::unordered_map<std::string_view, std::int64_t> code_of;
+            std::vector<std::string> entries;
+            std::vector<std::int64_t> codes(values.size());
+            for (size_t i = 0; i < values.size(); ++i) {
+                auto found = code_of.emplace(values[i], static_cast<std::int64_t>(entries.size()));
+                if (found.second) {
+                    entries.push_back(values[i]);
+                }
+                codes[i] = found.first->second;
+            }
+            varint(entries.size());
+            strings(entries);
+            ints(codes, false);
+        }
+
+        // Lists as a count per row, then every element, delta-encoded across the block
+        void lists(const std::vector<std::int64_t>& counts, const std::vector<std::int64_t>& elements) {
+            ints(counts, false);
+            ints(elements, true);
+        }
+    };
+
+    // Reads the columns of one block
+    // Every read throws an exception if the block ends early or holds impossible values
+    class ColumnReader {
+    private:
+        const char* data;
+        size_t size;
+        size_t at;
+
+        void need(size_t bytes) const {
+            if (size - at < bytes) {
+                throw std::invalid_argument("Archive is corrupt");
+            }
+        }
+
+    public:
+        ColumnReader(const char* data, size_t size) : data(data), size(size), at(0) {}
+
+        std::uint64_t varint() {
+            std::uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                need(1);
+                const std::uint8_t byte = static_cast<std::uint8_t>(data[at++]);
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) {
+                    return value;
+                }
+            }
+            throw std::invalid_argument("Archive is corrupt");
+        }
+
+        void unpack(size_t count, std::vector<std::uint64_t>& codes) {
+            need(1);
+            const unsigned width = static_cast<std::uint8_t>(data[at++]);
+            if (width > 64) {
+                throw std::invalid_argument("Archive is corrupt");
+            }
+            codes.assign(count, 0);
+            if (width == 0) {
+                return;
+            }
+            const size_t words = (count * width + 63) / 64;
+            need(words * 8);
+            const char* packed = data + at;
+            at += words * 8;
+            const std::uint64_t mask = width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << width) - 1;
+            size_t bit = 0;
+            for (size_t i = 0; i < count; ++i, bit += width) {
+                const size_t word = bit >> 6;
+                const unsigned shift = bit & 63;
+                std::uint64_t value = loadWord(packed + word * 8) >> shift;
+                if (shift + width > 64) {
+                    value |= loadWord(packed + (word + 1) * 8) << (64 - shift);
+                }
+                codes[i] = value & mask;
+            }
+        }
+
+        void ints(size_t count, std::vector<std::int64_t>& values, bool delta) {
+            const std::int64_t base = unzigzag(varint());
+            std::vector<std::uint64_t> codes;
+            unpack(count, codes);
+            values.resize(count);
+            std::uint64_t previous = static_cast<std::uint64_t>(base);
+            for (size_t i = 0; i < count; ++i) {
+                if (delta) {
+                    previous += static_cast<std::uint64_t>(unzigzag(codes[i]));
+                    values[i] = static_cast<std::int64_t>(previous);
+                }
+                else {
+                    values[i] = static_cast<std::int64_t>(static_cast<std::uint64_t>(base) + codes[i]);
+                }
+            }
+        }
+
+        void strings(size_t count, std::vector<std::string>& values) {
+            std::vector<std::int64_t> lengths;
+            ints(count, lengths, false);
+            values.resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                if (lengths[i] < 0) {
+                    throw std::invalid_argument("Archive is corrupt");
+                }
+                need(static_cast<size_t>(lengths[i]));
+                values[i].assign(data + at, static_cast<size_t>(lengths[i]));
+                at += static_cast<size_t>(lengths[i]);
+            }
+        }
+
+        // Read a dictionary column; codes index into entries
+        void dictionary(size_t count, std::vector<std::string>& entries, std::vector<std::int64_t>& codes) {
+            const std::uint64_t distinct = varint();
+            if (distinct > size) {
+                throw std::invalid_argument("Archive is corrupt");
+            }
+            strings(static_cast<size_t>(distinct), entries);
+            ints(count, codes, false);
+            for (auto code : codes) {
+                if (code < 0 || static_cast<std::uint64_t>(code) >= distinct) {
+                    throw std::invalid_argument("Archive is corrupt");
+                }
+            }
+        }
+
+        void lists(size_t count, std::vector<std::int64_t>& counts, std::vector<std::int64_t>& elements) {
+            ints(count, counts, false);
+            std::uint64_t total = 0;
+            for (auto length : counts) {
+                if (length < 0 || length > static_cast<std::int64_t>(MAX_BLOCK_BYTES)) {
+                    throw std::invalid_argument("Archive is corrupt");
+                }
+                total += static_cast<std::uint64_t>(length);
+            }
+            if (total > MAX_BLOCK_BYTES) {
+                throw std::invalid_argument("Archive is corrupt");
+            }
+            ints(static_cast<size_t>(total), elements, true);
+        }
+
+        bool atEnd() const {
+            return at == size;
+        }
+    };
+
+    // Row numbers of the entities of one table, in export order
+    template <typename T>
+    struct Numbering {
+        std::vector<T*> items;
+        std::unordered_map<const T*, std::int64_t> number;
+
+        void add(T* item) {
+            if (item != nullptr && number.emplace(item, static_cast<std::int64_t>(items.size())).second) {
+                items.push_back(item);
+            }
+        }
+
+        std::int64_t of(const T* item) const {
+            return number.at(item);
+        }
+    };
+
+    // Look up a row number read from an archive
+    // Throws an exception if the row does not exist
+    template <typename T>
+    T* rowOf(const std::vector<T*>& rows, std::int64_t row) {
+        if (row < 0 || static_cast<std::uint64_t>(row) >= rows.size()) {
+            throw std::invalid_argument("Archive is corrupt");
+        }
+        return rows[static_cast<size_t>(row)];
+    }
+
+    void readExact(std::istream& in, char* buffer, size_t size) {
+        if (!in.read(buffer, static_cast<std::streamsize>(size))) {
+            throw std::invalid_argument("Archive is truncated");
+        }
+    }
+}
+
+// Write the club to a stream as a columnar archive
+// Throws an exception if the block size is zero or the stream fails
+ArchiveStats exportClub(const Club& club, std::ostream& out, const ArchiveOptions& options) {
+    if (options.block_rows == 0) {
+        throw std::invalid_argument("Block size must be positive");
+    }
+
+    // Number every entity, taking in those reachable only through a roster
+    const std::vector<Event*> events = club.getEvents();
+    Numbering<Team> teams;
+    for (auto team : club.getTeams()) {
+        teams.add(team);
+    }
+    for (auto event : events) {
+        for (auto team : event->getTeams()) {
+            teams.add(team);
+        }
+    }
+    Numbering<Member> members;
+    for (auto member : club.getMembers()) {
+        members.add(member);
+    }
+    for (auto team : teams.items) {
+        for (auto member : team->getMembers()) {
+            members.add(member);
+        }
+    }
+    for (auto event : events) {
+        for (auto member : event->getParticipants()) {
+            members.add(member);
+        }
+    }
+    Numbering<Coach> coaches;
+    for (auto coach : club.getCoaches()) {
+        coaches.add(coach);
+    }
+    for (auto team : teams.items) {
+        coaches.add(team->getCoach());
+    }
+
+    ArchiveStats stats{ members.items.size(), coaches.items.size(), teams.items.size(), events.size(), 0, 0 };
+    std::string header(MAGIC, sizeof(MAGIC));
+    putFixed(header, stats.members, 8);
+    putFixed(header, stats.coaches, 8);
+    putFixed(header, stats.teams, 8);
+    putFixed(header, stats.events, 8);
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+    stats.archive_bytes += header.size();
+
+    std::string raw;
+    std::string block;
+    auto writeBlock = [&](std::uint8_t table, size_t rows) {
+        std::string packed;
+        std::uint8_t flags = 0;
+        if (options.compress) {
+            packed = compressBlock(raw.data(), raw.size());
+            flags = packed.size() < raw.size() ? COMPRESSED : 0;
+        }
+        const std::string& stored = flags == COMPRESSED ? packed : raw;
+        block.clear();
+        putFixed(block, table, 1);
+        putFixed(block, flags, 1);
+        putFixed(block, rows, 4);
+        putFixed(block, raw.size(), 4);
+        putFixed(block, stored.size(), 4);
+        out.write(block.data(), static_cast<std::streamsize>(block.size()));
+        out.write(stored.data(), static_cast<std::streamsize>(stored.size()));
+        stats.encoded_bytes += raw.size();
+        stats.archive_bytes += block.size() + stored.size();
+    };
+
+    for (size_t from = 0; from < members.items.size(); from += options.block_rows) {
+        const size_t to = std::min(members.items.size(), from + options.block_rows);
+        std::vector<std::int64_t> ids;
+        std::vector<std::int64_t> ages;
+        std::vector<std::string> roles;
+        std::vector<std::string> names;
+        for (size_t i = from; i < to; ++i) {
+            const Member* member = members.items[i];
+            ids.push_back(member->getId());
+            ages.push_back(member->getAge());
+            roles.push_back(member->getRole());
+            names.push_back(member->getName());
+        }
+        raw.clear();
+        ColumnWriter columns(raw);
+        columns.ints(ids, true);
+        columns.ints(ages, false);
+        columns.dictionary(roles);
+        columns.strings(names);
+        writeBlock(MEMBER_TABLE, to - from);
+    }
+
+    for (size_t from = 0; from < coaches.items.size(); from += options.block_rows) {
+        const size_t to = std::min(coaches.items.size(), from + options.block_rows);
+        std::vector<std::int64_t> ids;
+        std::vector<std::string> specialties;
+        std::vector<std::string> names;
+        for (size_t i = from; i < to; ++i) {
+            const Coach* coach = coaches.items[i];
+            ids.push_back(coach->getId());
+            specialties.push_back(coach->getSpecialty());
+            names.push_back(coach->getName());
+        }
+        raw.clear();
+        ColumnWriter columns(raw);
+        columns.ints(ids, true);
+        columns.dictionary(specialties);
+        columns.strings(names);
+        writeBlock(COACH_TABLE, to - from);
+    }
+
+    for (size_t from = 0; from < teams.items.size(); from += options.block_rows) {
+        const size_t to = std::min(teams.items.size(), from + options.block_rows);
+        std::vector<std::int64_t> ids;
+        std::vector<std::string> sports;
+        std::vector<std::int64_t> coach_rows;  // row + 1, 0 for no coach
+        std::vector<std::int64_t> roster_sizes;
+        std::vector<std::int64_t> roster_rows;
+        for (size_t i = from; i < to; ++i) {
+            const Team* team = teams.items[i];
+            ids.push_back(team->getId());
+            sports.push_back(team->getSportType());
+            coach_rows.push_back(team->getCoach() == nullptr ? 0 : coaches.of(team->getCoach()) + 1);
+            const std::vector<Member*> roster = team->getMembers();
+            roster_sizes.push_back(static_cast<std::int64_t>(roster.size()));
+            for (auto member : roster) {
+                roster_rows.push_back(members.of(member));
+            }
+        }
+        raw.clear();
+        ColumnWriter columns(raw);
+        columns.ints(ids, true);
+        columns.dictionary(sports);
+        columns.ints(coach_rows, false);
+        columns.lists(roster_sizes, roster_rows);
+        writeBlock(TEAM_TABLE, to - from);
+    }
+
+    for (size_t from = 0; from < events.size(); from += options.block_rows) {
+        const size_t to = std::min(events.size(), from + options.block_rows);
+        std::vector<std::int64_t> days;
+        std::vector<std::int64_t> starts;
+        std::vector<std::int64_t> ends;
+        std::vector<std::string> locations;
+        std::vector<std::string> names;
+        std::vector<std::int64_t> participant_counts;
+        std::vector<std::int64_t> participant_rows;
+        std::vector<std::int64_t> team_counts;
+        std::vector<std::int64_t> team_rows;
+        for (size_t i = from; i < to; ++i) {
+            const Event* event = events[i];
+            days.push_back(event->getCalendarDate().getDayNumber());
+            starts.push_back(event->getStartMinute());
+            ends.push_back(event->getEndMinute());
+            locations.push_back(event->getLocation());
+            names.push_back(event->getName());
+            const std::vector<Member*> participants = event->getParticipants();
+            participant_counts.push_back(static_cast<std::int64_t>(participants.size()));
+            for (auto member : participants) {
+                participant_rows.push_back(members.of(member));
+            }
+            const std::vector<Team*> attached = event->getTeams();
+            team_counts.push_back(static_cast<std::int64_t>(attached.size()));
+            for (auto team : attached) {
+                team_rows.push_back(teams.of(team));
+            }
+        }
+        raw.clear();
+        ColumnWriter columns(raw);
+        columns.ints(days, true);
+        columns.ints(starts, false);
+        columns.ints(ends, false);
+        columns.dictionary(locations);
+        columns.dictionary(names);
+        columns.lists(participant_counts, participant_rows);
+        columns.lists(team_counts, team_rows);
+        writeBlock(EVENT_TABLE, to - from);
+    }
+
+    out.put(static_cast<char>(END_OF_ARCHIVE));
+    stats.archive_bytes += 1;
+    if (!out) {
+        throw std::runtime_error("Archive could not be written");
+    }
+    return stats;
+}
+
+// Add everything in an archive to the club, through the same validation as the emplace*
+// methods; the club may already hold entities of its own
+// Each event gets its participants back in their original order before its teams are
+// re-attached, so a team member who had left an event joins it again.
+// Throws an exception if the archive is truncated or corrupt, or an entity is rejected;
+// what was imported before the failure stays in the club
+ArchiveStats importClub(Club& club, std::istream& in) {
+    char header[sizeof(MAGIC) + 8 * TABLES];
+    readExact(in, header, sizeof(header));
+    if (std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::invalid_argument("Stream is not a club archive");
+    }
+    std::uint64_t expected[TABLES];
+    for (size_t t = 0; t < TABLES; ++t) {
+        expected[t] = getFixed(header + sizeof(MAGIC) + 8 * t, 8);
+    }
+    club.reserveMembers(static_cast<size_t>(std::min<std::uint64_t>(expected[0], 1 << 24)));
+
+    std::vector<Member*> members;
+    std::vector<Coach*> coaches;
+    std::vector<Team*> teams;
+    size_t events = 0;
+    Coach unassigned("Unassigned", "None", 0);
+    members.reserve(static_cast<size_t>(std::min<std::uint64_t>(expected[0], 1 << 24)));
+    ArchiveStats stats{ 0, 0, 0, 0, 0, sizeof(header) };
+
+    std::uint8_t last_table = MEMBER_TABLE;
+    std::string stored;
+    std::string raw;
+    std::vector<std::int64_t> ints;
+    std::vector<std::int64_t> more_ints;
+    std::vector<std::int64_t> codes;
+    std::vector<std::int64_t> more_codes;
+    std::vector<std::int64_t> counts;
+    std::vector<std::int64_t> rows;
+    std::vector<std::int64_t> more_counts;
+    std::vector<std::int64_t> more_rows;
+    std::vector<std::string> entries;
+    std::vector<std::string> more_entries;
+    std::vector<std::string> names;
+    while (true) {
+        char block[BLOCK_HEADER];
+        readExact(in, block, 1);
+        const std::uint8_t table = static_cast<std::uint8_t>(block[0]);
+        if (table == END_OF_ARCHIVE) {
+            stats.archive_bytes += 1;
+            break;
+        }
+        readExact(in, block + 1, BLOCK_HEADER - 1);
+        const std::uint8_t flags = static_cast<std::uint8_t>(block[1]);
+        const size_t count = static_cast<size_t>(getFixed(block + 2, 4));
+        const std::uint32_t raw_size = static_cast<std::uint32_t>(getFixed(block + 6, 4));
+        const std::uint32_t stored_size = static_cast<std::uint32_t>(getFixed(block + 10, 4));
+        if (table < last_table || table > EVENT_TABLE || flags > COMPRESSED || raw_size > MAX_BLOCK_BYTES ||
+            stored_size > MAX_BLOCK_BYTES || (flags == 0 && stored_size != raw_size)) {
+            throw std::invalid_argument("Archive is corrupt");
+        }
+        last_table = table;
+        stored.resize(stored_size);
+        readExact(in, &stored[0], stored_size);
+        if (flags == COMPRESSED) {
+            raw.resize(raw_size);
+            decompressBlock(stored.data(), stored.size(), &raw[0], raw.size());
+        }
+        else {
+            raw.swap(stored);
+        }
+        stats.encoded_bytes += raw_size;
+        stats.archive_bytes += BLOCK_HEADER + stored_size;
+
+        ColumnReader columns(raw.data(), raw.size());
+        if (table == MEMBER_TABLE) {
+            columns.ints(count, ints, true);
+            columns.ints(count, more_ints, false);
+            columns.dictionary(count, entries, codes);
+            columns.strings(count, names);
+            if (!columns.atEnd()) {
+                throw std::invalid_argument("Archive is corrupt");
+            }
+            for (size_t i = 0; i < count; ++i) {
+                members.push_back(club.emplaceMember(std::move(names[i]), static_cast<int>(more_ints[i]),
+                                                     entries[static_cast<size_t>(codes[i])], static_cast<int>(ints[i])));
+            }
+        }
+        else if (table == COACH_TABLE) {
+            columns.ints(count, ints, true);
+            columns.dictionary(count, entries, codes);
+            columns.strings(count, names);
+            if (!columns.atEnd()) {
+                throw std::invalid_argument("Archive is corrupt");
+            }
+            for (size_t i = 0; i < count; ++i) {
+                coaches.push_back(club.emplaceCoach(std::move(names[i]), entries[static_cast<size_t>(codes[i])],
+                                                    static_cast<int>(ints[i])));
+            }
+        }
+        else if (table == TEAM_TABLE) {
+            columns.ints(count, ints, true);
+            columns.dictionary(count, entries, codes);
+            columns.ints(count, more_ints, false);
+            columns.lists(count, counts, rows);
+            if (!columns.atEnd()) {
+                throw std::invalid_argument("Archive is corrupt");
+            }
+            size_t next = 0;
+            for (size_t i = 0; i < count; ++i) {
+                // A team whose coach was removed is built under a stand-in coach, then released
+                Coach* coach = more_ints[i] == 0 ? &unassigned : rowOf(coaches, more_ints[i] - 1);
+                Team* team = club.emplaceTeam(entries[static_cast<size_t>(codes[i])], coach, static_cast<int>(ints[i]));
+                if (coach == &unassigned) {
+                    team->removeCoach();
+                }
+                teams.push_back(team);
+                for (std::int64_t k = 0; k < counts[i]; ++k) {
+                    team->addMember(rowOf(members, rows[next++]));
+                }
+            }
+        }
+        else {
+            std::vector<std::int64_t> ends;
+            columns.ints(count, ints, true);
+            columns.ints(count, more_ints, false);
+            columns.ints(count, ends, false);
+            columns.dictionary(count, entries, codes);
+            columns.dictionary(count, more_entries, more_codes);
+            columns.lists(count, counts, rows);
+            columns.lists(count, more_counts, more_rows);
+            if (!columns.atEnd()) {
+                throw std::invalid_argument("Archive is corrupt");
+            }
+            size_t next_member = 0;
+            size_t next_team = 0;
+            for (size_t i = 0; i < count; ++i) {
+                Event* event = club.emplaceEvent(Date(static_cast<std::int32_t>(ints[i])),
+                                                 entries[static_cast<size_t>(codes[i])],
+                                                 more_entries[static_cast<size_t>(more_codes[i])],
+                                                 static_cast<int>(more_ints[i]), static_cast<int>(ends[i]));
+                // Signed up through the club, so a co-participation graph sees the imports
+                std::vector<Member*> participants;
+                participants.reserve(static_cast<size_t>(counts[i]));
+                for (std::int64_t k = 0; k < counts[i]; ++k) {
+                    participants.push_back(rowOf(members, rows[next_member++]));
+                }
+                club.addMembersToEvent(event, participants);
+                for (std::int64_t k = 0; k < more_counts[i]; ++k) {
+                    club.addTeamToEvent(event, rowOf(teams, more_rows[next_team++]));
+                }
+                ++events;
+            }
+        }
+    }
+
+    stats.members = members.size();
+    stats.coaches = coaches.size();
+    stats.teams = teams.size();
+    stats.events = events;
+    if (stats.members != expected[0] || stats.coaches != expected[1] || stats.teams != expected[2] ||
+        stats.events != expected[3]) {
+        throw std::invalid_argument("Archive is truncated");
+    }
+    return stats;
+}
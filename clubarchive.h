@@ -0,0 +1,43 @@
+#ifndef CLUBARCHIVE_H
+#define CLUBARCHIVE_H
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include "Club.h"
+
+// Columnar export and import of a whole club
+// An archive is a header with the row count of each table, then blocks of up to
+// block_rows rows of one table at a time: members, coaches, teams, then events. Inside
+// a block every field is a column:
+// - ids and dates are delta-encoded, ages and times stored as offsets from the block
+//   minimum, and both are bit-packed at the width of the largest value;
+// - roles, specialties, sport types, locations and event names are dictionary-encoded;
+// - names are lengths plus the bytes;
+// - rosters, participants and event teams are per-row counts plus row numbers into the
+//   member and team tables, delta-encoded like ids.
+// Blocks are written and read one at a time, so streaming costs memory for one block.
+// Entities on a roster but not in the club are exported with the club's own, so every
+// reference resolves; attendance history, eligibility rules and the co-participation graph
+// are not exported.
+
+// Options of an export
+struct ArchiveOptions {
+    bool compress = true;       // compress each block with compressBlock when that makes it smaller
+    size_t block_rows = 16384;  // rows per block
+};
+
+// What an export wrote or an import read
+struct ArchiveStats {
+    size_t members;
+    size_t coaches;
+    size_t teams;
+    size_t events;
+    size_t encoded_bytes;  // column bytes before compression
+    size_t archive_bytes;  // bytes of the archive stream
+};
+
+ArchiveStats exportClub(const Club& club, std::ostream& out, const ArchiveOptions& options = {});
+ArchiveStats importClub(Club& club, std::istream& in);
+
+#endif // CLUBARCHIVE_H
@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "Client.h"
+#include "Server.h"
+#include "Workload.h"
+
+// Load-test client for ClubServer: pipelined member lookups over several connections
+// Build with the club sources, e.g. g++ -O2 -std=c++17 -pthread clubload.cpp client.cpp server.cpp workload.cpp club.cpp ... -o clubload.
+// ./clubload --socket /tmp/club.sock --members 100000 drives a running clubserver; without
+// --socket it hosts its own server on a populated club in a second thread, e.g.
+// ./clubload --members 100000 --connections 4 --depth 256 --requests 2000000
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    void usage() {
+        std::fprintf(stderr,
+                     "usage: clubload [--socket PATH] [--members N] [--connections N] [--depth N]\n"
+                     "                [--requests N] [--seed N]\n");
+        std::exit(2);
+    }
+
+    size_t count(const char* text) {
+        return static_cast<size_t>(std::stoull(text));
+    }
+
+    // Send requests in waves of depth lookups, reading a wave's answers before sending the next
+    // Returns the number of lookups that found a member
+    size_t drive(const std::string& path, size_t requests, size_t depth, size_t members, unsigned seed) {
+        ClubClient client(path);
+        size_t found = 0;
+        unsigned state = seed * 2654435761u + 1;
+        for (size_t done = 0; done < requests;) {
+            const size_t wave = std::min(depth, requests - done);
+            for (size_t i = 0; i < wave; ++i) {
+                state = state * 1664525u + 1013904223u;
+                client.findMemberById(static_cast<int>(state % members) + 1);
+            }
+            client.flush();
+            for (size_t i = 0; i < wave; ++i) {
+                found += client.receive().ok() ? 1 : 0;
+            }
+            done += wave;
+        }
+        return found;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string path;
+    size_t members = 100000;
+    size_t connections = 4;
+    size_t depth = 256;
+    size_t requests = 1000000;  // per connection
+    unsigned seed = 1;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string flag = argv[i];
+            if (i + 1 >= argc) {
+                usage();
+            }
+            const char* value = argv[++i];
+            if (flag == "--socket") {
+                path = value;
+            }
+            else if (flag == "--members") {
+                members = count(value);
+            }
+            else if (flag == "--connections") {
+                connections = count(value);
+            }
+            else if (flag == "--depth") {
+                depth = count(value);
+            }
+            else if (flag == "--requests") {
+                requests = count(value);
+            }
+            else if (flag == "--seed") {
+                seed = static_cast<unsigned>(count(value));
+            }
+            else {
+                usage();
+            }
+        }
+        if (members == 0 || connections == 0 || depth == 0) {
+            throw std::invalid_argument("--members, --connections and --depth must be positive");
+        }
+
+        // Without a socket, host a server here on its own thread
+        std::unique_ptr<Club> club;
+        std::unique_ptr<ClubServer> server;
+        std::thread serving;
+        if (path.empty()) {
+            WorkloadConfig config;
+            config.members = members;
+            club.reset(new Club("Load Club"));
+            WorkloadDriver::populate(*club, config);
+            path = "/tmp/clubload." + std::to_string(::getpid()) + ".sock";
+            server.reset(new ClubServer(*club, path));
+            serving = std::thread([&server]() { server->run(); });
+        }
+
+        std::vector<std::thread> threads;
+        std::vector<size_t> found(connections, 0);
+        std::vector<std::exception_ptr> errors(connections);
+        const auto start = Clock::now();
+        for (size_t c = 0; c < connections; ++c) {
+            threads.emplace_back([&, c]() {
+                try {
+                    found[c] = drive(path, requests, depth, members, seed + static_cast<unsigned>(c));
+                }
+                catch (...) {
+                    errors[c] = std::current_exception();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (server) {
+            server->stop();
+            serving.join();
+        }
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        size_t hits = 0;
+        for (auto value : found) {
+            hits += value;
+        }
+        const double total = static_cast<double>(requests * connections);
+        std::printf("%zu connections x %zu requests, depth %zu: %.3f s, %.0f requests/s, %.2f us per wave, %zu found\n",
+                    connections, requests, depth, seconds, total / seconds,
+                    seconds * 1e6 / (total / static_cast<double>(depth) / static_cast<double>(connections)), hits);
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "clubload: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include "Server.h"
+#include "Workload.h"
+
+// Hosts one synthetic club for local processes over a UNIX domain socket
+// Build with the club sources, e.g. g++ -O2 -std=c++17 -pthread clubserver.cpp server.cpp workload.cpp club.cpp ... -o clubserver,
+// and run as ./clubserver --socket /tmp/club.sock --members 100000; stop it with Ctrl-C.
+// The club is filled by WorkloadDriver::populate, so member ids run from 1 to --members.
+
+namespace {
+    ClubServer* running = nullptr;
+
+    void onSignal(int) {
+        if (running != nullptr) {
+            running->stop();
+        }
+    }
+
+    void usage() {
+        std::fprintf(stderr,
+                     "usage: clubserver [--socket PATH] [--members N] [--coaches N] [--teams N] [--events N]\n"
+                     "                  [--venues N] [--skew X] [--seed N]\n");
+        std::exit(2);
+    }
+
+    size_t count(const char* text) {
+        return static_cast<size_t>(std::stoull(text));
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string path = "/tmp/club.sock";
+    WorkloadConfig config;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string flag = argv[i];
+            if (i + 1 >= argc) {
+                usage();
+            }
+            const char* value = argv[++i];
+            if (flag == "--socket") {
+                path = value;
+            }
+            else if (flag == "--members") {
+                config.members = count(value);
+            }
+            else if (flag == "--coaches") {
+                config.coaches = count(value);
+            }
+            else if (flag == "--teams") {
+                config.teams = count(value);
+            }
+            else if (flag == "--events") {
+                config.events = count(value);
+            }
+            else if (flag == "--venues") {
+                config.venues = count(value);
+            }
+            else if (flag == "--skew") {
+                config.roster_skew = std::stod(value);
+            }
+            else if (flag == "--seed") {
+                config.seed = std::stoull(value);
+            }
+            else {
+                usage();
+            }
+        }
+
+        Club club("Served Club");
+        WorkloadDriver::populate(club, config);
+        ClubServer server(club, path);
+        running = &server;
+        std::signal(SIGINT, onSignal);
+        std::signal(SIGTERM, onSignal);
+        std::printf("serving %zu members on %s\n", config.members, path.c_str());
+        std::fflush(stdout);
+        server.run();
+        running = nullptr;
+
+        const ServerStats stats = server.getStats();
+        std::printf("%llu connections, %llu requests in %llu batches\n",
+                    static_cast<unsigned long long>(stats.connections), static_cast<unsigned long long>(stats.requests),
+                    static_cast<unsigned long long>(stats.batches));
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "clubserver: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
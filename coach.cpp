@@ -1,39 +1,112 @@
-#include "Coach.h"
-#include <stdexcept>
-
-// Constructor to initialize a Coach object with name, specialty, and ID
-// Throws an exception if specialty is empty or ID is negative
-Coach::Coach(const std::string& name, const std::string& specialty, int id)
-    : name(name), specialty(specialty), id(id) {
-    if (specialty.empty()) {
-        throw std::invalid_argument("Specialty cannot be empty");
-    }
-    if (id < 0) {
-        throw std::invalid_argument("Coach ID cannot be negative");
-    }
-}
-
-// Getter for the name of the coach
-std::string Coach::getName() const {
-    return name;
-}
-
-// Getter for the specialty of the coach
-std::string Coach::getSpecialty() const {
-    return specialty;
-}
-
-// Setter to update the specialty of the coach
-void Coach::setSpecialty(const std::string& new_specialty) {
-    specialty = new_specialty;
-}
-
-// Getter for the ID of the coach
-int Coach::getId() const {
-    return id;
-}
-
-// Equality operator to compare two coaches
-bool Coach::operator==(const Coach& other) const {
-    return name == other.name && specialty == other.specialty;
-}
+#include "Coach.h"
+#include <functional>
+#include <stdexcept>
+#include "Club.h"
+#include "Team.h"
+
+// Constructor to initialize a Coach object with name, specialty, and ID
+// The strings are taken by value and moved in, so rvalue arguments are never copied
+// Throws an exception if specialty is empty or ID is negative
+Coach::Coach(std::string name, std::string specialty, int id)
+    : name(std::move(name)), specialty(std::move(specialty)), id(id), owner(nullptr) {
+    if (this->specialty.empty()) {
+        throw std::invalid_argument("Specialty cannot be empty");
+    }
+    if (id < 0) {
+        throw std::invalid_argument("Coach ID cannot be negative");
+    }
+}
+
+// Copy constructor; the copy starts without any teams and belongs to no club
+Coach::Coach(const Coach& other)
+    : name(other.name), specialty(other.specialty), id(other.id), owner(nullptr) {}
+
+// Copy assignment; the coach keeps its own teams, and a coach held by a club stays in
+// it, re-indexed under the new details
+Coach& Coach::operator=(const Coach& other) {
+    if (this != &other) {
+        if (owner != nullptr) {
+            owner->assignCoach(this, other);
+        }
+        else {
+            assign(other);
+        }
+    }
+    return *this;
+}
+
+// Take over the name, specialty and ID of another coach without telling the owning club
+void Coach::assign(const Coach& other) {
+    name = other.name;
+    specialty = other.specialty;
+    id = other.id;
+}
+
+// Destructor to detach the coach from every team it still runs
+Coach::~Coach() {
+    for (auto team : teams) {
+        team->coach = nullptr;
+    }
+}
+
+// Getter for the name of the coach
+std::string Coach::getName() const {
+    return name;
+}
+
+// Getter for the specialty of the coach
+std::string Coach::getSpecialty() const {
+    return specialty;
+}
+
+// Setter to update the specialty of the coach
+// A coach held by a club is changed through the club, which re-indexes it
+void Coach::setSpecialty(const std::string& new_specialty) {
+    if (owner != nullptr) {
+        owner->updateCoachSpecialty(this, new_specialty);
+    }
+    else {
+        applySpecialty(new_specialty);
+    }
+}
+
+// Change the specialty without telling the owning club
+void Coach::applySpecialty(const std::string& new_specialty) {
+    specialty = new_specialty;
+}
+
+// Getter for the ID of the coach
+int Coach::getId() const {
+    return id;
+}
+
+// Getter for the teams the coach is assigned to
+std::vector<Team*> Coach::getTeams() const {
+    return teams;
+}
+
+// Get the number of teams the coach is assigned to
+size_t Coach::getTeamCount() const {
+    return teams.size();
+}
+
+// Get the approximate heap memory used by the team list in bytes
+size_t Coach::memoryUsage() const {
+    return teams.capacity() * sizeof(Team*);
+}
+
+// Release spare team list capacity
+void Coach::shrinkToFit() {
+    teams.shrink_to_fit();
+}
+
+// Equality operator to compare two coaches
+bool Coach::operator==(const Coach& other) const {
+    return name == other.name && specialty == other.specialty;
+}
+
+// Hash of the fields compared by operator==
+size_t Coach::identityHash() const {
+    const size_t seed = std::hash<std::string>()(name);
+    return seed ^ (std::hash<std::string>()(specialty) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
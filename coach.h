@@ -1,22 +1,42 @@
-#ifndef COACH_H
-#define COACH_H
-
-#include <string>
-
-class Coach {
-private:
-    std::string name;
-    std::string specialty;
-    int id;  
-
-public:
-    Coach(const std::string& name, const std::string& specialty, int id);
-
-    std::string getName() const;
-    std::string getSpecialty() const;
-    void setSpecialty(const std::string& new_specialty);
-    int getId() const;
-    bool operator==(const Coach& other) const;
-};
-
-#endif // COACH_H
+#ifndef COACH_H
+#define COACH_H
+
+#include <string>
+#include <vector>
+
+class Team;
+class Club;
+
+class Coach {
+private:
+    std::string name;
+    std::string specialty;
+    int id;  
+    std::vector<Team*> teams;  // reverse index maintained by Team
+    Club* owner;               // club whose indexes hold the coach, which every change of details goes through
+
+    friend class Team;
+    friend class Club;
+
+    void assign(const Coach& other);
+    void applySpecialty(const std::string& new_specialty);
+
+public:
+    Coach(std::string name, std::string specialty, int id);
+    Coach(const Coach& other);
+    Coach& operator=(const Coach& other);
+    ~Coach();
+
+    std::string getName() const;
+    std::string getSpecialty() const;
+    void setSpecialty(const std::string& new_specialty);
+    int getId() const;
+    std::vector<Team*> getTeams() const;
+    size_t getTeamCount() const;
+    size_t memoryUsage() const;
+    void shrinkToFit();
+    bool operator==(const Coach& other) const;
+    size_t identityHash() const;
+};
+
+#endif // COACH_H
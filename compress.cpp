@@ -0,0 +1,153 @@
+#include "Compress.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    const size_t MIN_MATCH = 4;
+    const size_t MAX_OFFSET = 0xFFFF;
+    const int HASH_BITS = 14;
+
+    std::uint32_t load32(const char* at) {
+        std::uint32_t value;
+        std::memcpy(&value, at, sizeof(value));
+        return value;
+    }
+
+    std::uint32_t hashOf(std::uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    // Lengths past a nibble continue in 255-bytes and a final smaller byte
+    void putLength(std::string& out, size_t rest) {
+        while (rest >= 255) {
+            out.push_back(static_cast<char>(255));
+            rest -= 255;
+        }
+        out.push_back(static_cast<char>(rest));
+    }
+
+    void putSequence(std::string& out, const char* literals, size_t literal_count, size_t offset, size_t match) {
+        const size_t match_code = match - MIN_MATCH;
+        const size_t token = (std::min<size_t>(literal_count, 15) << 4) | std::min<size_t>(match_code, 15);
+        out.push_back(static_cast<char>(token));
+        if (literal_count >= 15) {
+            putLength(out, literal_count - 15);
+        }
+        out.append(literals, literal_count);
+        out.push_back(static_cast<char>(offset));
+        out.push_back(static_cast<char>(offset >> 8));
+        if (match_code >= 15) {
+            putLength(out, match_code - 15);
+        }
+    }
+
+    struct Input {
+        const unsigned char* data;
+        size_t size;
+        size_t at;
+
+        unsigned char next() {
+            if (at == size) {
+                throw std::invalid_argument("Compressed block is truncated");
+            }
+            return data[at++];
+        }
+
+        size_t length(size_t nibble) {
+            size_t total = nibble;
+            if (nibble == 15) {
+                unsigned char more;
+                do {
+                    more = next();
+                    total += more;
+                } while (more == 255);
+            }
+            return total;
+        }
+    };
+}
+
+// Compress a block; incompressible input grows by about one byte in 255
+std::string compressBlock(const char* data, size_t size) {
+    std::string out;
+    out.reserve(size + size / 255 + 16);
+    std::vector<std::uint32_t> table(size_t(1) << HASH_BITS, 0);  // position + 1 of the last sequence per hash
+    size_t anchor = 0;
+    size_t i = 0;
+    while (i + MIN_MATCH <= size) {
+        const std::uint32_t sequence = load32(data + i);
+        const std::uint32_t hash = hashOf(sequence);
+        const size_t candidate = table[hash];
+        table[hash] = static_cast<std::uint32_t>(i + 1);
+        if (candidate == 0 || i + 1 - candidate > MAX_OFFSET || load32(data + candidate - 1) != sequence) {
+            // Step faster through data that keeps failing to match
+            i += 1 + ((i - anchor) >> 6);
+            continue;
+        }
+        const size_t from = candidate - 1;
+        size_t match = MIN_MATCH;
+        while (i + match < size && data[from + match] == data[i + match]) {
+            ++match;
+        }
+        putSequence(out, data + anchor, i - anchor, i - from, match);
+        i += match;
+        anchor = i;
+        if (i >= 2 && i + MIN_MATCH <= size) {
+            table[hashOf(load32(data + i - 2))] = static_cast<std::uint32_t>(i - 1);
+        }
+    }
+
+    // The last sequence is literals only; the decoder knows it by the end of the input
+    const size_t rest = size - anchor;
+    out.push_back(static_cast<char>(std::min<size_t>(rest, 15) << 4));
+    if (rest >= 15) {
+        putLength(out, rest - 15);
+    }
+    out.append(data + anchor, rest);
+    return out;
+}
+
+// Decompress a block into exactly out_size bytes
+// Throws an exception if the block is corrupt or decodes to a different size
+void decompressBlock(const char* data, size_t size, char* out, size_t out_size) {
+    Input in{ reinterpret_cast<const unsigned char*>(data), size, 0 };
+    size_t written = 0;
+    while (true) {
+        const unsigned char token = in.next();
+        const size_t literals = in.length(token >> 4);
+        if (literals > size - in.at || literals > out_size - written) {
+            throw std::invalid_argument("Compressed block is corrupt");
+        }
+        std::memcpy(out + written, data + in.at, literals);
+        in.at += literals;
+        written += literals;
+        if (in.at == size) {
+            break;
+        }
+
+        size_t offset = in.next();
+        offset |= static_cast<size_t>(in.next()) << 8;
+        const size_t match = in.length(token & 15) + MIN_MATCH;
+        if (offset == 0 || offset > written || match > out_size - written) {
+            throw std::invalid_argument("Compressed block is corrupt");
+        }
+        char* to = out + written;
+        const char* from = to - offset;
+        if (offset >= match) {
+            std::memcpy(to, from, match);
+        }
+        else {
+            // The match overlaps what it writes, so it repeats the last offset bytes
+            for (size_t k = 0; k < match; ++k) {
+                to[k] = from[k];
+            }
+        }
+        written += match;
+    }
+    if (written != out_size) {
+        throw std::invalid_argument("Compressed block is corrupt");
+    }
+}
@@ -0,0 +1,15 @@
+#ifndef COMPRESS_H
+#define COMPRESS_H
+
+#include <cstddef>
+#include <string>
+
+// Fast block compression for club archives
+// A byte-oriented LZ77 scheme in the spirit of LZ4: each sequence is a token byte with
+// the literal and match lengths, the literals, and a 16-bit offset back to the match.
+// It trades ratio for speed; blocks are compressed and decompressed independently.
+
+std::string compressBlock(const char* data, size_t size);
+void decompressBlock(const char* data, size_t size, char* out, size_t out_size);
+
+#endif // COMPRESS_H
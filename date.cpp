@@ -0,0 +1,189 @@
+#include "Date.h"
+#include <stdexcept>
+
+namespace {
+    bool isLeapYear(int year) {
+        return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    }
+
+    int daysInMonth(int year, int month) {
+        static const int days[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        return month == 2 && isLeapYear(year) ? 29 : days[month - 1];
+    }
+
+    // Read exactly count ASCII digits starting at pos, or return -1
+    int readDigits(std::string_view text, size_t pos, size_t count) {
+        if (pos + count > text.size()) {
+            return -1;
+        }
+        int value = 0;
+        for (size_t i = pos; i < pos + count; ++i) {
+            const unsigned digit = static_cast<unsigned>(text[i] - '0');
+            if (digit > 9) {
+                return -1;
+            }
+            value = value * 10 + static_cast<int>(digit);
+        }
+        return value;
+    }
+
+    void appendDigits(std::string& out, int value, int width) {
+        char buffer[8];
+        for (int i = width - 1; i >= 0; --i) {
+            buffer[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        out.append(buffer, static_cast<size_t>(width));
+    }
+}
+
+// Default constructor, 1970-01-01
+Date::Date() : day(0) {}
+
+// Constructor from a day number
+Date::Date(std::int32_t day_number) : day(day_number) {}
+
+// Build a date from year, month and day (days-from-civil, proleptic Gregorian)
+// Throws an exception if the day does not exist
+Date Date::fromCivil(int year, int month, int day) {
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+        throw std::invalid_argument("Date does not exist");
+    }
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const int yoe = year - era * 400;
+    const int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return Date(era * 146097 + doe - 719468);
+}
+
+// Parse a strict ISO-8601 calendar date, "YYYY-MM-DD"
+// Throws an exception if the text is malformed or the day does not exist
+Date Date::parse(std::string_view text) {
+    Date result;
+    if (!tryParse(text, result)) {
+        throw std::invalid_argument("Date must be a valid YYYY-MM-DD date");
+    }
+    return result;
+}
+
+// Parse a strict ISO-8601 calendar date without throwing
+bool Date::tryParse(std::string_view text, Date& result) {
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-') {
+        return false;
+    }
+    const int year = readDigits(text, 0, 4);
+    const int month = readDigits(text, 5, 2);
+    const int day = readDigits(text, 8, 2);
+    if (year < 0 || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+        return false;
+    }
+    result = fromCivil(year, month, day);
+    return true;
+}
+
+// Getter for the day number
+std::int32_t Date::getDayNumber() const {
+    return day;
+}
+
+// Split the date into year, month and day
+void Date::toCivil(int& year, int& month, int& day_of_month) const {
+    const int z = day + 719468;
+    const int era = (z >= 0 ? z : z - 146096) / 146097;
+    const int doe = z - era * 146097;
+    const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const int mp = (5 * doy + 2) / 153;
+    day_of_month = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = yoe + era * 400 + (month <= 2);
+}
+
+// Format the date as "YYYY-MM-DD"
+std::string Date::toString() const {
+    int year = 0, month = 0, day_of_month = 0;
+    toCivil(year, month, day_of_month);
+    std::string out;
+    out.reserve(10);
+    appendDigits(out, year, 4);
+    out.push_back('-');
+    appendDigits(out, month, 2);
+    out.push_back('-');
+    appendDigits(out, day_of_month, 2);
+    return out;
+}
+
+// Get the date a number of days later (or earlier, for negative values)
+Date Date::addDays(int days) const {
+    return Date(day + days);
+}
+
+// Default constructor, 1970-01-01 without a time
+DateTime::DateTime() : date(), minute(-1) {}
+
+// Constructor from a date and an optional minute of the day
+// Throws an exception if the minute is out of range
+DateTime::DateTime(Date date, int minute) : date(date), minute(static_cast<std::int16_t>(minute)) {
+    if (minute < -1 || minute > MINUTES_PER_DAY) {
+        throw std::invalid_argument("Minute of day is out of range");
+    }
+}
+
+// Parse "YYYY-MM-DD", "YYYY-MM-DDTHH:MM" or "YYYY-MM-DD HH:MM"
+// Throws an exception if the text is malformed
+DateTime DateTime::parse(std::string_view text) {
+    if (text.size() == 10) {
+        return DateTime(Date::parse(text));
+    }
+    if (text.size() != 16 || (text[10] != 'T' && text[10] != ' ')) {
+        throw std::invalid_argument("Date and time must be in YYYY-MM-DDTHH:MM format");
+    }
+    return DateTime(Date::parse(text.substr(0, 10)), parseTime(text.substr(11)));
+}
+
+// Parse "HH:MM" into minutes since midnight ("24:00" marks the end of the day)
+// Throws an exception if the time is malformed
+int DateTime::parseTime(std::string_view text) {
+    const int hours = text.size() == 5 && text[2] == ':' ? readDigits(text, 0, 2) : -1;
+    const int minutes = hours >= 0 ? readDigits(text, 3, 2) : -1;
+    if (hours < 0 || minutes < 0 || minutes > 59 || hours * 60 + minutes > MINUTES_PER_DAY) {
+        throw std::invalid_argument("Time must be in HH:MM format");
+    }
+    return hours * 60 + minutes;
+}
+
+// Format minutes since midnight as "HH:MM"
+std::string DateTime::formatTime(int minute) {
+    std::string out;
+    out.reserve(5);
+    appendDigits(out, minute / 60, 2);
+    out.push_back(':');
+    appendDigits(out, minute % 60, 2);
+    return out;
+}
+
+// Getter for the date part
+Date DateTime::getDate() const {
+    return date;
+}
+
+// Check whether a time of day was given
+bool DateTime::hasTime() const {
+    return minute >= 0;
+}
+
+// Getter for the minute of the day, 0 when no time was given
+int DateTime::getMinute() const {
+    return minute >= 0 ? minute : 0;
+}
+
+// Get minutes since 1970-01-01 00:00
+long long DateTime::toStamp() const {
+    return static_cast<long long>(date.getDayNumber()) * MINUTES_PER_DAY + getMinute();
+}
+
+// Format as "YYYY-MM-DD" or "YYYY-MM-DDTHH:MM"
+std::string DateTime::toString() const {
+    return hasTime() ? date.toString() + "T" + formatTime(minute) : date.toString();
+}
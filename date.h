@@ -0,0 +1,61 @@
+#ifndef DATE_H
+#define DATE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// A calendar day stored as a 32-bit day number (days since 1970-01-01)
+// Comparing, sorting and range-filtering dates is plain integer work.
+class Date {
+private:
+    std::int32_t day;
+
+public:
+    Date();
+    explicit Date(std::int32_t day_number);
+
+    static Date fromCivil(int year, int month, int day);
+    static Date parse(std::string_view text);
+    static bool tryParse(std::string_view text, Date& result);
+
+    std::int32_t getDayNumber() const;
+    std::string toString() const;
+    void toCivil(int& year, int& month, int& day) const;
+    Date addDays(int days) const;
+
+    bool operator==(const Date& other) const { return day == other.day; }
+    bool operator!=(const Date& other) const { return day != other.day; }
+    bool operator<(const Date& other) const { return day < other.day; }
+    bool operator<=(const Date& other) const { return day <= other.day; }
+    bool operator>(const Date& other) const { return day > other.day; }
+    bool operator>=(const Date& other) const { return day >= other.day; }
+};
+
+// A date with an optional minute of the day
+class DateTime {
+private:
+    Date date;
+    std::int16_t minute;  // minutes since midnight, or -1 when no time was given
+
+public:
+    static const int MINUTES_PER_DAY = 24 * 60;
+
+    DateTime();
+    explicit DateTime(Date date, int minute = -1);
+
+    static DateTime parse(std::string_view text);
+    static int parseTime(std::string_view text);
+    static std::string formatTime(int minute);
+
+    Date getDate() const;
+    bool hasTime() const;
+    int getMinute() const;
+    long long toStamp() const;  // minutes since 1970-01-01 00:00, midnight when no time was given
+    std::string toString() const;
+
+    bool operator==(const DateTime& other) const { return date == other.date && minute == other.minute; }
+    bool operator<(const DateTime& other) const { return toStamp() < other.toStamp(); }
+};
+
+#endif // DATE_H
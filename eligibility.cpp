@@ -0,0 +1,89 @@
+#include "Eligibility.h"
+#include <algorithm>
+#include <stdexcept>
+
+// Compile a set of rules
+// Throws an exception if the age range is empty or starts below zero
+EligibilityCheck::EligibilityCheck(EligibilityRules rules) : rules(std::move(rules)) {
+    if (this->rules.min_age < 0) {
+        throw std::invalid_argument("Minimum age cannot be negative");
+    }
+    if (this->rules.min_age > this->rules.max_age) {
+        throw std::invalid_argument("Minimum age cannot exceed maximum age");
+    }
+    std::sort(this->rules.allowed_roles.begin(), this->rules.allowed_roles.end());
+    this->rules.allowed_roles.erase(std::unique(this->rules.allowed_roles.begin(), this->rules.allowed_roles.end()),
+                                    this->rules.allowed_roles.end());
+}
+
+// Getter for the rules, with the allowed roles sorted and deduplicated
+const EligibilityRules& EligibilityCheck::getRules() const {
+    return rules;
+}
+
+// Check whether a team of the given sport may be attached
+bool EligibilityCheck::admitsSport(const std::string& sport_type) const {
+    return rules.sport_type.empty() || rules.sport_type == sport_type;
+}
+
+// Get how many more participants fit next to the ones already signed up
+size_t EligibilityCheck::roomFor(size_t participants) const {
+    if (rules.max_participants == 0) {
+        return std::numeric_limits<size_t>::max();
+    }
+    return participants >= rules.max_participants ? 0 : rules.max_participants - participants;
+}
+
+// Decide every candidate against the age and role rules; reasons[i] is the first rule
+// candidates[i] fails, or Eligible
+void EligibilityCheck::evaluate(const std::vector<Member*>& candidates, std::vector<Ineligibility>& reasons) const {
+    const size_t count = candidates.size();
+    std::vector<int> ages(count);
+    std::vector<std::uint8_t> role_allowed(count, 1);
+    for (size_t i = 0; i < count; ++i) {
+        ages[i] = candidates[i]->getAge();
+    }
+    if (!rules.allowed_roles.empty()) {
+        // Members share a handful of roles, so remember the last one looked up
+        std::string last_role;
+        std::uint8_t last_allowed = 0;
+        bool looked_up = false;
+        for (size_t i = 0; i < count; ++i) {
+            std::string role = candidates[i]->getRole();
+            if (!looked_up || role != last_role) {
+                last_allowed = std::binary_search(rules.allowed_roles.begin(), rules.allowed_roles.end(), role);
+                last_role = std::move(role);
+                looked_up = true;
+            }
+            role_allowed[i] = last_allowed;
+        }
+    }
+
+    reasons.resize(count);
+    const int min_age = rules.min_age;
+    const int max_age = rules.max_age;
+    for (size_t i = 0; i < count; ++i) {
+        const std::uint8_t young = ages[i] < min_age;
+        const std::uint8_t old = ages[i] > max_age;
+        const std::uint8_t barred = role_allowed[i] ^ 1;
+        const std::uint8_t code = young ? 1 : (old ? 2 : (barred ? 3 : 0));
+        reasons[i] = static_cast<Ineligibility>(code);
+    }
+}
+
+// Get a readable name for a reason, as used in error messages
+const char* EligibilityCheck::reasonName(Ineligibility reason) {
+    switch (reason) {
+    case Ineligibility::Eligible:
+        return "eligible";
+    case Ineligibility::TooYoung:
+        return "too young";
+    case Ineligibility::TooOld:
+        return "too old";
+    case Ineligibility::RoleNotAllowed:
+        return "role not allowed";
+    case Ineligibility::EventFull:
+        return "event is full";
+    }
+    return "unknown";
+}
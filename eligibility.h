@@ -0,0 +1,55 @@
+#ifndef ELIGIBILITY_H
+#define ELIGIBILITY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include "Member.h"
+
+// Why a candidate was turned away from an event
+enum class Ineligibility : std::uint8_t {
+    Eligible,        // admitted
+    TooYoung,        // younger than the minimum age
+    TooOld,          // older than the maximum age
+    RoleNotAllowed,  // role not in the allowed roles
+    EventFull        // eligible, but the event reached its maximum participants
+};
+
+// Sign-up rules of an event; the defaults admit everyone
+struct EligibilityRules {
+    int min_age = 0;
+    int max_age = std::numeric_limits<int>::max();
+    std::vector<std::string> allowed_roles;  // empty admits every role
+    std::string sport_type;                  // sport every attached team must play, empty for any
+    size_t max_participants = 0;             // 0 for no limit
+};
+
+// A candidate turned away and why
+struct Rejection {
+    Member* member;
+    Ineligibility reason;
+};
+
+// Eligibility rules compiled for checking whole batches of candidates
+// The fields a rule reads are gathered into columns first, then one branch-free loop
+// over the columns decides every candidate, so a large team costs one pass rather than
+// a round of checks per member. Capacity depends on how many are admitted, so the event
+// applies it to the eligible candidates in order.
+class EligibilityCheck {
+private:
+    EligibilityRules rules;
+
+public:
+    explicit EligibilityCheck(EligibilityRules rules);
+
+    const EligibilityRules& getRules() const;
+    bool admitsSport(const std::string& sport_type) const;
+    size_t roomFor(size_t participants) const;
+    void evaluate(const std::vector<Member*>& candidates, std::vector<Ineligibility>& reasons) const;
+
+    static const char* reasonName(Ineligibility reason);
+};
+
+#endif // ELIGIBILITY_H
@@ -0,0 +1,552 @@
+#ifndef ENTITYSTORE_H
+#define ENTITYSTORE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Key policy for tables that accept any entity, such as teams and events
+template <typename T>
+struct AllowDuplicates {
+    bool contains(const T*) const { return false; }
+    void insert(T*) {}
+    void erase(const T*) {}
+    void clear() {}
+    void reserve(size_t) {}
+    void shrinkToFit() {}
+    size_t memoryUsage() const { return 0; }
+};
+
+// Key policy rejecting an entity equal to one already stored
+// Equality is the entity's operator==, hashed through its identityHash()
+template <typename T>
+class UniqueByValue {
+private:
+    struct Hash {
+        size_t operator()(const T* item) const { return item->identityHash(); }
+    };
+    struct Equal {
+        bool operator()(const T* a, const T* b) const { return *a == *b; }
+    };
+
+    std::unordered_multiset<T*, Hash, Equal> entries;
+
+public:
+    bool contains(const T* item) const {
+        return entries.count(const_cast<T*>(item)) != 0;
+    }
+
+    void insert(T* item) {
+        entries.insert(item);
+    }
+
+    // An entity changed behind the store's back hashes differently, so it is then
+    // looked for in every entry rather than left dangling
+    void erase(const T* item) {
+        auto range = entries.equal_range(const_cast<T*>(item));
+        for (auto it = range.first; it != range.second; ++it) {
+            if (*it == item) {
+                entries.erase(it);
+                return;
+            }
+        }
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (*it == item) {
+                entries.erase(it);
+                return;
+            }
+        }
+    }
+
+    void clear() {
+        entries.clear();
+    }
+
+    void reserve(size_t count) {
+        entries.reserve(count);
+    }
+
+    void shrinkToFit() {
+        entries.rehash(0);
+    }
+
+    // Get the approximate heap memory used by the key set in bytes
+    size_t memoryUsage() const {
+        return entries.bucket_count() * sizeof(void*) + entries.size() * (sizeof(T*) + 2 * sizeof(void*));
+    }
+};
+
+// Heap bytes owned by an index key beyond the key object itself
+inline size_t heapBytes(const std::string& key) {
+    return key.capacity() > 15 ? key.capacity() + 1 : 0;
+}
+
+inline size_t heapBytes(long long) {
+    return 0;
+}
+
+// Index from a key to the first stored entity carrying it, in table order
+// The number of entities per key is tracked as well, so removing the only holder of
+// a key is O(1); only removing one of several falls back to a table scan.
+template <typename T, typename KeyOf>
+class FirstByKey {
+private:
+    using Key = decltype(KeyOf()(static_cast<const T*>(nullptr)));
+
+    struct Holder {
+        T* first;
+        size_t count;
+    };
+
+    std::unordered_map<Key, Holder> holders;
+
+    // Count the stored entities other than item that carry the key
+    template <typename Table>
+    static size_t countOthers(const Key& key, const T* item, const Table& table) {
+        size_t count = 0;
+        for (T* other : table) {
+            if (other != item && KeyOf()(other) == key) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+public:
+    T* find(const Key& key) const {
+        auto it = holders.find(key);
+        return it != holders.end() ? it->second.first : nullptr;
+    }
+
+    template <typename Table>
+    void insert(T* item, const Table& table) {
+        auto result = holders.emplace(KeyOf()(item), Holder{ item, 1 });
+        if (!result.second) {
+            Holder& holder = result.first->second;
+            ++holder.count;
+            if (table.precedes(item, holder.first)) {
+                holder.first = item;
+            }
+        }
+    }
+
+    // An entity whose key changed behind the store's back is not counted under its
+    // current key; the index is then rebuilt from the other entities
+    template <typename Table>
+    void erase(const T* item, const Table& table) {
+        const Key key = KeyOf()(item);
+        auto it = holders.find(key);
+        if (it == holders.end() || (it->second.first != item && countOthers(key, item, table) == it->second.count)) {
+            holders.clear();
+            for (T* other : table) {
+                if (other != item) {
+                    insert(other, table);
+                }
+            }
+            return;
+        }
+        if (--it->second.count == 0) {
+            holders.erase(it);
+            return;
+        }
+        if (it->second.first == item) {
+            for (T* other : table) {
+                if (other != item && KeyOf()(other) == key) {
+                    it->second.first = other;
+                    break;
+                }
+            }
+        }
+    }
+
+    void clear() {
+        holders.clear();
+    }
+
+    void reserve(size_t count) {
+        holders.reserve(count);
+    }
+
+    void shrinkToFit() {
+        holders.rehash(0);
+    }
+
+    // Get the approximate heap memory used by the index in bytes
+    size_t memoryUsage() const {
+        size_t bytes = holders.bucket_count() * sizeof(void*);
+        for (const auto& entry : holders) {
+            bytes += sizeof(entry) + 2 * sizeof(void*) + heapBytes(entry.first);
+        }
+        return bytes;
+    }
+};
+
+// Index keeping entities sorted by a numeric key, equal keys in insertion order
+template <typename T, typename KeyOf>
+class OrderedByKey {
+private:
+    using Key = decltype(KeyOf()(static_cast<const T*>(nullptr)));
+
+    std::multimap<Key, T*> entries;
+
+public:
+    // Visit the entities in key order
+    template <typename Visitor>
+    void forEach(Visitor&& visit) const {
+        for (const auto& entry : entries) {
+            visit(entry.second);
+        }
+    }
+
+    // Visit the entities with keys in [from, to], in key order
+    template <typename Visitor>
+    void forEachBetween(const Key& from, const Key& to, Visitor&& visit) const {
+        if (to < from) {
+            return;
+        }
+        for (auto it = entries.lower_bound(from), end = entries.upper_bound(to); it != end; ++it) {
+            visit(it->second);
+        }
+    }
+
+    template <typename Table>
+    void insert(T* item, const Table&) {
+        entries.emplace(KeyOf()(item), item);
+    }
+
+    // An entity whose key changed behind the store's back is looked for everywhere
+    template <typename Table>
+    void erase(const T* item, const Table&) {
+        auto range = entries.equal_range(KeyOf()(item));
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == item) {
+                entries.erase(it);
+                return;
+            }
+        }
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->second == item) {
+                entries.erase(it);
+                return;
+            }
+        }
+    }
+
+    void clear() {
+        entries.clear();
+    }
+
+    void reserve(size_t) {}
+
+    void shrinkToFit() {}
+
+    // Get the approximate heap memory used by the index in bytes
+    size_t memoryUsage() const {
+        return entries.size() * (sizeof(std::pair<const Key, T*>) + 4 * sizeof(void*));
+    }
+};
+
+// Index from a key to every stored entity carrying it, in table order
+// Entities are appended as they are stored, so keeping table order only costs a walk
+// back when an entity is re-indexed by modify.
+template <typename T, typename KeyOf>
+class AllByKey {
+private:
+    using Key = decltype(KeyOf()(static_cast<const T*>(nullptr)));
+
+    std::unordered_map<Key, std::vector<T*>> holders;
+
+public:
+    // Get the entities carrying the key, or nullptr if there are none
+    const std::vector<T*>* find(const Key& key) const {
+        auto it = holders.find(key);
+        return it != holders.end() ? &it->second : nullptr;
+    }
+
+    template <typename Table>
+    void insert(T* item, const Table& table) {
+        std::vector<T*>& holder = holders[KeyOf()(item)];
+        auto at = holder.end();
+        while (at != holder.begin() && table.precedes(item, *(at - 1))) {
+            --at;
+        }
+        holder.insert(at, item);
+    }
+
+    // An entity whose key changed behind the store's back is looked for everywhere
+    template <typename Table>
+    void erase(const T* item, const Table&) {
+        auto it = holders.find(KeyOf()(item));
+        if (it == holders.end() || std::find(it->second.begin(), it->second.end(), item) == it->second.end()) {
+            for (it = holders.begin(); it != holders.end(); ++it) {
+                if (std::find(it->second.begin(), it->second.end(), item) != it->second.end()) {
+                    break;
+                }
+            }
+            if (it == holders.end()) {
+                return;
+            }
+        }
+        std::vector<T*>& holder = it->second;
+        holder.erase(std::find(holder.begin(), holder.end(), item));
+        if (holder.empty()) {
+            holders.erase(it);
+        }
+    }
+
+    void clear() {
+        holders.clear();
+    }
+
+    void reserve(size_t count) {
+        holders.reserve(count);
+    }
+
+    void shrinkToFit() {
+        holders.rehash(0);
+        for (auto& entry : holders) {
+            entry.second.shrink_to_fit();
+        }
+    }
+
+    // Get the approximate heap memory used by the index in bytes
+    size_t memoryUsage() const {
+        size_t bytes = holders.bucket_count() * sizeof(void*);
+        for (const auto& entry : holders) {
+            bytes += sizeof(entry) + 2 * sizeof(void*) + heapBytes(entry.first) + entry.second.capacity() * sizeof(T*);
+        }
+        return bytes;
+    }
+};
+
+// Key extractors shared by the club's tables
+struct IdOf {
+    template <typename T>
+    int operator()(const T* item) const { return item->getId(); }
+};
+
+struct NameOf {
+    template <typename T>
+    std::string operator()(const T* item) const { return item->getName(); }
+};
+
+struct StartStampOf {
+    template <typename T>
+    long long operator()(const T* item) const { return item->getStartStamp(); }
+};
+
+// Table of entity pointers in insertion order with compile-time chosen indexes
+// KeyPolicy decides which entities count as duplicates; each of IndexPolicies is kept in
+// sync on insert and erase and is reached through index<Policy>(). Everything is
+// resolved at compile time, so there is no virtual dispatch. Removal leaves a hole that
+// iteration skips; holes are compacted away once they outnumber the stored entities,
+// which keeps erase O(1) amortised while preserving the order of the rest.
+template <typename T, typename KeyPolicy, typename... IndexPolicies>
+class EntityStore {
+private:
+    std::vector<T*> slots;  // insertion order, null where an entity was removed
+    std::unordered_map<const T*, size_t> slot_of;
+    KeyPolicy keys;
+    std::tuple<IndexPolicies...> indexes;
+
+    // Close the holes left by removals
+    void compact() {
+        size_t kept = 0;
+        for (T* item : slots) {
+            if (item != nullptr) {
+                slot_of[item] = kept;
+                slots[kept++] = item;
+            }
+        }
+        slots.resize(kept);
+    }
+
+public:
+    // Forward iterator over the stored entities, skipping holes
+    class const_iterator {
+    private:
+        typename std::vector<T*>::const_iterator it;
+        typename std::vector<T*>::const_iterator end;
+
+        void skip() {
+            while (it != end && *it == nullptr) {
+                ++it;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T* const*;
+        using reference = T* const&;
+
+        const_iterator(typename std::vector<T*>::const_iterator it, typename std::vector<T*>::const_iterator end)
+            : it(it), end(end) {
+            skip();
+        }
+
+        reference operator*() const { return *it; }
+
+        const_iterator& operator++() {
+            ++it;
+            skip();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const const_iterator& other) const { return it == other.it; }
+        bool operator!=(const const_iterator& other) const { return it != other.it; }
+    };
+
+    const_iterator begin() const {
+        return const_iterator(slots.begin(), slots.end());
+    }
+
+    const_iterator end() const {
+        return const_iterator(slots.end(), slots.end());
+    }
+
+    // Add an entity at the end of the table
+    // Returns false, leaving the table unchanged, if the entity is already stored or the
+    // key policy finds an equal one
+    bool insert(T* item) {
+        if (slot_of.count(item) != 0 || keys.contains(item)) {
+            return false;
+        }
+        slot_of.emplace(item, slots.size());
+        slots.push_back(item);
+        keys.insert(item);
+        std::apply([this, item](auto&... index) { (index.insert(item, *this), ...); }, indexes);
+        return true;
+    }
+
+    // Remove an entity, keeping the others in order
+    // Returns false if the entity is not stored
+    bool erase(const T* item) {
+        auto it = slot_of.find(item);
+        if (it == slot_of.end()) {
+            return false;
+        }
+        slots[it->second] = nullptr;
+        slot_of.erase(it);
+        keys.erase(item);
+        std::apply([this, item](auto&... index) { (index.erase(item, *this), ...); }, indexes);
+        if (slots.size() > 2 * slot_of.size() + 16) {
+            compact();
+        }
+        return true;
+    }
+
+    bool contains(const T* item) const {
+        return slot_of.count(item) != 0;
+    }
+
+    // Check whether a stored entity comes before another in table order
+    bool precedes(const T* a, const T* b) const {
+        return slot_of.at(a) < slot_of.at(b);
+    }
+
+    // Apply a change that alters an entity's keys, re-indexing it around the change
+    // The change may throw; the entity is re-indexed under whatever state it is left in
+    template <typename Change>
+    void modify(T* item, Change&& change) {
+        if (!contains(item)) {
+            change();
+            return;
+        }
+        keys.erase(item);
+        std::apply([this, item](auto&... index) { (index.erase(item, *this), ...); }, indexes);
+        try {
+            change();
+        }
+        catch (...) {
+            keys.insert(item);
+            std::apply([this, item](auto&... index) { (index.insert(item, *this), ...); }, indexes);
+            throw;
+        }
+        keys.insert(item);
+        std::apply([this, item](auto&... index) { (index.insert(item, *this), ...); }, indexes);
+    }
+
+    template <typename Index>
+    const Index& index() const {
+        return std::get<Index>(indexes);
+    }
+
+    // Make room for count stored entities, so inserting up to that many never rehashes
+    // the table, its key set or its indexes
+    void reserve(size_t count) {
+        slots.reserve(slots.size() - slot_of.size() + count);
+        slot_of.reserve(count);
+        keys.reserve(count);
+        std::apply([count](auto&... index) { (index.reserve(count), ...); }, indexes);
+    }
+
+    // Close the holes left by removals and release spare capacity in the table, its key
+    // set and its indexes; stored entities do not move
+    void shrinkToFit() {
+        compact();
+        slots.shrink_to_fit();
+        slot_of.rehash(0);
+        keys.shrinkToFit();
+        std::apply([](auto&... index) { (index.shrinkToFit(), ...); }, indexes);
+    }
+
+    // Get the approximate heap memory used by the table itself in bytes
+    size_t memoryUsage() const {
+        return slots.capacity() * sizeof(T*) + slot_of.bucket_count() * sizeof(void*) +
+               slot_of.size() * (sizeof(std::pair<const T* const, size_t>) + sizeof(void*));
+    }
+
+    // Get the approximate heap memory used by the key set in bytes
+    size_t keyMemoryUsage() const {
+        return keys.memoryUsage();
+    }
+
+    // Get the approximate heap memory used by one index in bytes
+    template <typename Index>
+    size_t indexMemoryUsage() const {
+        return std::get<Index>(indexes).memoryUsage();
+    }
+
+    // Copy the stored entities in table order
+    std::vector<T*> list() const {
+        std::vector<T*> result;
+        result.reserve(slot_of.size());
+        for (T* item : *this) {
+            result.push_back(item);
+        }
+        return result;
+    }
+
+    size_t size() const {
+        return slot_of.size();
+    }
+
+    bool empty() const {
+        return slot_of.empty();
+    }
+
+    void clear() {
+        slots.clear();
+        slot_of.clear();
+        keys.clear();
+        std::apply([](auto&... index) { (index.clear(), ...); }, indexes);
+    }
+};
+
+#endif // ENTITYSTORE_H
@@ -1,116 +1,455 @@
-#include "Event.h"
-#include <algorithm>
-#include "Team.h"
-
-// Constructor to initialize an Event object with date, location, and name
-// Throws an exception if any of the parameters are empty
-Event::Event(const std::string& date, const std::string& location, const std::string& name)
-    : date(date), location(location), name(name) {
-    if (date.empty()) {
-        throw std::invalid_argument("Date cannot be empty");
-    }
-    if (location.empty()) {
-        throw std::invalid_argument("Location cannot be empty");
-    }
-    if (name.empty()) {
-        throw std::invalid_argument("Name cannot be empty");
-    }
-}
-
-// Getter for the event date
-std::string Event::getDate() const {
-    return date;
-}
-
-// Getter for the event location
-std::string Event::getLocation() const {
-    return location;
-}
-
-// Getter for the event name
-std::string Event::getName() const {
-    return name;
-}
-
-// Getter for the teams participating in the event
-std::vector<Team*> Event::getTeams() const {
-    return teams;
-}
-
-// Reschedule the event to a new date
-void Event::reschedule(const std::string& new_date) {
-    date = new_date;
-}
-
-// Add a participant to the event
-// Throws an exception if the participant is null
-void Event::addParticipant(Member* participant) {
-    if (participant == nullptr) {
-        throw std::invalid_argument("Participant cannot be null");
-    }
-    participants.push_back(participant);
-}
-
-// Getter for the participants of the event
-std::vector<Member*> Event::getParticipants() const {
-    return participants;
-}
-
-// Remove a participant from the event
-void Event::removeParticipant(Member* member) {
-    auto it = std::find(participants.begin(), participants.end(), member);
-    if (it != participants.end()) {
-        participants.erase(it);
-    }
-}
-
-// Add a team to the event
-// Throws an exception if the team pointer is null or the team ID is invalid
-void Event::addTeam(Team* team) {
-    if (team == nullptr) {
-        throw std::invalid_argument("Team pointer is null");  // Check for null pointer
-    }
-
-    if (team->getId() <= 0) {
-        throw std::invalid_argument("Team ID is invalid");  // Check for invalid ID
-    }
-
-    // Check if the team already exists in the event by team ID
-    auto it = std::find_if(teams.begin(), teams.end(), [team](Team* t) {
-        return t->getId() == team->getId();
-        });
-    if (it != teams.end()) {
-        throw std::invalid_argument("Team with this ID is already added to the event");
-    }
-
-    teams.push_back(team);
-
-    // Add all team members to the participants list
-    for (auto member : team->getMembers()) {
-        // Avoid duplicate participants
-        if (std::find(participants.begin(), participants.end(), member) == participants.end()) {
-            participants.push_back(member);
-        }
-    }
-}
-
-// Remove a team from the event
-void Event::removeTeam(Team* team) {
-    auto it = std::find(teams.begin(), teams.end(), team);
-    if (it != teams.end()) {
-        teams.erase(it);
-    }
-}
-
-// Get the count of participants in the event
-size_t Event::getParticipantCount() const {
-    return participants.size();
-}
-
-// Equality operator to compare two events
-bool Event::operator==(const Event& other) const {
-    return date == other.date &&
-        location == other.location &&
-        name == other.name &&
-        participants == other.participants;
-}
+#include "Event.h"
+#include <algorithm>
+#include "Club.h"
+#include "Team.h"
+
+std::atomic<std::uint64_t> Event::participants_revision{ 0 };
+
+// Constructor to initialize an Event object with date, location, and name
+// The event occupies the whole day (00:00-24:00)
+// Throws an exception if any of the parameters are empty
+Event::Event(std::string_view date, std::string location, std::string name)
+    : Event(date, std::move(location), std::move(name), "00:00", "24:00") {}
+
+// Constructor to initialize an Event object with a time range on the given date
+// The date must be an ISO-8601 "YYYY-MM-DD" date and the times "HH:MM"
+// Throws an exception if any of the parameters are empty or malformed
+Event::Event(std::string_view date, std::string location, std::string name,
+             std::string_view start_time, std::string_view end_time)
+    : Event(date.empty() ? Date() : Date::parse(date), std::move(location), std::move(name),
+            DateTime::parseTime(start_time), DateTime::parseTime(end_time)) {
+    if (date.empty()) {
+        throw std::invalid_argument("Date cannot be empty");
+    }
+}
+
+// Constructor to initialize an Event object from an already parsed date and minutes of the day
+// The strings are taken by value and moved in, so rvalue arguments are never copied
+// Throws an exception if the location or name are empty or the time range is invalid
+Event::Event(Date date, std::string location, std::string name, int start_minute, int end_minute)
+    : date(date), location(std::move(location)), name(std::move(name)), next_join(1), owner(nullptr) {
+    if (this->location.empty()) {
+        throw std::invalid_argument("Location cannot be empty");
+    }
+    if (this->name.empty()) {
+        throw std::invalid_argument("Name cannot be empty");
+    }
+    if (start_minute < 0 || end_minute > DateTime::MINUTES_PER_DAY || start_minute >= end_minute) {
+        throw std::invalid_argument("Event must end after it starts");
+    }
+    this->start_minute = static_cast<std::int16_t>(start_minute);
+    this->end_minute = static_cast<std::int16_t>(end_minute);
+}
+
+// Copy constructor; the copy is registered with the same teams but belongs to no club
+Event::Event(const Event& other)
+    : date(other.date), location(other.location), name(other.name), start_minute(other.start_minute),
+      end_minute(other.end_minute), participants(other.participants), joined(other.joined),
+      next_join(other.next_join), teams(other.teams), eligibility(other.eligibility), owner(nullptr) {
+    for (auto team : teams) {
+        team->events.push_back(this);
+    }
+}
+
+// Copy assignment; the event takes over the other event's teams
+// An event held by a club stays in it, re-indexed under the new details
+Event& Event::operator=(const Event& other) {
+    if (this != &other) {
+        if (owner != nullptr) {
+            owner->replaceEvent(this, other);
+        }
+        else {
+            assign(other);
+        }
+    }
+    return *this;
+}
+
+// Take over every detail of another event except the owning club
+void Event::assign(const Event& other) {
+    for (auto team : std::vector<Team*>(teams)) {
+        removeTeam(team);
+    }
+    date = other.date;
+    location = other.location;
+    name = other.name;
+    start_minute = other.start_minute;
+    end_minute = other.end_minute;
+    participants = other.participants;
+    joined = other.joined;
+    next_join = other.next_join;
+    ++participants_revision;
+    teams = other.teams;
+    for (auto team : teams) {
+        team->events.push_back(this);
+    }
+    eligibility = other.eligibility;
+}
+
+// Destructor to unregister the event from its teams and from the club holding it
+Event::~Event() {
+    if (owner != nullptr) {
+        owner->cancelEvent(this);
+    }
+    for (auto team : teams) {
+        auto it = std::find(team->events.begin(), team->events.end(), this);
+        if (it != team->events.end()) {
+            team->events.erase(it);
+        }
+    }
+}
+
+// Getter for the event date, formatted as "YYYY-MM-DD"
+std::string Event::getDate() const {
+    return date.toString();
+}
+
+// Getter for the event date as a compact day value
+Date Event::getCalendarDate() const {
+    return date;
+}
+
+// Getter for the start of the event in minutes since midnight
+int Event::getStartMinute() const {
+    return start_minute;
+}
+
+// Getter for the end of the event in minutes since midnight
+int Event::getEndMinute() const {
+    return end_minute;
+}
+
+// Getter for the event location
+std::string Event::getLocation() const {
+    return location;
+}
+
+// Getter for the event name
+std::string Event::getName() const {
+    return name;
+}
+
+// Getter for the start time of the event
+std::string Event::getStartTime() const {
+    return DateTime::formatTime(start_minute);
+}
+
+// Getter for the end time of the event
+std::string Event::getEndTime() const {
+    return DateTime::formatTime(end_minute);
+}
+
+// Getter for the start of the event in minutes since 1970-01-01 00:00
+long long Event::getStartStamp() const {
+    return static_cast<long long>(date.getDayNumber()) * DateTime::MINUTES_PER_DAY + start_minute;
+}
+
+// Getter for the end of the event in minutes since 1970-01-01 00:00
+long long Event::getEndStamp() const {
+    return static_cast<long long>(date.getDayNumber()) * DateTime::MINUTES_PER_DAY + end_minute;
+}
+
+// Getter for the teams participating in the event
+std::vector<Team*> Event::getTeams() const {
+    return teams;
+}
+
+// Reschedule the event to a new date, keeping its time of day
+// Throws an exception if the date is not a valid "YYYY-MM-DD" date
+void Event::reschedule(const std::string& new_date) {
+    reschedule(Date::parse(new_date), start_minute, end_minute);
+}
+
+// Reschedule the event to a new date and time range
+void Event::reschedule(const std::string& new_date, const std::string& start_time, const std::string& end_time) {
+    reschedule(Date::parse(new_date), DateTime::parseTime(start_time), DateTime::parseTime(end_time));
+}
+
+// Reschedule the event to a new date and time range given as minutes of the day
+// An event held by a club is moved through the club, so its calendar and indexes follow
+// Throws an exception if the time range is invalid
+void Event::reschedule(Date new_date, int new_start_minute, int new_end_minute) {
+    if (owner != nullptr) {
+        owner->rescheduleEvent(this, new_date, new_start_minute, new_end_minute);
+    }
+    else {
+        moveTo(new_date, new_start_minute, new_end_minute);
+    }
+}
+
+// Change the date and time range without telling the owning club
+// Throws an exception if the time range is invalid
+void Event::moveTo(Date new_date, int new_start_minute, int new_end_minute) {
+    if (new_start_minute < 0 || new_end_minute > DateTime::MINUTES_PER_DAY || new_start_minute >= new_end_minute) {
+        throw std::invalid_argument("Event must end after it starts");
+    }
+    date = new_date;
+    start_minute = static_cast<std::int16_t>(new_start_minute);
+    end_minute = static_cast<std::int16_t>(new_end_minute);
+}
+
+// Add a participant to the event
+// Throws an exception if the participant is null or the event's rules turn them away
+void Event::addParticipant(Member* participant) {
+    if (participant == nullptr) {
+        throw std::invalid_argument("Participant cannot be null");
+    }
+    const std::vector<Rejection> rejected = admit({ participant });
+    if (!rejected.empty()) {
+        throw std::invalid_argument(std::string("Participant is not eligible: ") +
+                                    EligibilityCheck::reasonName(rejected.front().reason));
+    }
+}
+
+// Add every eligible candidate, in order, and return the others with the reason each
+// was turned away; once the event is full the remaining eligible candidates are rejected
+// as EventFull
+// Throws an exception if any candidate is null, before anyone is added
+std::vector<Rejection> Event::addParticipants(const std::vector<Member*>& candidates) {
+    for (auto candidate : candidates) {
+        if (candidate == nullptr) {
+            throw std::invalid_argument("Participant cannot be null");
+        }
+    }
+    return admit(candidates);
+}
+
+// Check a batch of non-null candidates against the rules in one pass and append the admitted ones
+std::vector<Rejection> Event::admit(const std::vector<Member*>& candidates) {
+    std::vector<Rejection> rejected;
+    if (candidates.empty()) {
+        return rejected;
+    }
+    participants.reserve(participants.size() + candidates.size());
+    joined.reserve(joined.size() + candidates.size());
+    if (!eligibility) {
+        for (auto candidate : candidates) {
+            appendParticipant(candidate);
+        }
+        ++participants_revision;
+        return rejected;
+    }
+
+    std::vector<Ineligibility> reasons;
+    eligibility->evaluate(candidates, reasons);
+    size_t room = eligibility->roomFor(participants.size());
+    const size_t before = participants.size();
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (reasons[i] == Ineligibility::Eligible && room == 0) {
+            reasons[i] = Ineligibility::EventFull;
+        }
+        if (reasons[i] != Ineligibility::Eligible) {
+            rejected.push_back({ candidates[i], reasons[i] });
+            continue;
+        }
+        appendParticipant(candidates[i]);
+        --room;
+    }
+    if (participants.size() != before) {
+        ++participants_revision;
+    }
+    return rejected;
+}
+
+// Append a participant with the next join stamp
+void Event::appendParticipant(Member* participant) {
+    participants.push_back(participant);
+    joined.push_back(next_join++);
+}
+
+// Getter for the participants of the event
+std::vector<Member*> Event::getParticipants() const {
+    return participants;
+}
+
+// Get up to limit participants after the cursor, in the order they joined
+// Join stamps only grow, so a cursor resumes correctly after participants leave or join
+ScanPage<Member> Event::scanParticipants(const ScanCursor& cursor, size_t limit) const {
+    ScanPage<Member> page;
+    page.next = cursor;
+    if (cursor.finished) {
+        return page;
+    }
+    size_t index = static_cast<size_t>(std::upper_bound(joined.begin(), joined.end(), cursor.sequence) - joined.begin());
+    for (; index < participants.size() && page.items.size() < limit; ++index) {
+        page.items.push_back(participants[index]);
+        page.next.sequence = joined[index];
+    }
+    page.next.finished = index == participants.size();
+    return page;
+}
+
+// Remove a participant from the event
+void Event::removeParticipant(Member* member) {
+    auto it = std::find(participants.begin(), participants.end(), member);
+    if (it != participants.end()) {
+        joined.erase(joined.begin() + (it - participants.begin()));
+        participants.erase(it);
+        ++participants_revision;
+    }
+}
+
+// Remove every participant entry of the given members in one pass, keeping the join
+// order of the rest
+// Returns the removed entries
+std::vector<Member*> Event::removeParticipants(const std::unordered_set<const Member*>& doomed) {
+    std::vector<Member*> removed;
+    size_t kept = 0;
+    for (size_t i = 0; i < participants.size(); ++i) {
+        if (doomed.count(participants[i]) != 0) {
+            removed.push_back(participants[i]);
+        }
+        else {
+            participants[kept] = participants[i];
+            joined[kept] = joined[i];
+            ++kept;
+        }
+    }
+    if (!removed.empty()) {
+        participants.resize(kept);
+        joined.resize(kept);
+        ++participants_revision;
+    }
+    return removed;
+}
+
+// Add a team to the event, signing up its members who are not participants yet
+// Members are checked against the event's rules as one batch; the team is attached even
+// if some of them are turned away, and those are returned with their reasons
+// Throws an exception if the team pointer is null, the team ID is invalid, the team is
+// already attached, or the rules require another sport
+std::vector<Rejection> Event::addTeam(Team* team) {
+    if (team == nullptr) {
+        throw std::invalid_argument("Team pointer is null");  // Check for null pointer
+    }
+
+    if (team->getId() <= 0) {
+        throw std::invalid_argument("Team ID is invalid");  // Check for invalid ID
+    }
+
+    // Check if the team already exists in the event by team ID
+    auto it = std::find_if(teams.begin(), teams.end(), [team](Team* t) {
+        return t->getId() == team->getId();
+        });
+    if (it != teams.end()) {
+        throw std::invalid_argument("Team with this ID is already added to the event");
+    }
+
+    if (eligibility && !eligibility->admitsSport(team->getSportType())) {
+        throw std::invalid_argument("Team sport does not match the event");
+    }
+
+    teams.push_back(team);
+    team->events.push_back(this);
+
+    // Sign up the team members once each, skipping those already participating; the
+    // participants are hashed once so the batch costs one pass rather than a search per member
+    std::unordered_set<const Member*> signed_up(participants.begin(), participants.end());
+    std::vector<Member*> newcomers;
+    for (auto member : team->getMembers()) {
+        if (signed_up.insert(member).second) {
+            newcomers.push_back(member);
+        }
+    }
+    std::vector<Rejection> rejected = admit(newcomers);
+    ++participants_revision;
+    return rejected;
+}
+
+// Remove a team from the event
+void Event::removeTeam(Team* team) {
+    auto it = std::find(teams.begin(), teams.end(), team);
+    if (it != teams.end()) {
+        teams.erase(it);
+        auto back = std::find(team->events.begin(), team->events.end(), this);
+        if (back != team->events.end()) {
+            team->events.erase(back);
+        }
+    }
+}
+
+// Detach the given teams from the event in one pass
+void Event::removeTeams(const std::unordered_set<const Team*>& doomed) {
+    auto kept = std::remove_if(teams.begin(), teams.end(), [this, &doomed](Team* team) {
+        if (doomed.count(team) == 0) {
+            return false;
+        }
+        auto back = std::find(team->events.begin(), team->events.end(), this);
+        if (back != team->events.end()) {
+            team->events.erase(back);
+        }
+        return true;
+        });
+    teams.erase(kept, teams.end());
+}
+
+// Swap one attached team for another, leaving the participants untouched
+// If the new team is already attached the old one is simply removed
+void Event::replaceTeam(Team* old_team, Team* new_team) {
+    if (new_team == nullptr) {
+        throw std::invalid_argument("Team pointer is null");
+    }
+    auto it = std::find(teams.begin(), teams.end(), old_team);
+    if (it == teams.end() || old_team == new_team) {
+        return;
+    }
+    if (std::find(teams.begin(), teams.end(), new_team) != teams.end()) {
+        removeTeam(old_team);
+        return;
+    }
+    *it = new_team;
+    auto back = std::find(old_team->events.begin(), old_team->events.end(), this);
+    if (back != old_team->events.end()) {
+        old_team->events.erase(back);
+    }
+    new_team->events.push_back(this);
+}
+
+// Get the count of participants in the event
+size_t Event::getParticipantCount() const {
+    return participants.size();
+}
+
+// Get the approximate heap memory used by the participant and team lists in bytes
+size_t Event::memoryUsage() const {
+    return participants.capacity() * sizeof(Member*) + joined.capacity() * sizeof(std::uint64_t) +
+           teams.capacity() * sizeof(Team*);
+}
+
+// Release spare participant and team list capacity
+void Event::shrinkToFit() {
+    participants.shrink_to_fit();
+    joined.shrink_to_fit();
+    teams.shrink_to_fit();
+}
+
+// Set the rules later sign-ups are checked against; current participants and teams stay
+// Throws an exception if the age range is empty or starts below zero
+void Event::setEligibility(EligibilityRules rules) {
+    eligibility = std::make_shared<const EligibilityCheck>(std::move(rules));
+}
+
+// Drop the rules so anyone may sign up again
+void Event::clearEligibility() {
+    eligibility.reset();
+}
+
+// Get the rules sign-ups are checked against, or nullptr if anyone may sign up
+const EligibilityRules* Event::getEligibility() const {
+    return eligibility ? &eligibility->getRules() : nullptr;
+}
+
+// Get the counter bumped whenever any event's participants change
+std::uint64_t Event::getParticipantsRevision() {
+    return participants_revision;
+}
+
+// Equality operator to compare two events
+bool Event::operator==(const Event& other) const {
+    return date == other.date &&
+        start_minute == other.start_minute &&
+        end_minute == other.end_minute &&
+        location == other.location &&
+        name == other.name &&
+        participants == other.participants;
+}
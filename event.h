@@ -1,41 +1,96 @@
-#ifndef EVENT_H
-#define EVENT_H
-
-#include <vector>
-#include <string>
-#include "Member.h"
-#include "Team.h"
-
-class Event {
-private:
-    std::string date;
-    std::string location;
-    std::string name;
-    std::vector<Member*> participants;
-    std::vector<Team*> teams;  
-
-public:
-    Event(const std::string& date, const std::string& location, const std::string& name);
-
-    void reschedule(const std::string& new_date);
-    void addParticipant(Member* participant);
-    void removeParticipant(Member* participant);
-
-    std::string getDate() const;
-    std::string getLocation() const;
-    std::string getName() const;
-    std::vector<Member*> getParticipants() const;
-
-    void addTeam(Team* team);  
-    void removeTeam(Team* team);  
-
-
-   
-    std::vector<Team*> getTeams() const;  
-
-
-    bool operator==(const Event& other) const;
-    size_t getParticipantCount() const;
-};
-
-#endif // EVENT_H
+#ifndef EVENT_H
+#define EVENT_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include "Date.h"
+#include "Eligibility.h"
+#include "Member.h"
+#include "Team.h"
+#include "Scan.h"
+
+class Club;
+
+class Event {
+private:
+    Date date;
+    std::string location;
+    std::string name;
+    std::int16_t start_minute;  // minutes since midnight, inclusive
+    std::int16_t end_minute;    // minutes since midnight, exclusive
+    std::vector<Member*> participants;
+    std::vector<std::uint64_t> joined;  // increasing join stamp of each participant
+    std::uint64_t next_join;
+    std::vector<Team*> teams;  
+    std::shared_ptr<const EligibilityCheck> eligibility;  // null while anyone may sign up; shared by copies
+    Club* owner;  // club whose indexes hold the event, told about every change of date, venue or name
+
+    static std::atomic<std::uint64_t> participants_revision;  // bumped whenever any event's participants change; atomic so clubs on separate threads share it safely
+
+    friend class Team;
+    friend class Club;
+
+    void appendParticipant(Member* participant);
+    void moveTo(Date new_date, int new_start_minute, int new_end_minute);
+    void assign(const Event& other);
+    std::vector<Rejection> admit(const std::vector<Member*>& candidates);
+
+public:
+    Event(std::string_view date, std::string location, std::string name);
+    Event(std::string_view date, std::string location, std::string name,
+          std::string_view start_time, std::string_view end_time);
+    Event(Date date, std::string location, std::string name, int start_minute, int end_minute);
+    Event(const Event& other);
+    Event& operator=(const Event& other);
+    ~Event();
+
+    void reschedule(const std::string& new_date);
+    void reschedule(const std::string& new_date, const std::string& start_time, const std::string& end_time);
+    void reschedule(Date new_date, int new_start_minute, int new_end_minute);
+    void addParticipant(Member* participant);
+    std::vector<Rejection> addParticipants(const std::vector<Member*>& candidates);
+    void removeParticipant(Member* participant);
+    std::vector<Member*> removeParticipants(const std::unordered_set<const Member*>& doomed);
+
+    std::string getDate() const;
+    Date getCalendarDate() const;
+    int getStartMinute() const;
+    int getEndMinute() const;
+    std::string getLocation() const;
+    std::string getName() const;
+    std::string getStartTime() const;
+    std::string getEndTime() const;
+    std::vector<Member*> getParticipants() const;
+    ScanPage<Member> scanParticipants(const ScanCursor& cursor, size_t limit) const;
+
+    // Absolute minutes since 1970-01-01 00:00, used by the venue calendar
+    long long getStartStamp() const;
+    long long getEndStamp() const;
+
+    std::vector<Rejection> addTeam(Team* team);  
+    void removeTeam(Team* team);  
+    void removeTeams(const std::unordered_set<const Team*>& doomed);
+    void replaceTeam(Team* old_team, Team* new_team);
+
+
+   
+    std::vector<Team*> getTeams() const;  
+
+    void setEligibility(EligibilityRules rules);
+    void clearEligibility();
+    const EligibilityRules* getEligibility() const;
+
+
+    bool operator==(const Event& other) const;
+    size_t getParticipantCount() const;
+    size_t memoryUsage() const;
+    void shrinkToFit();
+    static std::uint64_t getParticipantsRevision();
+};
+
+#endif // EVENT_H
@@ -0,0 +1,383 @@
+#include "Graph.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+// Constructor; zero threads means one per hardware thread
+CoParticipationGraph::CoParticipationGraph(size_t threads)
+    : delta_entries(0), thread_count(threads) {
+    if (thread_count == 0) {
+        thread_count = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+    offsets.push_back(0);
+}
+
+// Get the distinct member ids taking part in an event
+std::vector<int> CoParticipationGraph::distinctIds(const Event& event) {
+    std::vector<int> ids;
+    for (auto member : event.getParticipants()) {
+        ids.push_back(member->getId());
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
+
+// Get the node of a member, adding one if the member is new to the graph
+int CoParticipationGraph::nodeFor(int member_id) {
+    auto it = node_of.find(member_id);
+    if (it != node_of.end()) {
+        return it->second;
+    }
+    const int node = static_cast<int>(member_ids.size());
+    member_ids.push_back(member_id);
+    node_of.emplace(member_id, node);
+    delta.emplace_back();
+    return node;
+}
+
+// Number of nodes covered by the CSR arrays
+size_t CoParticipationGraph::baseNodes() const {
+    return offsets.size() - 1;
+}
+
+// Record a weight change on an undirected edge
+void CoParticipationGraph::addWeight(int a, int b, int change) {
+    for (int pass = 0; pass < 2; ++pass) {
+        auto& row = delta[a];
+        auto it = row.find(b);
+        if (it == row.end()) {
+            row.emplace(b, change);
+            ++delta_entries;
+        }
+        else if ((it->second += change) == 0) {
+            row.erase(it);
+            --delta_entries;
+        }
+        std::swap(a, b);
+    }
+}
+
+// Visit the neighbors of a node with their current weights, base and pending changes combined
+void CoParticipationGraph::forEachNeighbor(int node, const std::function<void(int, int)>& visit) const {
+    const auto& changes = delta[node];
+    const int* row_begin = nullptr;
+    const int* row_end = nullptr;
+    if (static_cast<size_t>(node) < baseNodes()) {
+        row_begin = neighbors.data() + offsets[node];
+        row_end = neighbors.data() + offsets[node + 1];
+        for (const int* it = row_begin; it != row_end; ++it) {
+            int weight = weights[static_cast<size_t>(it - neighbors.data())];
+            if (!changes.empty()) {
+                auto change = changes.find(*it);
+                if (change != changes.end()) {
+                    weight += change->second;
+                }
+            }
+            if (weight > 0) {
+                visit(*it, weight);
+            }
+        }
+    }
+    for (const auto& change : changes) {
+        if (change.second > 0 && !std::binary_search(row_begin, row_end, change.first)) {
+            visit(change.first, change.second);
+        }
+    }
+}
+
+// Run body(begin, end) over [0, count) split across the worker threads
+void CoParticipationGraph::parallelFor(size_t count, const std::function<void(size_t, size_t)>& body) const {
+    const size_t workers = std::min(thread_count, std::max<size_t>(1, count / 1024));
+    if (workers <= 1) {
+        body(0, count);
+        return;
+    }
+    std::vector<std::thread> threads;
+    const size_t chunk = (count + workers - 1) / workers;
+    for (size_t w = 0; w < workers; ++w) {
+        const size_t begin = w * chunk;
+        const size_t end = std::min(count, begin + chunk);
+        if (begin < end) {
+            threads.emplace_back(body, begin, end);
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+// Build the graph from scratch from the participants of the given events
+void CoParticipationGraph::build(const std::vector<Event*>& events) {
+    member_ids.clear();
+    node_of.clear();
+    delta.clear();
+    delta_entries = 0;
+
+    // Collect every co-participating pair once per event as a packed (low, high) key
+    std::vector<std::uint64_t> pairs;
+    for (auto event : events) {
+        std::vector<int> nodes;
+        for (int id : distinctIds(*event)) {
+            nodes.push_back(nodeFor(id));
+        }
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            for (size_t j = i + 1; j < nodes.size(); ++j) {
+                const std::uint32_t a = static_cast<std::uint32_t>(std::min(nodes[i], nodes[j]));
+                const std::uint32_t b = static_cast<std::uint32_t>(std::max(nodes[i], nodes[j]));
+                pairs.push_back((std::uint64_t(a) << 32) | b);
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    // Count row sizes, then fill rows; sorted pairs keep every row sorted
+    const size_t node_count = member_ids.size();
+    offsets.assign(node_count + 1, 0);
+    std::vector<std::pair<std::uint64_t, int>> edges;
+    for (size_t i = 0; i < pairs.size();) {
+        size_t j = i;
+        while (j < pairs.size() && pairs[j] == pairs[i]) {
+            ++j;
+        }
+        edges.emplace_back(pairs[i], static_cast<int>(j - i));
+        ++offsets[(pairs[i] >> 32) + 1];
+        ++offsets[(pairs[i] & 0xFFFFFFFFu) + 1];
+        i = j;
+    }
+    for (size_t n = 0; n < node_count; ++n) {
+        offsets[n + 1] += offsets[n];
+    }
+    neighbors.assign(offsets[node_count], 0);
+    weights.assign(offsets[node_count], 0);
+    std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (const auto& edge : edges) {
+        const int a = static_cast<int>(edge.first >> 32);
+        const int b = static_cast<int>(edge.first & 0xFFFFFFFFu);
+        neighbors[fill[a]] = b;
+        weights[fill[a]++] = edge.second;
+        neighbors[fill[b]] = a;
+        weights[fill[b]++] = edge.second;
+    }
+}
+
+// Record that members joined an event that already had the existing members
+void CoParticipationGraph::addParticipants(const std::vector<int>& existing, const std::vector<int>& joined) {
+    std::vector<int> joined_nodes;
+    for (int id : joined) {
+        joined_nodes.push_back(nodeFor(id));
+    }
+    std::vector<int> existing_nodes;
+    for (int id : existing) {
+        existing_nodes.push_back(nodeFor(id));
+    }
+    for (size_t i = 0; i < joined_nodes.size(); ++i) {
+        for (int other : existing_nodes) {
+            addWeight(joined_nodes[i], other, 1);
+        }
+        for (size_t j = 0; j < i; ++j) {
+            addWeight(joined_nodes[i], joined_nodes[j], 1);
+        }
+    }
+    if (delta_entries > neighbors.size() / 4 + 1024) {
+        compact();
+    }
+}
+
+// Record that members left an event, leaving the remaining members in it
+void CoParticipationGraph::removeParticipants(const std::vector<int>& remaining, const std::vector<int>& left) {
+    std::vector<int> left_nodes;
+    for (int id : left) {
+        left_nodes.push_back(nodeFor(id));
+    }
+    std::vector<int> remaining_nodes;
+    for (int id : remaining) {
+        remaining_nodes.push_back(nodeFor(id));
+    }
+    for (size_t i = 0; i < left_nodes.size(); ++i) {
+        for (int other : remaining_nodes) {
+            addWeight(left_nodes[i], other, -1);
+        }
+        for (size_t j = 0; j < i; ++j) {
+            addWeight(left_nodes[i], left_nodes[j], -1);
+        }
+    }
+    if (delta_entries > neighbors.size() / 4 + 1024) {
+        compact();
+    }
+}
+
+// Record that an event and all its co-participations are gone
+void CoParticipationGraph::removeEvent(const Event& event) {
+    removeParticipants({}, distinctIds(event));
+}
+
+// Fold the pending changes into the CSR arrays
+void CoParticipationGraph::compact() {
+    const size_t node_count = member_ids.size();
+    std::vector<std::uint32_t> new_offsets(node_count + 1, 0);
+    std::vector<int> new_neighbors;
+    std::vector<std::int32_t> new_weights;
+    new_neighbors.reserve(neighbors.size() + delta_entries);
+    new_weights.reserve(neighbors.size() + delta_entries);
+
+    std::vector<std::pair<int, int>> row;
+    for (size_t n = 0; n < node_count; ++n) {
+        row.clear();
+        forEachNeighbor(static_cast<int>(n), [&row](int neighbor, int weight) {
+            row.emplace_back(neighbor, weight);
+            });
+        std::sort(row.begin(), row.end());
+        for (const auto& entry : row) {
+            new_neighbors.push_back(entry.first);
+            new_weights.push_back(entry.second);
+        }
+        new_offsets[n + 1] = static_cast<std::uint32_t>(new_neighbors.size());
+    }
+
+    offsets.swap(new_offsets);
+    neighbors.swap(new_neighbors);
+    weights.swap(new_weights);
+    for (auto& changes : delta) {
+        changes.clear();
+    }
+    delta_entries = 0;
+}
+
+// Get the number of members in the graph
+size_t CoParticipationGraph::nodeCount() const {
+    return member_ids.size();
+}
+
+// Get the number of undirected edges with a positive weight
+size_t CoParticipationGraph::edgeCount() const {
+    size_t total = 0;
+    for (const auto& entry : degrees()) {
+        total += entry.second;
+    }
+    return total / 2;
+}
+
+// Get the number of pending per-node weight changes not yet folded into the CSR arrays
+size_t CoParticipationGraph::pendingChanges() const {
+    return delta_entries;
+}
+
+// Get the approximate heap memory used by the graph in bytes
+size_t CoParticipationGraph::memoryUsage() const {
+    size_t total = member_ids.capacity() * sizeof(int) + offsets.capacity() * sizeof(std::uint32_t) +
+                   neighbors.capacity() * sizeof(int) + weights.capacity() * sizeof(std::int32_t);
+    total += node_of.bucket_count() * sizeof(void*) + node_of.size() * (sizeof(std::pair<const int, int>) + sizeof(void*));
+    total += delta.capacity() * sizeof(std::unordered_map<int, int>);
+    for (const auto& changes : delta) {
+        total += changes.bucket_count() * sizeof(void*) + changes.size() * (sizeof(std::pair<const int, int>) + sizeof(void*));
+    }
+    return total;
+}
+
+// Get the number of distinct partners of a member
+size_t CoParticipationGraph::degree(int member_id) const {
+    auto it = node_of.find(member_id);
+    if (it == node_of.end()) {
+        return 0;
+    }
+    size_t count = 0;
+    forEachNeighbor(it->second, [&count](int, int) { ++count; });
+    return count;
+}
+
+// Get the number of distinct partners of every member, computed in parallel
+std::vector<std::pair<int, size_t>> CoParticipationGraph::degrees() const {
+    std::vector<std::pair<int, size_t>> result(member_ids.size());
+    parallelFor(member_ids.size(), [this, &result](size_t begin, size_t end) {
+        for (size_t n = begin; n < end; ++n) {
+            size_t count = 0;
+            forEachNeighbor(static_cast<int>(n), [&count](int, int) { ++count; });
+            result[n] = { member_ids[n], count };
+        }
+        });
+    return result;
+}
+
+// Get the k partners a member shares the most events with, as (member id, shared events)
+std::vector<std::pair<int, int>> CoParticipationGraph::topPartners(int member_id, size_t k) const {
+    std::vector<std::pair<int, int>> result;
+    auto it = node_of.find(member_id);
+    if (it == node_of.end()) {
+        return result;
+    }
+    forEachNeighbor(it->second, [this, &result](int neighbor, int weight) {
+        result.emplace_back(member_ids[neighbor], weight);
+        });
+    auto by_weight = [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    };
+    if (k < result.size()) {
+        std::partial_sort(result.begin(), result.begin() + k, result.end(), by_weight);
+        result.resize(k);
+    }
+    else {
+        std::sort(result.begin(), result.end(), by_weight);
+    }
+    return result;
+}
+
+// Group members into connected components, each sorted by member id
+// Uses parallel min-label propagation with pointer jumping
+std::vector<std::vector<int>> CoParticipationGraph::connectedComponents() const {
+    const size_t node_count = member_ids.size();
+    std::vector<std::atomic<int>> labels(node_count);
+    for (size_t n = 0; n < node_count; ++n) {
+        labels[n].store(static_cast<int>(n), std::memory_order_relaxed);
+    }
+
+    auto lowerTo = [&labels](int node, int label) {
+        int current = labels[node].load(std::memory_order_relaxed);
+        while (label < current && !labels[node].compare_exchange_weak(current, label, std::memory_order_relaxed)) {
+        }
+        return label < current;
+    };
+
+    std::atomic<bool> changed(true);
+    while (changed.load()) {
+        changed.store(false);
+        parallelFor(node_count, [&](size_t begin, size_t end) {
+            bool local_change = false;
+            for (size_t n = begin; n < end; ++n) {
+                const int node = static_cast<int>(n);
+                forEachNeighbor(node, [&](int neighbor, int) {
+                    const int a = labels[node].load(std::memory_order_relaxed);
+                    const int b = labels[neighbor].load(std::memory_order_relaxed);
+                    if (a < b) {
+                        local_change |= lowerTo(neighbor, a);
+                    }
+                    else if (b < a) {
+                        local_change |= lowerTo(node, b);
+                    }
+                    });
+                // Pointer jumping shortens long label chains
+                const int parent = labels[node].load(std::memory_order_relaxed);
+                local_change |= lowerTo(node, labels[parent].load(std::memory_order_relaxed));
+            }
+            if (local_change) {
+                changed.store(true);
+            }
+            });
+    }
+
+    std::unordered_map<int, size_t> component_of;
+    std::vector<std::vector<int>> components;
+    for (size_t n = 0; n < node_count; ++n) {
+        const int label = labels[n].load(std::memory_order_relaxed);
+        auto it = component_of.find(label);
+        if (it == component_of.end()) {
+            it = component_of.emplace(label, components.size()).first;
+            components.emplace_back();
+        }
+        components[it->second].push_back(member_ids[n]);
+    }
+    for (auto& component : components) {
+        std::sort(component.begin(), component.end());
+    }
+    return components;
+}
@@ -0,0 +1,53 @@
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Event.h"
+
+// Sparse graph of members who took part in the same events
+// Edge weights count shared events. The bulk of the graph lives in a CSR layout
+// (row offsets, sorted neighbor ids, weights); participant changes are recorded as
+// per-node weight deltas on top of it and folded back in once they grow large.
+class CoParticipationGraph {
+private:
+    std::vector<int> member_ids;                 // node -> member id
+    std::unordered_map<int, int> node_of;        // member id -> node
+    std::vector<std::uint32_t> offsets;          // CSR row offsets, base_nodes + 1 entries
+    std::vector<int> neighbors;                  // CSR neighbor nodes, sorted within a row
+    std::vector<std::int32_t> weights;           // CSR weights
+    std::vector<std::unordered_map<int, int>> delta;  // pending weight changes per node
+    size_t delta_entries;
+    size_t thread_count;
+
+    int nodeFor(int member_id);
+    void addWeight(int a, int b, int change);
+    size_t baseNodes() const;
+    void forEachNeighbor(int node, const std::function<void(int, int)>& visit) const;
+    void parallelFor(size_t count, const std::function<void(size_t, size_t)>& body) const;
+
+public:
+    explicit CoParticipationGraph(size_t threads = 0);
+
+    void build(const std::vector<Event*>& events);
+    void addParticipants(const std::vector<int>& existing, const std::vector<int>& joined);
+    void removeParticipants(const std::vector<int>& remaining, const std::vector<int>& left);
+    void removeEvent(const Event& event);
+    void compact();
+
+    size_t nodeCount() const;
+    size_t edgeCount() const;
+    size_t pendingChanges() const;
+    size_t memoryUsage() const;
+    size_t degree(int member_id) const;
+    std::vector<std::pair<int, size_t>> degrees() const;
+    std::vector<std::pair<int, int>> topPartners(int member_id, size_t k) const;
+    std::vector<std::vector<int>> connectedComponents() const;
+
+    static std::vector<int> distinctIds(const Event& event);
+};
+
+#endif // GRAPH_H
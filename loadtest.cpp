@@ -0,0 +1,122 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "Workload.h"
+
+// Mixed-load driver over synthetic clubs
+// Build with the club sources, e.g. g++ -O2 -std=c++17 -pthread loadtest.cpp workload.cpp club.cpp ... -o loadtest,
+// and run as ./loadtest --members 100000 --ops 1000000 --threads 4 --mix 60,10,10,15,5
+// --record FILE saves the generated streams; --replay FILE runs a saved recording instead,
+// and prints the same result digest as the run that recorded it.
+
+namespace {
+    void usage() {
+        std::fprintf(stderr,
+                     "usage: loadtest [--members N] [--coaches N] [--teams N] [--events N] [--venues N]\n"
+                     "                [--skew X] [--ops N] [--mix find,add,remove,signup,schedule]\n"
+                     "                [--threads N] [--seed N] [--record FILE | --replay FILE]\n");
+        std::exit(2);
+    }
+
+    size_t count(const char* text) {
+        return static_cast<size_t>(std::stoull(text));
+    }
+
+    void parseMix(const std::string& text, WorkloadConfig& config) {
+        size_t start = 0;
+        for (size_t i = 0; i < OPERATION_KINDS; ++i) {
+            const size_t comma = text.find(',', start);
+            if ((comma == std::string::npos) != (i + 1 == OPERATION_KINDS)) {
+                throw std::invalid_argument("--mix takes " + std::to_string(OPERATION_KINDS) + " weights");
+            }
+            config.mix[i] = static_cast<unsigned>(std::stoul(text.substr(start, comma - start)));
+            start = comma + 1;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    WorkloadConfig config;
+    std::string record;
+    std::string replay;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string flag = argv[i];
+            if (i + 1 >= argc) {
+                usage();
+            }
+            const char* value = argv[++i];
+            if (flag == "--members") {
+                config.members = count(value);
+            }
+            else if (flag == "--coaches") {
+                config.coaches = count(value);
+            }
+            else if (flag == "--teams") {
+                config.teams = count(value);
+            }
+            else if (flag == "--events") {
+                config.events = count(value);
+            }
+            else if (flag == "--venues") {
+                config.venues = count(value);
+            }
+            else if (flag == "--skew") {
+                config.roster_skew = std::stod(value);
+            }
+            else if (flag == "--ops") {
+                config.operations = count(value);
+            }
+            else if (flag == "--mix") {
+                parseMix(value, config);
+            }
+            else if (flag == "--threads") {
+                config.threads = count(value);
+            }
+            else if (flag == "--seed") {
+                config.seed = std::stoull(value);
+            }
+            else if (flag == "--record") {
+                record = value;
+            }
+            else if (flag == "--replay") {
+                replay = value;
+            }
+            else {
+                usage();
+            }
+        }
+
+        Workload workload;
+        if (!replay.empty()) {
+            std::ifstream in(replay);
+            if (!in) {
+                throw std::invalid_argument("Cannot open " + replay);
+            }
+            workload = Workload::read(in);
+        }
+        else {
+            workload = WorkloadDriver::generate(config);
+        }
+        if (!record.empty()) {
+            std::ofstream out(record);
+            workload.write(out);
+            if (!out) {
+                throw std::invalid_argument("Cannot write " + record);
+            }
+        }
+
+        const auto& shape = workload.config;
+        std::printf("%zu threads x %zu operations, %zu members, %zu teams, %zu events, skew %.2f\n", shape.threads,
+                    shape.operations, shape.members, shape.teams, shape.events, shape.roster_skew);
+        WorkloadDriver::run(workload).print(std::cout);
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "loadtest: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
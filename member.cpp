@@ -1,60 +1,106 @@
-#include "Member.h"
-#include <iostream>
-#include <stdexcept>
-
-// Constructor to initialize a Member object with name, age, role, and ID
-// Throws an exception if name is empty, age is negative, or ID is negative
-Member::Member(const std::string& name, int age, const std::string& role, int id)
-    : name(name), age(age), role(role), id(id) {
-    if (name.empty()) {
-        throw std::invalid_argument("Member name cannot be empty");
-    }
-    if (age < 0) {
-        throw std::invalid_argument("Member age cannot be negative");
-    }
-    if (id < 0) {
-        throw std::invalid_argument("Member ID cannot be negative");
-    }
-}
-
-// Getter for the member's name
-std::string Member::getName() const {
-    return name;
-}
-
-// Getter for the member's age
-int Member::getAge() const {
-    return age;
-}
-
-// Getter for the member's role
-std::string Member::getRole() const {
-    return role;
-}
-
-// Method to update the member's details
-// Throws an exception if new name is empty or new age is negative
-void Member::updateDetails(const std::string& new_name, int new_age) {
-    if (new_name.empty()) {
-        std::cerr << "Error: Name cannot be empty" << std::endl;
-        throw std::invalid_argument("Name cannot be empty");
-    }
-
-    if (new_age < 0) {
-        std::cerr << "Error: Age cannot be negative" << std::endl;
-        throw std::invalid_argument("Age cannot be negative");
-    }
-
-    name = new_name;
-    age = new_age;
-}
-
-// Getter for the member's ID
-int Member::getId() const {
-    return id;
-}
-
-// Equality operator to compare two members
-bool Member::operator==(const Member& other) const {
-    return name == other.name && age == other.age && role == other.role;
-}
+#include "Member.h"
+#include "Club.h"
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+
+// Constructor to initialize a Member object with name, age, role, and ID
+// The strings are taken by value and moved in, so rvalue arguments are never copied
+// Throws an exception if name is empty, age is negative, or ID is negative
+Member::Member(std::string name, int age, std::string role, int id)
+    : name(std::move(name)), age(age), role(std::move(role)), id(id), owner(nullptr) {
+    if (this->name.empty()) {
+        throw std::invalid_argument("Member name cannot be empty");
+    }
+    if (age < 0) {
+        throw std::invalid_argument("Member age cannot be negative");
+    }
+    if (id < 0) {
+        throw std::invalid_argument("Member ID cannot be negative");
+    }
+}
+
+// Copy constructor; the copy belongs to no club
+Member::Member(const Member& other)
+    : name(other.name), age(other.age), role(other.role), id(other.id), owner(nullptr) {}
+
+// Copy assignment; a member held by a club stays in it, re-indexed under the new details
+Member& Member::operator=(const Member& other) {
+    if (this != &other) {
+        if (owner != nullptr) {
+            owner->assignMember(this, other);
+        }
+        else {
+            assign(other);
+        }
+    }
+    return *this;
+}
+
+// Take over every detail of another member except the owning club
+void Member::assign(const Member& other) {
+    name = other.name;
+    age = other.age;
+    role = other.role;
+    id = other.id;
+}
+
+// Getter for the member's name
+std::string Member::getName() const {
+    return name;
+}
+
+// Getter for the member's age
+int Member::getAge() const {
+    return age;
+}
+
+// Getter for the member's role
+std::string Member::getRole() const {
+    return role;
+}
+
+// Method to update the member's details
+// A member held by a club is renamed through the club, so only its own index entries move
+// Throws an exception if new name is empty or new age is negative
+void Member::updateDetails(const std::string& new_name, int new_age) {
+    if (owner != nullptr) {
+        owner->updateMemberDetails(this, new_name, new_age);
+    }
+    else {
+        applyDetails(new_name, new_age);
+    }
+}
+
+// Change the name and age without telling the owning club
+// Throws an exception if new name is empty or new age is negative
+void Member::applyDetails(const std::string& new_name, int new_age) {
+    if (new_name.empty()) {
+        std::cerr << "Error: Name cannot be empty" << std::endl;
+        throw std::invalid_argument("Name cannot be empty");
+    }
+
+    if (new_age < 0) {
+        std::cerr << "Error: Age cannot be negative" << std::endl;
+        throw std::invalid_argument("Age cannot be negative");
+    }
+
+    name = new_name;
+    age = new_age;
+}
+
+// Getter for the member's ID
+int Member::getId() const {
+    return id;
+}
+
+// Equality operator to compare two members
+bool Member::operator==(const Member& other) const {
+    return name == other.name && age == other.age && role == other.role;
+}
+
+// Hash of the fields compared by operator==
+size_t Member::identityHash() const {
+    const size_t seed = std::hash<std::string>()(name) ^ (std::hash<int>()(age) + 0x9e3779b9);
+    return seed ^ (std::hash<std::string>()(role) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
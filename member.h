@@ -1,25 +1,44 @@
-#ifndef MEMBER_H
-#define MEMBER_H
-
-#include <string>
-#include <stdexcept>
-
-class Member {
-private:
-    std::string name;
-    int age;
-    std::string role;
-    int id;  
-
-public:
-    Member(const std::string& name, int age, const std::string& role, int id);
-
-    std::string getName() const;
-    int getAge() const;
-    std::string getRole() const;
-    void updateDetails(const std::string& new_name, int new_age);
-    int getId() const;  
-    bool operator==(const Member& other) const;
-};
-
-#endif // MEMBER_H
+#ifndef MEMBER_H
+#define MEMBER_H
+
+#include <string>
+#include <stdexcept>
+
+class Club;
+
+class Member {
+private:
+    std::string name;
+    int age;
+    std::string role;
+    int id;  
+    Club* owner;  // club whose indexes hold the member, which every change of details goes through
+
+    friend class Club;
+
+    void applyDetails(const std::string& new_name, int new_age);
+    void assign(const Member& other);
+
+public:
+    Member(std::string name, int age, std::string role, int id);
+    Member(const Member& other);
+    Member& operator=(const Member& other);
+
+    std::string getName() const;
+    int getAge() const;
+    std::string getRole() const;
+    void updateDetails(const std::string& new_name, int new_age);
+    int getId() const;  
+    bool operator==(const Member& other) const;
+    size_t identityHash() const;
+};
+
+// A member's fields as plain values, as kept in a member store and sent over the wire
+struct MemberRecord {
+    int id;
+    int age;
+    std::string name;
+    std::string role;
+};
+
+#endif // MEMBER_H
@@ -0,0 +1,263 @@
+#include "MemberStore.h"
+#include <cstring>
+#include <stdexcept>
+#include "Protocol.h"
+
+namespace {
+    // Header page: magic, id tree root, name tree root, member count (u64 as two u32)
+    const char MAGIC[8] = { 'C', 'L', 'U', 'B', 'M', 'E', 'M', '1' };
+    const size_t ID_KEY_BYTES = 8;
+
+    std::string idKey(int id) {
+        return orderedKey(id);
+    }
+
+    std::string nameKey(const std::string& name, int id) {
+        std::string key = name;
+        key.push_back('\0');
+        key += idKey(id);
+        return key;
+    }
+
+    int idOfNameKey(std::string_view key) {
+        int id = 0;
+        for (char byte : key.substr(key.size() - 4)) {
+            id = (id << 8) | static_cast<std::uint8_t>(byte);
+        }
+        return id;
+    }
+
+    // Values use the wire encoding of a member
+    std::string encodeRecord(const MemberRecord& record) {
+        WireWriter out;
+        out.member(record);
+        return std::move(out.bytes());
+    }
+
+    MemberRecord decodeRecord(std::string_view value) {
+        return WireReader(value.data(), value.size()).member();
+    }
+}
+
+// Open the store in a file, creating an empty store if the file does not exist
+// cache_pages is the number of 4 KB pages kept in memory
+// Throws an exception if the file cannot be opened or is not a member store
+MemberStore::MemberStore(const std::string& path, size_t cache_pages)
+    : file(path), pool(file, cache_pages), count(0), revision(0) {
+    if (file.pageCount() == 0) {
+        pool.create();
+        by_id.reset(new BPlusTree(pool, 0));
+        by_name.reset(new BPlusTree(pool, 0));
+        writeHeader();
+        return;
+    }
+    BufferPool::PageRef header = pool.fetch(0);
+    if (std::memcmp(header.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::invalid_argument("File is not a member store: " + path);
+    }
+    WireReader in(header.data() + sizeof(MAGIC), 16);
+    const PageId id_root = in.u32();
+    const PageId name_root = in.u32();
+    count = in.u32();
+    count |= static_cast<std::uint64_t>(in.u32()) << 32;
+    header.release();
+    by_id.reset(new BPlusTree(pool, id_root));
+    by_name.reset(new BPlusTree(pool, name_root));
+}
+
+// Destructor; writes everything back
+// Errors cannot be reported from here, so call flush() first to see them
+MemberStore::~MemberStore() {
+    try {
+        flush();
+    }
+    catch (...) {
+    }
+}
+
+void MemberStore::writeHeader() {
+    WireWriter out;
+    out.u32(by_id->getRoot());
+    out.u32(by_name->getRoot());
+    out.u32(static_cast<std::uint32_t>(count));
+    out.u32(static_cast<std::uint32_t>(count >> 32));
+    BufferPool::PageRef header = pool.fetch(0);
+    char* page = header.mutableData();
+    std::memcpy(page, MAGIC, sizeof(MAGIC));
+    std::memcpy(page + sizeof(MAGIC), out.bytes().data(), out.size());
+}
+
+// Add a member record or replace the one with the same id, keeping the name index in step
+// Returns true if the id is new; storing an unchanged record writes nothing
+// Throws an exception if the record is invalid or too large for a page
+bool MemberStore::put(const MemberRecord& record) {
+    if (record.id < 0 || record.age < 0 || record.name.empty()) {
+        throw std::invalid_argument("Member record is invalid");
+    }
+    const std::string value = encodeRecord(record);
+    if (ID_KEY_BYTES + value.size() > BPlusTree::MAX_ENTRY_BYTES) {
+        throw std::invalid_argument("Member record is too large for the store");
+    }
+
+    const std::string key = idKey(record.id);
+    std::string old_value;
+    const bool exists = by_id->find(key, old_value);
+    if (exists && old_value == value) {
+        return false;
+    }
+    if (exists) {
+        const MemberRecord old = decodeRecord(old_value);
+        if (old.name != record.name) {
+            by_name->erase(nameKey(old.name, record.id));
+        }
+    }
+    by_id->insert(key, value);
+    by_name->insert(nameKey(record.name, record.id), {});
+    if (!exists) {
+        ++count;
+    }
+    ++revision;
+    return !exists;
+}
+
+// Remove the record with an id
+// Returns false if there is none
+bool MemberStore::erase(int id) {
+    MemberRecord old;
+    if (!find(id, old)) {
+        return false;
+    }
+    by_id->erase(idKey(id));
+    by_name->erase(nameKey(old.name, id));
+    --count;
+    ++revision;
+    return true;
+}
+
+// Look up the record with an id
+// Returns false if there is none
+bool MemberStore::find(int id, MemberRecord& record) const {
+    std::string value;
+    if (!by_id->find(idKey(id), value)) {
+        return false;
+    }
+    record = decodeRecord(value);
+    return true;
+}
+
+// Look up a record by exact name; of several with the name, the lowest id wins
+// Returns false if there is none
+bool MemberStore::findByName(const std::string& name, MemberRecord& record) const {
+    const std::string prefix = name + '\0';
+    int id = -1;
+    by_name->forEachFrom(prefix, [&](std::string_view key, std::string_view) {
+        if (key.size() == prefix.size() + ID_KEY_BYTES && key.compare(0, prefix.size(), prefix) == 0) {
+            id = idOfNameKey(key);
+        }
+        return false;
+        });
+    return id >= 0 && find(id, record);
+}
+
+// Get every record with exactly the given name, by id
+std::vector<MemberRecord> MemberStore::findAllByName(const std::string& name) const {
+    const std::string prefix = name + '\0';
+    std::vector<int> ids;
+    by_name->forEachFrom(prefix, [&](std::string_view key, std::string_view) {
+        if (key.size() != prefix.size() + ID_KEY_BYTES || key.compare(0, prefix.size(), prefix) != 0) {
+            return false;
+        }
+        ids.push_back(idOfNameKey(key));
+        return true;
+        });
+    std::vector<MemberRecord> records;
+    for (int id : ids) {
+        MemberRecord record;
+        if (find(id, record)) {
+            records.push_back(std::move(record));
+        }
+    }
+    return records;
+}
+
+bool MemberStore::contains(int id) const {
+    std::string value;
+    return by_id->find(idKey(id), value);
+}
+
+// Get up to limit records after the cursor, by id or by name (ties by id)
+// Cursors hold the tree key of the last returned record, so they stay valid while the
+// store changes, as with the in-memory scans
+// Throws an exception if the order is not supported
+MemberRecordPage MemberStore::scan(ScanOrder order, const ScanCursor& cursor, size_t limit) const {
+    if (order != ScanOrder::Id && order != ScanOrder::Name) {
+        throw std::invalid_argument("Scan order is not supported for this collection");
+    }
+    MemberRecordPage page{ {}, cursor };
+    if (cursor.finished) {
+        return page;
+    }
+    page.next.finished = true;
+    std::vector<int> ids;
+    const BPlusTree& tree = order == ScanOrder::Id ? *by_id : *by_name;
+    tree.forEachFrom(cursor.key, [&](std::string_view key, std::string_view value) {
+        if (key == cursor.key) {
+            return true;
+        }
+        if (page.records.size() + ids.size() == limit) {
+            page.next.finished = false;
+            return false;
+        }
+        if (order == ScanOrder::Id) {
+            page.records.push_back(decodeRecord(value));
+        }
+        else {
+            ids.push_back(idOfNameKey(key));
+        }
+        page.next.key.assign(key);
+        return true;
+        });
+    for (int id : ids) {
+        MemberRecord record;
+        if (find(id, record)) {
+            page.records.push_back(std::move(record));
+        }
+    }
+    return page;
+}
+
+// Get the number of stored members
+size_t MemberStore::size() const {
+    return static_cast<size_t>(count);
+}
+
+// Get a counter bumped by every change, for caches of lookup results
+std::uint64_t MemberStore::getRevision() const {
+    return revision;
+}
+
+// Write every change back to the file and sync it
+// Throws an exception if a write fails
+void MemberStore::flush() {
+    writeHeader();
+    pool.flush();
+}
+
+// Flush, then drop the cached pages here and in the operating system, so the next
+// lookups read from disk as after a restart
+// Throws an exception if a write fails
+void MemberStore::dropCache() {
+    writeHeader();
+    pool.evictAll();
+    file.dropOsCache();
+}
+
+// Get the member count, file size and buffer pool figures
+MemberStoreStats MemberStore::getStats() const {
+    return { size(), file.pageCount(), pool.getStats() };
+}
+
+// Get the approximate heap memory used by the cached pages in bytes
+size_t MemberStore::memoryUsage() const {
+    return pool.memoryUsage();
+}
@@ -0,0 +1,65 @@
+#ifndef MEMBERSTORE_H
+#define MEMBERSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "BTree.h"
+#include "Member.h"
+#include "Scan.h"
+
+// One page of a member store scan and the cursor to continue from
+struct MemberRecordPage {
+    std::vector<MemberRecord> records;
+    ScanCursor next;
+};
+
+// Size and cache figures of a member store
+struct MemberStoreStats {
+    size_t members;
+    size_t file_pages;
+    BufferStats cache;
+};
+
+// Members kept on disk in a page file, for registries too large to hold in memory
+// Records live in a B+tree keyed by id, and a second tree orders them by name; only the
+// pages in the buffer pool take memory, so hot lookups stay in memory while the rest of
+// the registry stays on disk. Page 0 of the file holds the tree roots and the count.
+// Changes are durable once flush() returns or the store is destroyed.
+class MemberStore {
+private:
+    PageFile file;
+    BufferPool pool;
+    std::unique_ptr<BPlusTree> by_id;
+    std::unique_ptr<BPlusTree> by_name;  // name, a zero byte and the id key, with empty values
+    std::uint64_t count;
+    std::uint64_t revision;
+
+    void writeHeader();
+
+public:
+    MemberStore(const std::string& path, size_t cache_pages = 1024);
+    ~MemberStore();
+
+    MemberStore(const MemberStore&) = delete;
+    MemberStore& operator=(const MemberStore&) = delete;
+
+    bool put(const MemberRecord& record);
+    bool erase(int id);
+    bool find(int id, MemberRecord& record) const;
+    bool findByName(const std::string& name, MemberRecord& record) const;
+    std::vector<MemberRecord> findAllByName(const std::string& name) const;
+    bool contains(int id) const;
+    MemberRecordPage scan(ScanOrder order, const ScanCursor& cursor, size_t limit) const;
+    size_t size() const;
+    std::uint64_t getRevision() const;
+
+    void flush();
+    void dropCache();
+    MemberStoreStats getStats() const;
+    size_t memoryUsage() const;
+};
+
+#endif // MEMBERSTORE_H
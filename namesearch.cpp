@@ -0,0 +1,501 @@
+#include "NameSearch.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+    using PatternMasks = std::array<std::uint64_t, 256>;
+
+    // Bit i of masks[c] is set when pattern[i] == c
+    void buildMasks(PatternMasks& masks, const std::string& pattern) {
+        masks.fill(0);
+        for (size_t i = 0; i < pattern.size(); ++i) {
+            masks[static_cast<unsigned char>(pattern[i])] |= std::uint64_t(1) << i;
+        }
+    }
+
+    // Myers/Hyyro bit-parallel Levenshtein distance for patterns of 1..64 characters
+    // Each text character updates the whole DP column in a few word operations; gives up
+    // with max_distance + 1 once the distance can no longer come back under the bound
+    int myersDistance(const PatternMasks& masks, size_t pattern_length, const std::string& text, int max_distance) {
+        const std::uint64_t high = std::uint64_t(1) << (pattern_length - 1);
+        std::uint64_t pv = ~std::uint64_t(0);
+        std::uint64_t mv = 0;
+        int score = static_cast<int>(pattern_length);
+        int remaining = static_cast<int>(text.size());
+        for (unsigned char c : text) {
+            const std::uint64_t eq = masks[c];
+            const std::uint64_t xv = eq | mv;
+            const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            std::uint64_t ph = mv | ~(xh | pv);
+            std::uint64_t mh = pv & xh;
+            if (ph & high) {
+                ++score;
+            }
+            else if (mh & high) {
+                --score;
+            }
+            ph = (ph << 1) | 1;
+            mh <<= 1;
+            pv = mh | ~(xv | ph);
+            mv = ph & xv;
+            if (score - --remaining > max_distance) {
+                return max_distance + 1;
+            }
+        }
+        return score;
+    }
+
+    // Row-by-row Levenshtein distance for patterns longer than a machine word
+    int dynamicDistance(const std::string& pattern, const std::string& text, int max_distance) {
+        std::vector<int> row(text.size() + 1);
+        for (size_t j = 0; j <= text.size(); ++j) {
+            row[j] = static_cast<int>(j);
+        }
+        for (size_t i = 1; i <= pattern.size(); ++i) {
+            int diagonal = row[0];
+            row[0] = static_cast<int>(i);
+            int best = row[0];
+            for (size_t j = 1; j <= text.size(); ++j) {
+                const int above = row[j];
+                row[j] = std::min({ above + 1, row[j - 1] + 1, diagonal + (pattern[i - 1] != text[j - 1]) });
+                diagonal = above;
+                best = std::min(best, row[j]);
+            }
+            if (best > max_distance) {
+                return max_distance + 1;
+            }
+        }
+        return std::min(row.back(), max_distance + 1);
+    }
+
+    // Trigrams of a normalized name padded at both ends, in position order
+    std::vector<std::uint32_t> positionalTrigrams(const std::string& normalized) {
+        const std::string padded = "$$" + normalized + "$$";
+        std::vector<std::uint32_t> grams;
+        grams.reserve(padded.size() - 2);
+        for (size_t i = 0; i + 2 < padded.size(); ++i) {
+            grams.push_back((static_cast<std::uint32_t>(static_cast<unsigned char>(padded[i])) << 16) |
+                            (static_cast<std::uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8) |
+                            static_cast<unsigned char>(padded[i + 2]));
+        }
+        return grams;
+    }
+
+    int boundedDistance(const PatternMasks& masks, const std::string& pattern, const std::string& text, int max_distance) {
+        const int length_gap = static_cast<int>(pattern.size()) - static_cast<int>(text.size());
+        if (length_gap > max_distance || -length_gap > max_distance) {
+            return max_distance + 1;
+        }
+        if (pattern.empty()) {
+            return static_cast<int>(text.size());
+        }
+        if (pattern.size() > 64) {
+            return dynamicDistance(pattern, text, max_distance);
+        }
+        return std::min(myersDistance(masks, pattern.size(), text, max_distance), max_distance + 1);
+    }
+}
+
+// Constructor for an empty index
+TrigramIndex::TrigramIndex() : query_stamp(0), live(0) {}
+
+// Lowercase a name so searches ignore case
+std::string TrigramIndex::normalize(const std::string& name) {
+    std::string result = name;
+    for (auto& c : result) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return result;
+}
+
+// Get the distinct trigrams of a normalized name, padded at both ends
+std::vector<std::uint32_t> TrigramIndex::trigramsOf(const std::string& normalized) {
+    std::vector<std::uint32_t> grams = positionalTrigrams(normalized);
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+    return grams;
+}
+
+// Get the posting list key of a trigram in names of the given length
+std::uint64_t TrigramIndex::postingKey(std::uint32_t gram, size_t length) {
+    return (static_cast<std::uint64_t>(gram) << 32) | static_cast<std::uint32_t>(length);
+}
+
+// Add a slot to the posting lists of its name's trigrams
+void TrigramIndex::link(std::uint32_t slot) {
+    for (auto gram : trigramsOf(names[slot])) {
+        postings[postingKey(gram, names[slot].size())].push_back(slot);
+    }
+}
+
+// Remove a slot from the posting lists of its name's trigrams
+void TrigramIndex::unlink(std::uint32_t slot) {
+    for (auto gram : trigramsOf(names[slot])) {
+        auto it = postings.find(postingKey(gram, names[slot].size()));
+        if (it == postings.end()) {
+            continue;
+        }
+        auto& list = it->second;
+        auto position = std::find(list.begin(), list.end(), slot);
+        if (position != list.end()) {
+            *position = list.back();
+            list.pop_back();
+        }
+        if (list.empty()) {
+            postings.erase(it);
+        }
+    }
+}
+
+// Levenshtein distance between two strings, or max_distance + 1 if it is larger
+int TrigramIndex::editDistance(const std::string& pattern, const std::string& text, int max_distance) {
+    PatternMasks masks;
+    buildMasks(masks, pattern);
+    return boundedDistance(masks, pattern, text, max_distance);
+}
+
+// Index a name and return its slot
+// Throws an exception if the name is empty
+std::uint32_t TrigramIndex::insert(const std::string& name) {
+    if (name.empty()) {
+        throw std::invalid_argument("Name cannot be empty");
+    }
+    std::uint32_t slot;
+    if (!free_slots.empty()) {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    }
+    else {
+        slot = static_cast<std::uint32_t>(names.size());
+        names.emplace_back();
+        lengths.push_back(0);
+    }
+    names[slot] = normalize(name);
+    lengths[slot] = static_cast<std::uint16_t>(std::min<size_t>(names[slot].size(), UINT16_MAX));
+    link(slot);
+    ++live;
+    return slot;
+}
+
+// Remove the name in a slot; the slot may be handed out again
+void TrigramIndex::erase(std::uint32_t slot) {
+    if (slot >= names.size() || names[slot].empty()) {
+        return;
+    }
+    unlink(slot);
+    names[slot].clear();
+    free_slots.push_back(slot);
+    --live;
+}
+
+// Free many slots at once
+// Each posting list holding one of them is filtered in a single pass, instead of being
+// searched once per slot. Large batches simply filter every list.
+void TrigramIndex::erase(const std::vector<std::uint32_t>& slots) {
+    std::vector<bool> doomed(names.size(), false);
+    for (auto slot : slots) {
+        if (slot < names.size() && !names[slot].empty()) {
+            doomed[slot] = true;
+        }
+    }
+    auto filter = [&doomed](std::vector<std::uint32_t>& list) {
+        list.erase(std::remove_if(list.begin(), list.end(), [&doomed](std::uint32_t slot) {
+            return doomed[slot];
+            }), list.end());
+    };
+
+    if (slots.size() * 4 > postings.size()) {
+        for (auto it = postings.begin(); it != postings.end();) {
+            filter(it->second);
+            it = it->second.empty() ? postings.erase(it) : std::next(it);
+        }
+    }
+    else {
+        std::vector<std::uint64_t> keys;
+        for (auto slot : slots) {
+            if (slot < names.size() && doomed[slot]) {
+                for (auto gram : trigramsOf(names[slot])) {
+                    keys.push_back(postingKey(gram, names[slot].size()));
+                }
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        for (auto key : keys) {
+            auto it = postings.find(key);
+            if (it != postings.end()) {
+                filter(it->second);
+                if (it->second.empty()) {
+                    postings.erase(it);
+                }
+            }
+        }
+    }
+    for (std::uint32_t slot = 0; slot < doomed.size(); ++slot) {
+        if (doomed[slot]) {
+            names[slot].clear();
+            free_slots.push_back(slot);
+            --live;
+        }
+    }
+}
+
+// Replace the name in a slot, touching only the trigrams that changed
+// Throws an exception if the name is empty
+void TrigramIndex::rename(std::uint32_t slot, const std::string& name) {
+    if (name.empty()) {
+        throw std::invalid_argument("Name cannot be empty");
+    }
+    if (slot >= names.size() || names[slot].empty()) {
+        return;
+    }
+    std::string normalized = normalize(name);
+    if (normalized == names[slot]) {
+        return;
+    }
+    if (normalized.size() != names[slot].size()) {
+        unlink(slot);
+        names[slot] = std::move(normalized);
+        lengths[slot] = static_cast<std::uint16_t>(std::min<size_t>(names[slot].size(), UINT16_MAX));
+        link(slot);
+        return;
+    }
+    const size_t length = normalized.size();
+    const auto old_grams = trigramsOf(names[slot]);
+    const auto new_grams = trigramsOf(normalized);
+    std::vector<std::uint32_t> removed;
+    std::vector<std::uint32_t> added;
+    std::set_difference(old_grams.begin(), old_grams.end(), new_grams.begin(), new_grams.end(), std::back_inserter(removed));
+    std::set_difference(new_grams.begin(), new_grams.end(), old_grams.begin(), old_grams.end(), std::back_inserter(added));
+    for (auto gram : removed) {
+        auto& list = postings[postingKey(gram, length)];
+        auto position = std::find(list.begin(), list.end(), slot);
+        if (position != list.end()) {
+            *position = list.back();
+            list.pop_back();
+        }
+        if (list.empty()) {
+            postings.erase(postingKey(gram, length));
+        }
+    }
+    for (auto gram : added) {
+        postings[postingKey(gram, length)].push_back(slot);
+    }
+    names[slot] = std::move(normalized);
+}
+
+// Get up to limit slots within max_distance edits of the query, closest first
+// Throws an exception if the distance bound is negative
+std::vector<std::pair<std::uint32_t, int>> TrigramIndex::search(const std::string& query, int max_distance, size_t limit) const {
+    if (max_distance < 0) {
+        throw std::invalid_argument("Edit distance bound cannot be negative");
+    }
+    std::vector<std::pair<std::uint32_t, int>> hits;
+    const std::string pattern = normalize(query);
+    if (pattern.empty() || limit == 0) {
+        return hits;
+    }
+
+    PatternMasks masks;
+    buildMasks(masks, pattern);
+    if (marks.size() < names.size()) {
+        marks.resize(names.size(), 0);
+    }
+    if (++query_stamp == (1u << 24)) {
+        std::fill(marks.begin(), marks.end(), 0);
+        query_stamp = 1;
+    }
+    const std::uint32_t stamp = query_stamp << 8;
+    const int pattern_length = static_cast<int>(pattern.size());
+    auto lengthFits = [&](std::uint32_t slot) {
+        const int gap = static_cast<int>(lengths[slot]) - pattern_length;
+        return gap <= max_distance && -gap <= max_distance;
+    };
+    auto verify = [&](std::uint32_t slot) {
+        const int distance = boundedDistance(masks, pattern, names[slot], max_distance);
+        if (distance <= max_distance) {
+            hits.emplace_back(slot, distance);
+        }
+    };
+
+    const auto positional = positionalTrigrams(pattern);
+    const size_t bound = static_cast<size_t>(max_distance);
+    if (positional.size() >= 3 * bound + 1) {
+        // Posting lists of each distinct query trigram, over the name lengths within reach
+        std::vector<std::uint32_t> grams = positional;
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+        std::vector<size_t> list_size(grams.size(), 0);
+        std::vector<std::vector<const std::vector<std::uint32_t>*>> lists(grams.size());
+        const size_t shortest = pattern.size() > bound ? pattern.size() - bound : 1;
+        for (size_t g = 0; g < grams.size(); ++g) {
+            for (size_t length = shortest; length <= pattern.size() + bound; ++length) {
+                auto it = postings.find(postingKey(grams[g], length));
+                if (it != postings.end()) {
+                    list_size[g] += it->second.size();
+                    lists[g].push_back(&it->second);
+                }
+            }
+        }
+        auto gramAt = [&grams, &positional](size_t position) {
+            return static_cast<size_t>(std::lower_bound(grams.begin(), grams.end(), positional[position]) - grams.begin());
+        };
+
+        // One edit touches at most three consecutive trigram positions, so of
+        // max_distance + 1 trigrams at least 3 positions apart every match keeps one.
+        // Pick the cheapest such set: best[k][p] is the cheapest k + 1 picks ending at p.
+        const size_t positions = positional.size();
+        const size_t picks = bound + 1;
+        const size_t unreachable = SIZE_MAX;
+        std::vector<std::vector<size_t>> best(picks, std::vector<size_t>(positions, unreachable));
+        std::vector<std::vector<size_t>> previous(picks, std::vector<size_t>(positions, 0));
+        for (size_t p = 0; p < positions; ++p) {
+            best[0][p] = list_size[gramAt(p)];
+        }
+        for (size_t k = 1; k < picks; ++k) {
+            size_t cheapest = unreachable;
+            size_t cheapest_at = 0;
+            for (size_t p = 3; p < positions; ++p) {
+                if (best[k - 1][p - 3] < cheapest) {
+                    cheapest = best[k - 1][p - 3];
+                    cheapest_at = p - 3;
+                }
+                if (cheapest != unreachable) {
+                    best[k][p] = cheapest + list_size[gramAt(p)];
+                    previous[k][p] = cheapest_at;
+                }
+            }
+        }
+        size_t last = 0;
+        for (size_t p = 1; p < positions; ++p) {
+            if (best[picks - 1][p] < best[picks - 1][last]) {
+                last = p;
+            }
+        }
+        std::vector<bool> chosen(grams.size(), false);
+        size_t cost = 0;
+        for (size_t k = picks; k-- > 0;) {
+            const size_t g = gramAt(last);
+            if (!chosen[g]) {
+                chosen[g] = true;
+                cost += list_size[g];
+            }
+            last = previous[k][last];
+        }
+
+        // Candidates come from the chosen lists only
+        std::vector<std::uint32_t> candidates;
+        size_t counted = 0;
+        for (size_t g = 0; g < grams.size(); ++g) {
+            if (!chosen[g]) {
+                continue;
+            }
+            ++counted;
+            for (auto list : lists[g]) {
+                for (auto slot : *list) {
+                    std::uint32_t& mark = marks[slot];
+                    if ((mark & ~0xffu) != stamp) {
+                        mark = stamp;
+                        candidates.push_back(slot);
+                    }
+                    ++mark;
+                }
+            }
+        }
+
+        // A match also shares all but 3 * max_distance of the distinct query trigrams;
+        // counting a few more cheap lists lets that bound reject candidates early
+        std::vector<size_t> others;
+        for (size_t g = 0; g < grams.size(); ++g) {
+            if (!chosen[g]) {
+                others.push_back(g);
+            }
+        }
+        std::sort(others.begin(), others.end(), [&list_size](size_t a, size_t b) {
+            return list_size[a] < list_size[b];
+            });
+        const size_t budget = 8 * cost;  // scanning is much cheaper than verifying a candidate
+        for (size_t g : others) {
+            if (cost + list_size[g] > budget) {
+                break;
+            }
+            cost += list_size[g];
+            ++counted;
+            for (auto list : lists[g]) {
+                for (auto slot : *list) {
+                    std::uint32_t& mark = marks[slot];
+                    if ((mark & ~0xffu) == stamp && (mark & 0xffu) != 0xffu) {
+                        ++mark;
+                    }
+                }
+            }
+        }
+        const size_t required = counted > 3 * bound ? counted - 3 * bound : 0;
+        for (auto slot : candidates) {
+            if ((marks[slot] & 0xffu) >= required) {
+                verify(slot);
+            }
+        }
+    }
+    else {
+        for (std::uint32_t slot = 0; slot < names.size(); ++slot) {
+            if (!names[slot].empty() && lengthFits(slot)) {
+                verify(slot);
+            }
+        }
+    }
+
+    auto closer = [this](const std::pair<std::uint32_t, int>& a, const std::pair<std::uint32_t, int>& b) {
+        if (a.second != b.second) return a.second < b.second;
+        return names[a.first] < names[b.first];
+    };
+    if (hits.size() > limit) {
+        std::partial_sort(hits.begin(), hits.begin() + limit, hits.end(), closer);
+        hits.resize(limit);
+    }
+    else {
+        std::sort(hits.begin(), hits.end(), closer);
+    }
+    return hits;
+}
+
+// Get the number of indexed names
+size_t TrigramIndex::size() const {
+    return live;
+}
+
+// Make room for count names so inserting up to that many never reallocates the slot arrays
+// Free slots are reused first, so count slots always suffice
+void TrigramIndex::reserve(size_t count) {
+    names.reserve(count);
+    lengths.reserve(count);
+}
+
+// Get the approximate heap memory used by the index in bytes
+size_t TrigramIndex::memoryUsage() const {
+    size_t total = names.capacity() * sizeof(std::string) + free_slots.capacity() * sizeof(std::uint32_t) +
+                   lengths.capacity() * sizeof(std::uint16_t) + marks.capacity() * sizeof(std::uint32_t);
+    for (const auto& name : names) {
+        total += name.capacity() > 15 ? name.capacity() + 1 : 0;
+    }
+    total += postings.bucket_count() * sizeof(void*);
+    for (const auto& entry : postings) {
+        total += sizeof(entry) + sizeof(void*) + entry.second.capacity() * sizeof(std::uint32_t);
+    }
+    return total;
+}
+
+// Release spare capacity left behind by removals and renames
+void TrigramIndex::shrinkToFit() {
+    for (auto& name : names) {
+        name.shrink_to_fit();
+    }
+    for (auto& entry : postings) {
+        entry.second.shrink_to_fit();
+    }
+    postings.rehash(0);
+    free_slots.shrink_to_fit();
+}
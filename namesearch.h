@@ -0,0 +1,146 @@
+#ifndef NAMESEARCH_H
+#define NAMESEARCH_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Trigram index over names with bounded edit-distance lookup
+// Names are lowercased and padded ("$$john$$") before being split into trigrams, and
+// each posting list holds the slots of the names of one length containing a trigram,
+// so a query only reads the lists of lengths within its distance bound. One edit
+// touches at most three consecutive trigram positions, so of any d + 1 query trigrams
+// spaced three apart a match keeps at least one: the cheapest such lists give the
+// candidates. Further lists are counted (a match keeps all but 3d distinct trigrams)
+// to reject candidates before Myers' bit-parallel edit distance verifies the rest.
+// Queries too short for this fall back to checking every name of a compatible length.
+class TrigramIndex {
+private:
+    std::vector<std::string> names;  // normalized, empty for free slots
+    std::vector<std::uint32_t> free_slots;
+    std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> postings;  // (trigram, name length) -> slots
+    std::vector<std::uint16_t> lengths;       // per-slot name length, saturated, for a cache-friendly length filter
+    mutable std::vector<std::uint32_t> marks;  // per slot: query stamp << 8 | shared trigram count
+    mutable std::uint32_t query_stamp;         // 24 bits
+    size_t live;
+
+    static std::vector<std::uint32_t> trigramsOf(const std::string& normalized);
+    static std::uint64_t postingKey(std::uint32_t gram, size_t length);
+    void link(std::uint32_t slot);
+    void unlink(std::uint32_t slot);
+
+public:
+    TrigramIndex();
+
+    static std::string normalize(const std::string& name);
+    static int editDistance(const std::string& pattern, const std::string& text, int max_distance);
+
+    std::uint32_t insert(const std::string& name);
+    void erase(std::uint32_t slot);
+    void erase(const std::vector<std::uint32_t>& slots);
+    void rename(std::uint32_t slot, const std::string& name);
+    std::vector<std::pair<std::uint32_t, int>> search(const std::string& query, int max_distance, size_t limit) const;
+    size_t size() const;
+    void reserve(size_t count);
+    size_t memoryUsage() const;
+    void shrinkToFit();
+};
+
+// A fuzzy search hit and its edit distance from the query
+template <typename T>
+struct FuzzyMatch {
+    T* item;
+    int distance;
+};
+
+// Typed front end of TrigramIndex for objects with getName()
+template <typename T>
+class FuzzyNameIndex {
+private:
+    TrigramIndex index;
+    std::vector<T*> items;  // slot -> object
+    std::unordered_map<const T*, std::uint32_t> slot_of;
+
+public:
+    // Index an object under its current name
+    void add(T* item) {
+        if (slot_of.count(item) != 0) {
+            return;
+        }
+        const std::uint32_t slot = index.insert(item->getName());
+        if (slot >= items.size()) {
+            items.resize(slot + 1, nullptr);
+        }
+        items[slot] = item;
+        slot_of.emplace(item, slot);
+    }
+
+    // Stop indexing an object
+    void remove(const T* item) {
+        auto it = slot_of.find(item);
+        if (it == slot_of.end()) {
+            return;
+        }
+        index.erase(it->second);
+        items[it->second] = nullptr;
+        slot_of.erase(it);
+    }
+
+    // Stop indexing many objects, sweeping each affected posting list once
+    void remove(const std::vector<const T*>& doomed) {
+        std::vector<std::uint32_t> slots;
+        for (auto item : doomed) {
+            auto it = slot_of.find(item);
+            if (it != slot_of.end()) {
+                slots.push_back(it->second);
+                items[it->second] = nullptr;
+                slot_of.erase(it);
+            }
+        }
+        index.erase(slots);
+    }
+
+    // Re-index an object after its name changed
+    void rename(const T* item) {
+        auto it = slot_of.find(item);
+        if (it != slot_of.end()) {
+            index.rename(it->second, items[it->second]->getName());
+        }
+    }
+
+    // Get up to limit objects within max_distance edits of the query, closest first
+    std::vector<FuzzyMatch<T>> search(const std::string& query, int max_distance, size_t limit) const {
+        std::vector<FuzzyMatch<T>> result;
+        for (const auto& hit : index.search(query, max_distance, limit)) {
+            result.push_back({ items[hit.first], hit.second });
+        }
+        return result;
+    }
+
+    size_t size() const {
+        return slot_of.size();
+    }
+
+    // Make room for count objects so adding up to that many never rehashes
+    void reserve(size_t count) {
+        index.reserve(count);
+        items.reserve(count);
+        slot_of.reserve(count);
+    }
+
+    // Get the approximate heap memory used by the index in bytes
+    size_t memoryUsage() const {
+        return index.memoryUsage() + items.capacity() * sizeof(T*) + slot_of.bucket_count() * sizeof(void*) +
+               slot_of.size() * (sizeof(std::pair<const T* const, std::uint32_t>) + sizeof(void*));
+    }
+
+    void shrinkToFit() {
+        index.shrinkToFit();
+        items.shrink_to_fit();
+        slot_of.rehash(0);
+    }
+};
+
+#endif // NAMESEARCH_H
@@ -0,0 +1,360 @@
+#include "Partition.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+    const int MAX_TRACKED_AGE = 127;
+
+    // Relative weights of the cost terms
+    const double SIZE_WEIGHT = 10.0;
+    const double AGE_WEIGHT = 1.0;
+    const double SPREAD_WEIGHT = 5.0;
+    const double ROLE_WEIGHT = 2.0;
+    const double QUOTA_WEIGHT = 50.0;
+    const double PAST_WEIGHT = 1.0;
+    const double APART_WEIGHT = 100.0;
+
+    int clampAge(int age) {
+        return std::min(age, MAX_TRACKED_AGE);
+    }
+
+    int findRoot(std::vector<int>& parent, int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+}
+
+// Constructor to validate the constraints
+// Throws an exception if the team count or sport type are invalid
+RosterPartitioner::RosterPartitioner(Club& club, const PartitionConstraints& constraints)
+    : club(club), constraints(constraints), role_types(0), past_team_types(0), target_size(0), mean_age(0), total_cost(0) {
+    if (constraints.team_count <= 0) {
+        throw std::invalid_argument("Team count must be positive");
+    }
+    if (constraints.sport_type.empty()) {
+        throw std::invalid_argument("Sport type cannot be empty");
+    }
+    if (constraints.first_team_id <= 0) {
+        throw std::invalid_argument("Team ID is invalid");
+    }
+}
+
+// Turn the members and constraints into dense arrays and keep-together blocks
+void RosterPartitioner::prepare(const std::vector<Member*>& input) {
+    members.clear();
+    std::unordered_map<const Member*, int> index_of;
+    for (auto member : input) {
+        if (member == nullptr) {
+            throw std::invalid_argument("Member cannot be null");
+        }
+        if (index_of.emplace(member, static_cast<int>(members.size())).second) {
+            members.push_back(member);
+        }
+    }
+    const size_t count = members.size();
+
+    // Dense role ids, quotas and expected share of each role per team
+    std::unordered_map<std::string, int> role_ids;
+    roles.assign(count, 0);
+    ages.assign(count, 0);
+    long long age_total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        auto it = role_ids.emplace(members[i]->getRole(), static_cast<int>(role_ids.size())).first;
+        roles[i] = it->second;
+        ages[i] = members[i]->getAge();
+        age_total += ages[i];
+    }
+    for (const auto& quota : constraints.role_quotas) {
+        role_ids.emplace(quota.first, static_cast<int>(role_ids.size()));
+    }
+    role_types = role_ids.size();
+    role_quota.assign(role_types, 0);
+    for (const auto& quota : constraints.role_quotas) {
+        role_quota[role_ids[quota.first]] = quota.second;
+    }
+    role_share.assign(role_types, 0);
+    for (size_t i = 0; i < count; ++i) {
+        role_share[roles[i]] += 1.0 / constraints.team_count;
+    }
+    target_size = static_cast<double>(count) / constraints.team_count;
+    mean_age = count > 0 ? static_cast<double>(age_total) / count : 0;
+
+    // Current club team of each member, to spread old teams across new ones
+    past_teams.assign(count, -1);
+    past_team_types = 0;
+    if (constraints.spread_past_teams) {
+        for (auto team : club.getTeams()) {
+            const int past = static_cast<int>(past_team_types);
+            bool used = false;
+            for (auto member : team->getMembers()) {
+                auto it = index_of.find(member);
+                if (it != index_of.end() && past_teams[it->second] < 0) {
+                    past_teams[it->second] = past;
+                    used = true;
+                }
+            }
+            past_team_types += used;
+        }
+    }
+
+    apart.assign(count, {});
+    for (const auto& pair : constraints.keep_apart) {
+        auto a = index_of.find(pair.first);
+        auto b = index_of.find(pair.second);
+        if (a != index_of.end() && b != index_of.end() && a->second != b->second) {
+            apart[a->second].push_back(b->second);
+            apart[b->second].push_back(a->second);
+        }
+    }
+
+    // Keep-together pairs become blocks via union-find
+    std::vector<int> parent(count);
+    std::iota(parent.begin(), parent.end(), 0);
+    for (const auto& pair : constraints.keep_together) {
+        auto a = index_of.find(pair.first);
+        auto b = index_of.find(pair.second);
+        if (a != index_of.end() && b != index_of.end()) {
+            parent[findRoot(parent, a->second)] = findRoot(parent, b->second);
+        }
+    }
+    std::unordered_map<int, int> block_of_root;
+    blocks.clear();
+    for (size_t i = 0; i < count; ++i) {
+        const int root = findRoot(parent, static_cast<int>(i));
+        auto it = block_of_root.emplace(root, static_cast<int>(blocks.size())).first;
+        if (it->second == static_cast<int>(blocks.size())) {
+            blocks.emplace_back();
+        }
+        blocks[it->second].push_back(static_cast<int>(i));
+    }
+}
+
+// Cost of one team from its running totals
+double RosterPartitioner::teamCost(const TeamState& team) const {
+    double cost = 0;
+    const double size_gap = team.size - target_size;
+    cost += SIZE_WEIGHT * size_gap * size_gap;
+    if (team.size > 0) {
+        const double age_gap = static_cast<double>(team.age_sum) / team.size - mean_age;
+        cost += AGE_WEIGHT * age_gap * age_gap * team.size;
+        if (constraints.max_age_spread > 0 && team.max_age - team.min_age > constraints.max_age_spread) {
+            cost += SPREAD_WEIGHT * (team.max_age - team.min_age - constraints.max_age_spread);
+        }
+    }
+    for (size_t r = 0; r < role_types; ++r) {
+        const double role_gap = team.role_count[r] - role_share[r];
+        cost += ROLE_WEIGHT * role_gap * role_gap;
+        if (team.role_count[r] < role_quota[r]) {
+            const double missing = role_quota[r] - team.role_count[r];
+            cost += QUOTA_WEIGHT * missing * missing;
+        }
+    }
+    cost += PAST_WEIGHT * static_cast<double>(team.past_pairs);
+    cost += APART_WEIGHT * static_cast<double>(team.apart_pairs);
+    return cost;
+}
+
+// Update a team's running totals for a member joining it
+void RosterPartitioner::addMember(TeamState& team, int team_index, int member) {
+    const int age = clampAge(ages[member]);
+    if (team.size == 0 || age < team.min_age) {
+        team.min_age = age;
+    }
+    if (team.size == 0 || age > team.max_age) {
+        team.max_age = age;
+    }
+    ++team.size;
+    team.age_sum += ages[member];
+    ++team.age_histogram[age];
+    ++team.role_count[roles[member]];
+    if (past_teams[member] >= 0) {
+        team.past_pairs += team.past_count[past_teams[member]]++;
+    }
+    for (int other : apart[member]) {
+        team.apart_pairs += team_of[other] == team_index;
+    }
+    team_of[member] = team_index;
+}
+
+// Update a team's running totals for a member leaving it
+void RosterPartitioner::removeMember(TeamState& team, int team_index, int member) {
+    const int age = clampAge(ages[member]);
+    team_of[member] = -1;
+    for (int other : apart[member]) {
+        team.apart_pairs -= team_of[other] == team_index;
+    }
+    if (past_teams[member] >= 0) {
+        team.past_pairs -= --team.past_count[past_teams[member]];
+    }
+    --team.role_count[roles[member]];
+    --team.age_histogram[age];
+    team.age_sum -= ages[member];
+    --team.size;
+    if (team.size == 0) {
+        team.min_age = 0;
+        team.max_age = -1;
+        return;
+    }
+    while (team.age_histogram[team.min_age] == 0) {
+        ++team.min_age;
+    }
+    while (team.age_histogram[team.max_age] == 0) {
+        --team.max_age;
+    }
+}
+
+// Put a whole block into a team and refresh that team's cost
+void RosterPartitioner::addBlock(int block, int team_index) {
+    TeamState& team = teams[team_index];
+    total_cost -= team.cost;
+    for (int member : blocks[block]) {
+        addMember(team, team_index, member);
+    }
+    team.cost = teamCost(team);
+    total_cost += team.cost;
+    block_team[block] = team_index;
+}
+
+// Take a whole block out of a team and refresh that team's cost
+void RosterPartitioner::removeBlock(int block, int team_index) {
+    TeamState& team = teams[team_index];
+    total_cost -= team.cost;
+    for (int member : blocks[block]) {
+        removeMember(team, team_index, member);
+    }
+    team.cost = teamCost(team);
+    total_cost += team.cost;
+    block_team[block] = -1;
+}
+
+// Pick one coach per team among coaches whose specialty matches, least loaded first
+std::vector<Coach*> RosterPartitioner::pickCoaches() const {
+    std::vector<Coach*> candidates;
+    for (auto coach : club.getCoaches()) {
+        if (coach->getSpecialty() == constraints.sport_type) {
+            candidates.push_back(coach);
+        }
+    }
+    if (candidates.empty()) {
+        throw std::invalid_argument("No coach with this specialty in the club");
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Coach* a, const Coach* b) {
+        return a->getTeamCount() < b->getTeamCount();
+        });
+    std::vector<Coach*> result;
+    for (int t = 0; t < constraints.team_count; ++t) {
+        result.push_back(candidates[t % candidates.size()]);
+    }
+    return result;
+}
+
+// Split the members into balanced teams, add them to the club and return them
+// Throws an exception if no coach has the requested specialty
+std::vector<Team*> RosterPartitioner::partition(const std::vector<Member*>& input) {
+    const std::vector<Coach*> coaches = pickCoaches();
+    prepare(input);
+
+    const int team_count = constraints.team_count;
+    TeamState empty;
+    empty.role_count.assign(role_types, 0);
+    empty.past_count.assign(past_team_types, 0);
+    empty.age_histogram.assign(MAX_TRACKED_AGE + 1, 0);
+    teams.assign(team_count, empty);
+    total_cost = 0;
+    for (auto& team : teams) {
+        team.cost = teamCost(team);
+        total_cost += team.cost;
+    }
+    team_of.assign(members.size(), -1);
+    block_team.assign(blocks.size(), -1);
+
+    // Greedy: biggest blocks first, each into the team where it adds the least cost
+    std::vector<int> order(blocks.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+        return blocks[a].size() > blocks[b].size();
+        });
+    for (int block : order) {
+        int best_team = 0;
+        double best_cost = 0;
+        for (int t = 0; t < team_count; ++t) {
+            const double before = total_cost;
+            addBlock(block, t);
+            const double added = total_cost - before;
+            removeBlock(block, t);
+            if (t == 0 || added < best_cost) {
+                best_cost = added;
+                best_team = t;
+            }
+        }
+        addBlock(block, best_team);
+    }
+
+    // Local search: random moves and swaps, kept only when the total cost drops
+    if (team_count > 1 && !blocks.empty()) {
+        std::mt19937 random(constraints.seed);
+        std::uniform_int_distribution<int> pick_block(0, static_cast<int>(blocks.size()) - 1);
+        std::uniform_int_distribution<int> pick_team(0, team_count - 1);
+        const long long iterations = static_cast<long long>(members.size()) * constraints.iterations_per_member;
+        for (long long i = 0; i < iterations; ++i) {
+            const int block = pick_block(random);
+            const int from = block_team[block];
+            const double before = total_cost;
+            if (i % 2 == 0) {
+                const int to = pick_team(random);
+                if (to == from) {
+                    continue;
+                }
+                removeBlock(block, from);
+                addBlock(block, to);
+                if (total_cost >= before) {
+                    removeBlock(block, to);
+                    addBlock(block, from);
+                }
+            }
+            else {
+                const int other = pick_block(random);
+                const int to = block_team[other];
+                if (to == from) {
+                    continue;
+                }
+                removeBlock(block, from);
+                removeBlock(other, to);
+                addBlock(block, to);
+                addBlock(other, from);
+                if (total_cost >= before) {
+                    removeBlock(block, to);
+                    removeBlock(other, from);
+                    addBlock(block, from);
+                    addBlock(other, to);
+                }
+            }
+        }
+    }
+
+    // Materialize the teams in the club
+    std::vector<std::vector<Member*>> rosters(team_count);
+    for (size_t i = 0; i < members.size(); ++i) {
+        rosters[team_of[i]].push_back(members[i]);
+    }
+    std::vector<Team*> result;
+    for (int t = 0; t < team_count; ++t) {
+        Team* team = club.emplaceTeam(constraints.sport_type, coaches[t], constraints.first_team_id + t);
+        for (auto member : rosters[t]) {
+            team->addMember(member);
+        }
+        result.push_back(team);
+    }
+    return result;
+}
+
+// Get the cost of the last partition, lower is better
+double RosterPartitioner::getCost() const {
+    return total_cost;
+}
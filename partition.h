@@ -0,0 +1,81 @@
+#ifndef PARTITION_H
+#define PARTITION_H
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Club.h"
+
+// Rules for splitting members into balanced teams
+struct PartitionConstraints {
+    int team_count = 2;
+    std::string sport_type;
+    int first_team_id = 1;
+    int max_age_spread = 0;                     // oldest minus youngest per team, 0 for no limit
+    std::map<std::string, int> role_quotas;     // minimum members of each role per team
+    std::vector<std::pair<Member*, Member*>> keep_together;
+    std::vector<std::pair<Member*, Member*>> keep_apart;
+    bool spread_past_teams = true;              // avoid re-forming the members' current club teams
+    int iterations_per_member = 50;             // local search budget
+    unsigned seed = 1;
+};
+
+// Splits members into N balanced teams and assigns coaches by specialty
+// Keep-together pairs are merged into blocks that always move as one unit; everything
+// else is a weighted cost (team size, average age, role shares and quotas, age spread,
+// keep-apart pairs, members sharing a past team). A greedy pass places the largest blocks
+// first, then random moves and swaps are kept when they lower the cost. Each team keeps
+// running totals so evaluating a move only recomputes the two teams involved.
+class RosterPartitioner {
+private:
+    struct TeamState {
+        int size = 0;
+        long long age_sum = 0;
+        std::vector<int> role_count;
+        std::vector<int> past_count;
+        std::vector<int> age_histogram;
+        int min_age = 0;
+        int max_age = -1;
+        long long past_pairs = 0;
+        long long apart_pairs = 0;
+        double cost = 0;
+    };
+
+    Club& club;
+    PartitionConstraints constraints;
+
+    std::vector<Member*> members;
+    std::vector<int> ages;
+    std::vector<int> roles;
+    std::vector<int> past_teams;
+    std::vector<std::vector<int>> apart;
+    std::vector<std::vector<int>> blocks;
+    std::vector<int> role_quota;
+    std::vector<double> role_share;
+    size_t role_types;
+    size_t past_team_types;
+    double target_size;
+    double mean_age;
+
+    std::vector<int> team_of;
+    std::vector<int> block_team;
+    std::vector<TeamState> teams;
+    double total_cost;
+
+    void prepare(const std::vector<Member*>& input);
+    void addMember(TeamState& team, int team_index, int member);
+    void removeMember(TeamState& team, int team_index, int member);
+    void addBlock(int block, int team_index);
+    void removeBlock(int block, int team_index);
+    double teamCost(const TeamState& team) const;
+    std::vector<Coach*> pickCoaches() const;
+
+public:
+    RosterPartitioner(Club& club, const PartitionConstraints& constraints);
+
+    std::vector<Team*> partition(const std::vector<Member*>& input);
+    double getCost() const;
+};
+
+#endif // PARTITION_H
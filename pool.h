@@ -0,0 +1,170 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Chunked storage for club-owned entities
+// Objects are constructed in place inside fixed-size chunks, so a bulk load pays one
+// allocation per chunk instead of one per record, and addresses stay stable for the
+// lifetime of the object (teams and events keep raw pointers to members).
+template <typename T, size_t ChunkSize = 256>
+class EntityPool {
+private:
+    struct Slot {
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    struct Chunk {
+        std::unique_ptr<Slot[]> slots;
+        std::vector<bool> live;
+        size_t used;  // slots handed out so far, live or freed
+    };
+
+    std::vector<Chunk> chunks;
+    std::map<const Slot*, size_t> chunk_by_address;
+    std::vector<T*> free_slots;
+    size_t live_count;
+
+    // Find the chunk and slot index holding a pointer, or return false if it is not ours
+    bool locate(const T* object, size_t& chunk_index, size_t& slot_index) const {
+        const Slot* slot = reinterpret_cast<const Slot*>(object);
+        auto it = chunk_by_address.upper_bound(slot);
+        if (it == chunk_by_address.begin()) {
+            return false;
+        }
+        --it;
+        const Slot* base = it->first;
+        if (slot >= base + ChunkSize) {
+            return false;
+        }
+        chunk_index = it->second;
+        slot_index = static_cast<size_t>(slot - base);
+        return true;
+    }
+
+public:
+    EntityPool() : live_count(0) {}
+    EntityPool(const EntityPool&) = delete;
+    EntityPool& operator=(const EntityPool&) = delete;
+
+    ~EntityPool() {
+        clear();
+    }
+
+    // Construct an object in the pool from the given arguments
+    // If the constructor throws, the slot is returned to the pool
+    template <typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot = nullptr;
+        size_t chunk_index = 0;
+        size_t slot_index = 0;
+        if (!free_slots.empty()) {
+            T* reused = free_slots.back();
+            locate(reused, chunk_index, slot_index);
+            slot = reinterpret_cast<Slot*>(reused);
+            free_slots.pop_back();
+        }
+        else {
+            if (chunks.empty() || chunks.back().used == ChunkSize) {
+                chunks.push_back({ std::unique_ptr<Slot[]>(new Slot[ChunkSize]), std::vector<bool>(ChunkSize, false), 0 });
+                chunk_by_address.emplace(chunks.back().slots.get(), chunks.size() - 1);
+            }
+            chunk_index = chunks.size() - 1;
+            slot_index = chunks.back().used++;
+            slot = &chunks.back().slots[slot_index];
+        }
+
+        T* object = nullptr;
+        try {
+            object = ::new (static_cast<void*>(slot->bytes)) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            free_slots.push_back(reinterpret_cast<T*>(slot));
+            throw;
+        }
+        chunks[chunk_index].live[slot_index] = true;
+        ++live_count;
+        return object;
+    }
+
+    // Destroy an object created by this pool and make its slot reusable
+    void destroy(T* object) {
+        size_t chunk_index = 0;
+        size_t slot_index = 0;
+        if (object == nullptr || !locate(object, chunk_index, slot_index) || !chunks[chunk_index].live[slot_index]) {
+            return;
+        }
+        object->~T();
+        chunks[chunk_index].live[slot_index] = false;
+        free_slots.push_back(object);
+        --live_count;
+    }
+
+    // Check whether a live object was created by this pool
+    bool owns(const T* object) const {
+        size_t chunk_index = 0;
+        size_t slot_index = 0;
+        return object != nullptr && locate(object, chunk_index, slot_index) && chunks[chunk_index].live[slot_index];
+    }
+
+    // Destroy every live object and release all chunks
+    void clear() {
+        for (auto& chunk : chunks) {
+            for (size_t i = 0; i < chunk.used; ++i) {
+                if (chunk.live[i]) {
+                    std::launder(reinterpret_cast<T*>(chunk.slots[i].bytes))->~T();
+                }
+            }
+        }
+        chunks.clear();
+        chunk_by_address.clear();
+        free_slots.clear();
+        live_count = 0;
+    }
+
+    // Release the chunks holding no live object; live objects keep their addresses
+    void shrinkToFit() {
+        std::vector<Chunk> kept;
+        for (auto& chunk : chunks) {
+            if (std::find(chunk.live.begin(), chunk.live.end(), true) != chunk.live.end()) {
+                kept.push_back(std::move(chunk));
+            }
+        }
+        chunks = std::move(kept);
+        chunks.shrink_to_fit();
+        chunk_by_address.clear();
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            chunk_by_address.emplace(chunks[i].slots.get(), i);
+        }
+        size_t chunk_index = 0;
+        size_t slot_index = 0;
+        free_slots.erase(std::remove_if(free_slots.begin(), free_slots.end(), [&](T* slot) {
+            return !locate(slot, chunk_index, slot_index);
+            }), free_slots.end());
+        free_slots.shrink_to_fit();
+    }
+
+    // Get the approximate heap memory used by the pool in bytes, not counting memory the
+    // objects allocate themselves
+    size_t memoryUsage() const {
+        return chunks.capacity() * sizeof(Chunk) + chunks.size() * (ChunkSize * sizeof(Slot) + ChunkSize / 8) +
+               chunk_by_address.size() * (sizeof(std::pair<const Slot* const, size_t>) + 4 * sizeof(void*)) +
+               free_slots.capacity() * sizeof(T*);
+    }
+
+    size_t size() const {
+        return live_count;
+    }
+
+    size_t capacity() const {
+        return chunks.size() * ChunkSize;
+    }
+};
+
+#endif // POOL_H
@@ -0,0 +1,183 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "Member.h"
+
+// Binary protocol spoken between ClubServer and ClubClient
+// Every message is a frame: a 32-bit little-endian length of the rest of the frame, then
+// one byte (the request kind or the response status), then the body. Integers are
+// little-endian, strings are a 16-bit length and the bytes. Clients may send any number
+// of requests without waiting; responses come back in request order.
+
+// Request kinds and their bodies
+enum class ClubRequest : std::uint8_t {
+    Ping = 0,               // -> empty
+    FindMemberById = 1,     // i32 id -> member
+    FindMemberByName = 2,   // str name -> member
+    SearchMembers = 3,      // str query, u8 max distance, u16 limit -> u16 count, members
+    AddMember = 4,          // str name, i32 age, str role, i32 id -> empty
+    RemoveMember = 5,       // i32 id -> empty
+    SignUp = 6,             // str event, i32 member id -> empty
+    ScheduleConflict = 7,   // str location, str date, str start, str end -> u8 conflict
+    ParticipantCount = 8,   // str event -> u32 count
+    SearchEvents = 9        // str query, u16 limit -> u16 count, str names
+};
+
+// Response statuses; an Error body is the message
+enum class ClubStatus : std::uint8_t {
+    Ok = 0,
+    NotFound = 1,
+    Error = 2
+};
+
+const std::uint32_t MAX_FRAME_BYTES = 1 << 20;
+
+// Appends frames to a byte buffer
+class WireWriter {
+private:
+    std::string buffer;
+
+public:
+    // Start a frame with its kind or status byte; returns the handle for endFrame
+    size_t beginFrame(std::uint8_t head) {
+        const size_t start = buffer.size();
+        u32(0);
+        u8(head);
+        return start;
+    }
+
+    // Patch the length of a frame once its body is written
+    void endFrame(size_t start) {
+        const std::uint32_t length = static_cast<std::uint32_t>(buffer.size() - start - 4);
+        for (int i = 0; i < 4; ++i) {
+            buffer[start + i] = static_cast<char>(length >> (8 * i));
+        }
+    }
+
+    // Drop everything written from a position on, e.g. a half-written frame
+    void truncate(size_t position) {
+        buffer.resize(position);
+    }
+
+    void u8(std::uint8_t value) {
+        buffer.push_back(static_cast<char>(value));
+    }
+
+    void u16(std::uint16_t value) {
+        u8(static_cast<std::uint8_t>(value));
+        u8(static_cast<std::uint8_t>(value >> 8));
+    }
+
+    void u32(std::uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            u8(static_cast<std::uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void i32(int value) {
+        u32(static_cast<std::uint32_t>(value));
+    }
+
+    // Throws an exception if the string does not fit a 16-bit length
+    void str(const std::string& value) {
+        if (value.size() > 0xFFFF) {
+            throw std::invalid_argument("String is too long for the wire");
+        }
+        u16(static_cast<std::uint16_t>(value.size()));
+        buffer.append(value);
+    }
+
+    // A member as sent over the wire: i32 id, i32 age, str name, str role
+    void member(const MemberRecord& record) {
+        i32(record.id);
+        i32(record.age);
+        str(record.name);
+        str(record.role);
+    }
+
+    std::string& bytes() { return buffer; }
+    const std::string& bytes() const { return buffer; }
+    size_t size() const { return buffer.size(); }
+};
+
+// Reads fields from one frame body
+// Every read throws an exception if the body ends before the field does
+class WireReader {
+private:
+    const char* data;
+    size_t length;
+    size_t offset;
+
+    void need(size_t bytes) const {
+        if (length - offset < bytes) {
+            throw std::invalid_argument("Message is truncated");
+        }
+    }
+
+public:
+    WireReader(const char* data, size_t length) : data(data), length(length), offset(0) {}
+
+    std::uint8_t u8() {
+        need(1);
+        return static_cast<std::uint8_t>(data[offset++]);
+    }
+
+    std::uint16_t u16() {
+        const std::uint16_t low = u8();
+        return static_cast<std::uint16_t>(low | (u8() << 8));
+    }
+
+    std::uint32_t u32() {
+        need(4);
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value |= static_cast<std::uint32_t>(static_cast<std::uint8_t>(data[offset + i])) << (8 * i);
+        }
+        offset += 4;
+        return value;
+    }
+
+    int i32() {
+        return static_cast<int>(u32());
+    }
+
+    std::string str() {
+        const size_t size = u16();
+        need(size);
+        std::string value(data + offset, size);
+        offset += size;
+        return value;
+    }
+
+    MemberRecord member() {
+        MemberRecord record;
+        record.id = i32();
+        record.age = i32();
+        record.name = str();
+        record.role = str();
+        return record;
+    }
+
+    bool atEnd() const {
+        return offset == length;
+    }
+};
+
+// Get the length of the frame at the start of a buffer, or 0 if its length field is incomplete
+// Throws an exception if the frame is larger than MAX_FRAME_BYTES or has no kind byte
+inline size_t frameLength(const char* data, size_t available) {
+    if (available < 4) {
+        return 0;
+    }
+    const std::uint32_t length = WireReader(data, 4).u32();
+    if (length == 0 || length > MAX_FRAME_BYTES) {
+        throw std::invalid_argument("Frame length is out of range");
+    }
+    return 4 + static_cast<size_t>(length);
+}
+
+#endif // PROTOCOL_H
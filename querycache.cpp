@@ -0,0 +1,97 @@
+#include "QueryCache.h"
+#include <iterator>
+#include <utility>
+
+namespace {
+    // Rough per-entry bookkeeping: list node, hash node and bucket
+    const size_t ENTRY_OVERHEAD = 4 * sizeof(void*) + sizeof(std::string) + 2 * sizeof(void*);
+}
+
+// Get the share of lookups answered from the cache
+double QueryCacheStats::hitRate() const {
+    const size_t lookups = hits + misses;
+    return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+}
+
+// Constructor for an empty cache with the given memory budget in bytes
+QueryCache::QueryCache(size_t capacity_bytes)
+    : capacity_bytes(capacity_bytes), memory_bytes(0), hits(0), misses(0), stale(0), evictions(0) {}
+
+// Build the lookup key of a query
+std::string QueryCache::makeKey(QueryKind kind, const std::string& argument) {
+    std::string key;
+    key.reserve(argument.size() + 1);
+    key.push_back(static_cast<char>(kind));
+    key += argument;
+    return key;
+}
+
+// Drop one entry
+void QueryCache::erase(std::list<Entry>::iterator entry) {
+    memory_bytes -= entry->bytes;
+    index.erase(entry->key);
+    entries.erase(entry);
+}
+
+// Drop least recently used entries until the cache is within budget
+void QueryCache::evictToFit() {
+    while (memory_bytes > capacity_bytes && !entries.empty()) {
+        erase(std::prev(entries.end()));
+        ++evictions;
+    }
+}
+
+// Look up a query result computed against the given versions
+// Returns null on a miss; the pointer is valid until the cache is next changed
+const CachedResult* QueryCache::find(QueryKind kind, const std::string& argument, const QueryVersions& versions) {
+    auto it = index.find(makeKey(kind, argument));
+    if (it == index.end()) {
+        ++misses;
+        return nullptr;
+    }
+    if (it->second->versions != versions) {
+        erase(it->second);
+        ++stale;
+        ++misses;
+        return nullptr;
+    }
+    entries.splice(entries.begin(), entries, it->second);
+    ++hits;
+    return &entries.front().result;
+}
+
+// Remember a query result, evicting older entries if over budget
+// Results larger than the whole budget are not kept
+void QueryCache::store(QueryKind kind, const std::string& argument, const QueryVersions& versions, CachedResult result) {
+    std::string key = makeKey(kind, argument);
+    auto existing = index.find(key);
+    if (existing != index.end()) {
+        erase(existing->second);
+    }
+    const size_t bytes = ENTRY_OVERHEAD + 2 * key.capacity() + result.members.capacity() * sizeof(Member*) + sizeof(Entry);
+    if (bytes > capacity_bytes) {
+        return;
+    }
+    entries.push_front({ key, versions, std::move(result), bytes });
+    index.emplace(std::move(key), entries.begin());
+    memory_bytes += bytes;
+    evictToFit();
+}
+
+// Drop every entry, keeping the counters
+void QueryCache::clear() {
+    entries.clear();
+    index.clear();
+    memory_bytes = 0;
+}
+
+// Change the memory budget, evicting as needed
+void QueryCache::setCapacity(size_t capacity_bytes) {
+    this->capacity_bytes = capacity_bytes;
+    evictToFit();
+}
+
+// Get the cache counters and memory use
+QueryCacheStats QueryCache::getStats() const {
+    return { hits, misses, stale, evictions, entries.size(), memory_bytes, capacity_bytes };
+}
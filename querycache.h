@@ -0,0 +1,76 @@
+#ifndef QUERYCACHE_H
+#define QUERYCACHE_H
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Member.h"
+
+enum class QueryKind : char {
+    MembersByRole = 'r',
+    MemberByName = 'n',
+    ParticipantCount = 'p'
+};
+
+// Version counters a cached result was computed against; a result is only served
+// while every counter still matches
+using QueryVersions = std::array<std::uint64_t, 2>;
+
+// The value of a cached query
+struct CachedResult {
+    std::vector<Member*> members;
+    size_t count = 0;
+};
+
+// Hit, miss and memory figures of a query cache
+struct QueryCacheStats {
+    size_t hits;
+    size_t misses;
+    size_t stale;       // misses caused by an outdated entry
+    size_t evictions;
+    size_t entries;
+    size_t memory_bytes;
+    size_t capacity_bytes;
+
+    double hitRate() const;
+};
+
+// Query results kept in least-recently-used order within a memory budget
+// Entries carry the versions of the tables they were computed from; a lookup with
+// newer versions drops the entry instead of returning it.
+class QueryCache {
+private:
+    struct Entry {
+        std::string key;
+        QueryVersions versions;
+        CachedResult result;
+        size_t bytes;
+    };
+
+    std::list<Entry> entries;  // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    size_t capacity_bytes;
+    size_t memory_bytes;
+    size_t hits;
+    size_t misses;
+    size_t stale;
+    size_t evictions;
+
+    static std::string makeKey(QueryKind kind, const std::string& argument);
+    void erase(std::list<Entry>::iterator entry);
+    void evictToFit();
+
+public:
+    explicit QueryCache(size_t capacity_bytes);
+
+    const CachedResult* find(QueryKind kind, const std::string& argument, const QueryVersions& versions);
+    void store(QueryKind kind, const std::string& argument, const QueryVersions& versions, CachedResult result);
+    void clear();
+    void setCapacity(size_t capacity_bytes);
+    QueryCacheStats getStats() const;
+};
+
+#endif // QUERYCACHE_H
@@ -0,0 +1,437 @@
+#include "Roster.h"
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+    int popCount(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(word);
+#else
+        int count = 0;
+        while (word != 0) {
+            word &= word - 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    bool testBit(const std::vector<std::uint64_t>& bits, std::uint16_t low) {
+        return (bits[low >> 6] >> (low & 63)) & 1u;
+    }
+}
+
+// Find the container for a high key, or nullptr
+RosterBitmap::Container* RosterBitmap::findContainer(std::uint16_t key) {
+    auto it = std::lower_bound(containers.begin(), containers.end(), key, [](const Container& c, std::uint16_t k) {
+        return c.key < k;
+        });
+    return it != containers.end() && it->key == key ? &*it : nullptr;
+}
+
+// Find the container for a high key, or nullptr
+const RosterBitmap::Container* RosterBitmap::findContainer(std::uint16_t key) const {
+    auto it = std::lower_bound(containers.begin(), containers.end(), key, [](const Container& c, std::uint16_t k) {
+        return c.key < k;
+        });
+    return it != containers.end() && it->key == key ? &*it : nullptr;
+}
+
+// Convert an array container into a bitmap container
+void RosterBitmap::toBitmap(Container& container) {
+    if (container.isBitmap()) {
+        return;
+    }
+    container.bits.assign(BITMAP_WORDS, 0);
+    for (auto low : container.array) {
+        container.bits[low >> 6] |= std::uint64_t(1) << (low & 63);
+    }
+    container.array.clear();
+    container.array.shrink_to_fit();
+}
+
+// Pick the cheaper representation for the container's current cardinality
+void RosterBitmap::normalize(Container& container) {
+    if (container.isBitmap() && container.cardinality <= ARRAY_LIMIT) {
+        container.array.clear();
+        container.array.reserve(container.cardinality);
+        for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+            std::uint64_t word = container.bits[w];
+            while (word != 0) {
+                const int bit = popCount((word & (~word + 1)) - 1);
+                container.array.push_back(static_cast<std::uint16_t>(w * 64 + bit));
+                word &= word - 1;
+            }
+        }
+        container.bits.clear();
+        container.bits.shrink_to_fit();
+    }
+    else if (!container.isBitmap() && container.array.size() > ARRAY_LIMIT) {
+        toBitmap(container);
+    }
+}
+
+// Intersect two containers with the same key
+RosterBitmap::Container RosterBitmap::intersect(const Container& a, const Container& b) {
+    Container result{ a.key, {}, {}, 0 };
+    if (a.isBitmap() && b.isBitmap()) {
+        result.bits.resize(BITMAP_WORDS);
+        std::uint32_t count = 0;
+        for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+            result.bits[w] = a.bits[w] & b.bits[w];
+            count += static_cast<std::uint32_t>(popCount(result.bits[w]));
+        }
+        result.cardinality = count;
+        normalize(result);
+    }
+    else if (a.isBitmap() || b.isBitmap()) {
+        const Container& bitmap = a.isBitmap() ? a : b;
+        const Container& array = a.isBitmap() ? b : a;
+        for (auto low : array.array) {
+            if (testBit(bitmap.bits, low)) {
+                result.array.push_back(low);
+            }
+        }
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+    }
+    else {
+        std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                              std::back_inserter(result.array));
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+    }
+    return result;
+}
+
+// Unite two containers with the same key
+RosterBitmap::Container RosterBitmap::unite(const Container& a, const Container& b) {
+    Container result{ a.key, {}, {}, 0 };
+    if (a.isBitmap() || b.isBitmap()) {
+        const Container& bitmap = a.isBitmap() ? a : b;
+        const Container& other = a.isBitmap() ? b : a;
+        result.bits = bitmap.bits;
+        if (other.isBitmap()) {
+            for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+                result.bits[w] |= other.bits[w];
+            }
+        }
+        else {
+            for (auto low : other.array) {
+                result.bits[low >> 6] |= std::uint64_t(1) << (low & 63);
+            }
+        }
+        std::uint32_t count = 0;
+        for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+            count += static_cast<std::uint32_t>(popCount(result.bits[w]));
+        }
+        result.cardinality = count;
+    }
+    else {
+        result.array.reserve(a.array.size() + b.array.size());
+        std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                       std::back_inserter(result.array));
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+        normalize(result);
+    }
+    return result;
+}
+
+// Remove the ids of one container from another with the same key
+RosterBitmap::Container RosterBitmap::subtract(const Container& a, const Container& b) {
+    Container result{ a.key, {}, {}, 0 };
+    if (a.isBitmap()) {
+        result.bits = a.bits;
+        if (b.isBitmap()) {
+            for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+                result.bits[w] &= ~b.bits[w];
+            }
+        }
+        else {
+            for (auto low : b.array) {
+                result.bits[low >> 6] &= ~(std::uint64_t(1) << (low & 63));
+            }
+        }
+        std::uint32_t count = 0;
+        for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+            count += static_cast<std::uint32_t>(popCount(result.bits[w]));
+        }
+        result.cardinality = count;
+        normalize(result);
+    }
+    else if (b.isBitmap()) {
+        for (auto low : a.array) {
+            if (!testBit(b.bits, low)) {
+                result.array.push_back(low);
+            }
+        }
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+    }
+    else {
+        std::set_difference(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                            std::back_inserter(result.array));
+        result.cardinality = static_cast<std::uint32_t>(result.array.size());
+    }
+    return result;
+}
+
+// Add a member id to the roster
+// Throws an exception if the id is negative
+void RosterBitmap::add(int id) {
+    if (id < 0) {
+        throw std::invalid_argument("Member ID cannot be negative");
+    }
+    const std::uint16_t key = static_cast<std::uint16_t>(static_cast<std::uint32_t>(id) >> 16);
+    const std::uint16_t low = static_cast<std::uint16_t>(id & 0xFFFF);
+    auto it = std::lower_bound(containers.begin(), containers.end(), key, [](const Container& c, std::uint16_t k) {
+        return c.key < k;
+        });
+    if (it == containers.end() || it->key != key) {
+        it = containers.insert(it, Container{ key, {}, {}, 0 });
+    }
+    Container& container = *it;
+    if (container.isBitmap()) {
+        std::uint64_t& word = container.bits[low >> 6];
+        const std::uint64_t mask = std::uint64_t(1) << (low & 63);
+        if ((word & mask) == 0) {
+            word |= mask;
+            ++container.cardinality;
+        }
+        return;
+    }
+    auto pos = std::lower_bound(container.array.begin(), container.array.end(), low);
+    if (pos == container.array.end() || *pos != low) {
+        container.array.insert(pos, low);
+        ++container.cardinality;
+        normalize(container);
+    }
+}
+
+// Remove a member id from the roster
+void RosterBitmap::remove(int id) {
+    if (id < 0) {
+        return;
+    }
+    const std::uint16_t key = static_cast<std::uint16_t>(static_cast<std::uint32_t>(id) >> 16);
+    const std::uint16_t low = static_cast<std::uint16_t>(id & 0xFFFF);
+    Container* container = findContainer(key);
+    if (container == nullptr) {
+        return;
+    }
+    if (container->isBitmap()) {
+        std::uint64_t& word = container->bits[low >> 6];
+        const std::uint64_t mask = std::uint64_t(1) << (low & 63);
+        if ((word & mask) != 0) {
+            word &= ~mask;
+            --container->cardinality;
+            normalize(*container);
+        }
+    }
+    else {
+        auto pos = std::lower_bound(container->array.begin(), container->array.end(), low);
+        if (pos != container->array.end() && *pos == low) {
+            container->array.erase(pos);
+            --container->cardinality;
+        }
+    }
+    if (container->cardinality == 0) {
+        containers.erase(containers.begin() + (container - containers.data()));
+    }
+}
+
+// Check whether a member id is in the roster
+bool RosterBitmap::contains(int id) const {
+    if (id < 0) {
+        return false;
+    }
+    const Container* container = findContainer(static_cast<std::uint16_t>(static_cast<std::uint32_t>(id) >> 16));
+    if (container == nullptr) {
+        return false;
+    }
+    const std::uint16_t low = static_cast<std::uint16_t>(id & 0xFFFF);
+    if (container->isBitmap()) {
+        return testBit(container->bits, low);
+    }
+    return std::binary_search(container->array.begin(), container->array.end(), low);
+}
+
+// Get the number of member ids in the roster
+size_t RosterBitmap::cardinality() const {
+    size_t total = 0;
+    for (const auto& container : containers) {
+        total += container.cardinality;
+    }
+    return total;
+}
+
+// Check whether the roster is empty
+bool RosterBitmap::empty() const {
+    return containers.empty();
+}
+
+// Get the member ids in ascending order
+std::vector<int> RosterBitmap::toIds() const {
+    std::vector<int> ids;
+    ids.reserve(cardinality());
+    for (const auto& container : containers) {
+        const int high = static_cast<int>(container.key) << 16;
+        if (container.isBitmap()) {
+            for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+                std::uint64_t word = container.bits[w];
+                while (word != 0) {
+                    const int bit = popCount((word & (~word + 1)) - 1);
+                    ids.push_back(high | static_cast<int>(w * 64 + bit));
+                    word &= word - 1;
+                }
+            }
+        }
+        else {
+            for (auto low : container.array) {
+                ids.push_back(high | low);
+            }
+        }
+    }
+    return ids;
+}
+
+// Members in both rosters
+RosterBitmap RosterBitmap::operator&(const RosterBitmap& other) const {
+    RosterBitmap result;
+    auto a = containers.begin();
+    auto b = other.containers.begin();
+    while (a != containers.end() && b != other.containers.end()) {
+        if (a->key < b->key) {
+            ++a;
+        }
+        else if (b->key < a->key) {
+            ++b;
+        }
+        else {
+            Container merged = intersect(*a, *b);
+            if (merged.cardinality != 0) {
+                result.containers.push_back(std::move(merged));
+            }
+            ++a;
+            ++b;
+        }
+    }
+    return result;
+}
+
+// Members in either roster
+RosterBitmap RosterBitmap::operator|(const RosterBitmap& other) const {
+    RosterBitmap result;
+    result.containers.reserve(containers.size() + other.containers.size());
+    auto a = containers.begin();
+    auto b = other.containers.begin();
+    while (a != containers.end() || b != other.containers.end()) {
+        if (b == other.containers.end() || (a != containers.end() && a->key < b->key)) {
+            result.containers.push_back(*a++);
+        }
+        else if (a == containers.end() || b->key < a->key) {
+            result.containers.push_back(*b++);
+        }
+        else {
+            result.containers.push_back(unite(*a++, *b++));
+        }
+    }
+    return result;
+}
+
+// Members in this roster but not in the other
+RosterBitmap RosterBitmap::operator-(const RosterBitmap& other) const {
+    RosterBitmap result;
+    auto b = other.containers.begin();
+    for (const auto& container : containers) {
+        while (b != other.containers.end() && b->key < container.key) {
+            ++b;
+        }
+        if (b != other.containers.end() && b->key == container.key) {
+            Container remaining = subtract(container, *b);
+            if (remaining.cardinality != 0) {
+                result.containers.push_back(std::move(remaining));
+            }
+        }
+        else {
+            result.containers.push_back(container);
+        }
+    }
+    return result;
+}
+
+RosterBitmap& RosterBitmap::operator&=(const RosterBitmap& other) {
+    *this = *this & other;
+    return *this;
+}
+
+RosterBitmap& RosterBitmap::operator|=(const RosterBitmap& other) {
+    *this = *this | other;
+    return *this;
+}
+
+RosterBitmap& RosterBitmap::operator-=(const RosterBitmap& other) {
+    *this = *this - other;
+    return *this;
+}
+
+// Count the members in both rosters without building the intersection
+size_t RosterBitmap::intersectionCardinality(const RosterBitmap& other) const {
+    size_t total = 0;
+    auto a = containers.begin();
+    auto b = other.containers.begin();
+    while (a != containers.end() && b != other.containers.end()) {
+        if (a->key < b->key) {
+            ++a;
+            continue;
+        }
+        if (b->key < a->key) {
+            ++b;
+            continue;
+        }
+        if (a->isBitmap() && b->isBitmap()) {
+            for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+                total += static_cast<size_t>(popCount(a->bits[w] & b->bits[w]));
+            }
+        }
+        else if (a->isBitmap() || b->isBitmap()) {
+            const Container& bitmap = a->isBitmap() ? *a : *b;
+            const Container& array = a->isBitmap() ? *b : *a;
+            for (auto low : array.array) {
+                total += testBit(bitmap.bits, low);
+            }
+        }
+        else {
+            auto x = a->array.begin();
+            auto y = b->array.begin();
+            while (x != a->array.end() && y != b->array.end()) {
+                if (*x < *y) {
+                    ++x;
+                }
+                else if (*y < *x) {
+                    ++y;
+                }
+                else {
+                    ++total;
+                    ++x;
+                    ++y;
+                }
+            }
+        }
+        ++a;
+        ++b;
+    }
+    return total;
+}
+
+// Equality operator to compare two rosters by content
+bool RosterBitmap::operator==(const RosterBitmap& other) const {
+    return toIds() == other.toIds();
+}
+
+// Get the approximate number of bytes used by the roster
+size_t RosterBitmap::memoryUsage() const {
+    size_t bytes = sizeof(*this) + containers.capacity() * sizeof(Container);
+    for (const auto& container : containers) {
+        bytes += container.array.capacity() * sizeof(std::uint16_t) + container.bits.capacity() * sizeof(std::uint64_t);
+    }
+    return bytes;
+}
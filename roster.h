@@ -0,0 +1,56 @@
+#ifndef ROSTER_H
+#define ROSTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Compressed bitmap of member ids (Roaring-style)
+// Ids are split into a 16-bit high part selecting a container and a 16-bit low part
+// stored in it. Sparse containers are sorted arrays, dense ones are 65536-bit bitmaps,
+// so set algebra on dense rosters runs 64 members per machine word.
+class RosterBitmap {
+private:
+    static constexpr size_t ARRAY_LIMIT = 4096;  // above this an array is larger than a bitmap
+    static constexpr size_t BITMAP_WORDS = 1024;
+
+    struct Container {
+        std::uint16_t key;
+        std::vector<std::uint16_t> array;  // used while the container is sparse
+        std::vector<std::uint64_t> bits;   // BITMAP_WORDS words once dense
+        std::uint32_t cardinality;
+
+        bool isBitmap() const { return !bits.empty(); }
+    };
+
+    std::vector<Container> containers;  // sorted by key
+
+    Container* findContainer(std::uint16_t key);
+    const Container* findContainer(std::uint16_t key) const;
+    static void toBitmap(Container& container);
+    static void normalize(Container& container);
+    static Container intersect(const Container& a, const Container& b);
+    static Container unite(const Container& a, const Container& b);
+    static Container subtract(const Container& a, const Container& b);
+
+public:
+    void add(int id);
+    void remove(int id);
+    bool contains(int id) const;
+    size_t cardinality() const;
+    bool empty() const;
+    std::vector<int> toIds() const;
+
+    RosterBitmap operator&(const RosterBitmap& other) const;
+    RosterBitmap operator|(const RosterBitmap& other) const;
+    RosterBitmap operator-(const RosterBitmap& other) const;
+    RosterBitmap& operator&=(const RosterBitmap& other);
+    RosterBitmap& operator|=(const RosterBitmap& other);
+    RosterBitmap& operator-=(const RosterBitmap& other);
+    size_t intersectionCardinality(const RosterBitmap& other) const;
+    bool operator==(const RosterBitmap& other) const;
+
+    size_t memoryUsage() const;
+};
+
+#endif // ROSTER_H
@@ -0,0 +1,13 @@
+#include "Scan.h"
+
+// Encode a number so that byte-wise string order matches numeric order
+// The sign bit is flipped so negative numbers sort first, then the bytes are written
+// most significant first
+std::string orderedKey(long long value) {
+    const unsigned long long bits = static_cast<unsigned long long>(value) ^ (1ULL << 63);
+    std::string key(8, '\0');
+    for (int i = 0; i < 8; ++i) {
+        key[i] = static_cast<char>(bits >> (56 - 8 * i));
+    }
+    return key;
+}
@@ -0,0 +1,230 @@
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Orderings a collection can be scanned in
+enum class ScanOrder {
+    Id,
+    Name,
+    Date
+};
+
+// Where a scan stopped; pass it back to get the next page
+// A default cursor starts at the beginning. Cursors hold the key of the last returned
+// entity rather than a position, so they stay valid while the collection changes: the
+// next page starts right after that key, skips removed entities and includes entities
+// added further along.
+struct ScanCursor {
+    std::string key;
+    std::uint64_t sequence = 0;  // breaks ties between equal keys; 0 sorts before every entity
+    bool finished = false;       // set once the last page has been returned
+};
+
+// One page of a scan and the cursor to continue from
+template <typename T>
+struct ScanPage {
+    std::vector<T*> items;
+    ScanCursor next;
+};
+
+// Encode a number so that byte-wise string order matches numeric order
+std::string orderedKey(long long value);
+
+// Objects sorted by a string key, ties broken by the order they were inserted in
+template <typename T>
+class OrderedIndex {
+private:
+    struct Entry {
+        std::string key;
+        std::uint64_t sequence;
+        T* item;
+
+        bool operator<(const Entry& other) const {
+            const int order = key.compare(other.key);
+            return order < 0 || (order == 0 && sequence < other.sequence);
+        }
+    };
+
+    std::set<Entry> entries;
+    std::unordered_map<const T*, typename std::set<Entry>::const_iterator> position;
+    std::uint64_t next_sequence = 1;
+
+public:
+    // Add an object under a key; an object already present is left alone
+    void insert(T* item, std::string key) {
+        if (position.count(item) != 0) {
+            return;
+        }
+        auto it = entries.insert({ std::move(key), next_sequence++, item }).first;
+        position.emplace(item, it);
+    }
+
+    // Remove an object
+    void erase(const T* item) {
+        auto it = position.find(item);
+        if (it != position.end()) {
+            entries.erase(it->second);
+            position.erase(it);
+        }
+    }
+
+    // Move an object to a new key, keeping its place among equal keys
+    void rekey(const T* item, std::string key) {
+        auto it = position.find(item);
+        if (it == position.end() || it->second->key == key) {
+            return;
+        }
+        auto node = entries.extract(it->second);
+        node.value().key = std::move(key);
+        it->second = entries.insert(std::move(node)).position;
+    }
+
+    // Get up to limit objects ordered after the cursor
+    ScanPage<T> scan(const ScanCursor& cursor, size_t limit) const {
+        ScanPage<T> page;
+        auto it = entries.upper_bound({ cursor.key, cursor.sequence, nullptr });
+        for (; it != entries.end() && page.items.size() < limit; ++it) {
+            page.items.push_back(it->item);
+            page.next.key = it->key;
+            page.next.sequence = it->sequence;
+        }
+        if (page.items.empty()) {
+            page.next = cursor;
+        }
+        page.next.finished = it == entries.end();
+        return page;
+    }
+
+    size_t size() const {
+        return entries.size();
+    }
+
+    // Get the approximate heap memory used by the index in bytes
+    size_t memoryUsage() const {
+        size_t total = entries.size() * (sizeof(Entry) + 4 * sizeof(void*));
+        for (const auto& entry : entries) {
+            total += entry.key.capacity() > 15 ? entry.key.capacity() + 1 : 0;
+        }
+        return total + position.bucket_count() * sizeof(void*) +
+               position.size() * (sizeof(typename decltype(position)::value_type) + sizeof(void*));
+    }
+
+    void reserve(size_t count) {
+        position.reserve(count);
+    }
+
+    void shrinkToFit() {
+        position.rehash(0);
+    }
+};
+
+// Every ordering one entity kind supports for scanning
+// An ordering is built the first time it is scanned and then kept in sync with the
+// insert, erase and rekey calls, so orderings nobody scans cost no memory.
+template <typename T>
+class ScanIndex {
+public:
+    using KeyFunction = std::string (*)(const T*);
+
+private:
+    struct View {
+        ScanOrder order;
+        KeyFunction key_of;
+        std::unique_ptr<OrderedIndex<T>> index;  // null until first scanned
+    };
+
+    mutable std::vector<View> views;
+
+public:
+    explicit ScanIndex(const std::vector<std::pair<ScanOrder, KeyFunction>>& orders) {
+        for (const auto& order : orders) {
+            views.push_back({ order.first, order.second, nullptr });
+        }
+    }
+
+    // Add an object to every built ordering
+    void insert(T* item) {
+        for (auto& view : views) {
+            if (view.index) {
+                view.index->insert(item, view.key_of(item));
+            }
+        }
+    }
+
+    // Remove an object from every built ordering
+    void erase(const T* item) {
+        for (auto& view : views) {
+            if (view.index) {
+                view.index->erase(item);
+            }
+        }
+    }
+
+    // Re-sort an object after a change that may have altered its keys
+    void rekey(const T* item) {
+        for (auto& view : views) {
+            if (view.index) {
+                view.index->rekey(item, view.key_of(item));
+            }
+        }
+    }
+
+    // Get the approximate heap memory used by the built orderings in bytes
+    size_t memoryUsage() const {
+        size_t total = 0;
+        for (const auto& view : views) {
+            total += view.index ? view.index->memoryUsage() : 0;
+        }
+        return total;
+    }
+
+    // Make room for count objects in every built ordering
+    void reserve(size_t count) {
+        for (auto& view : views) {
+            if (view.index) {
+                view.index->reserve(count);
+            }
+        }
+    }
+
+    void shrinkToFit() {
+        for (auto& view : views) {
+            if (view.index) {
+                view.index->shrinkToFit();
+            }
+        }
+    }
+
+    // Get up to limit objects after the cursor in the given order
+    // The ordering is built from items on its first scan
+    // Throws an exception if the entity kind cannot be scanned in that order
+    template <typename Range>
+    ScanPage<T> scan(ScanOrder order, const Range& items, const ScanCursor& cursor, size_t limit) const {
+        for (auto& view : views) {
+            if (view.order != order) {
+                continue;
+            }
+            if (!view.index) {
+                view.index.reset(new OrderedIndex<T>());
+                for (const auto item : items) {
+                    view.index->insert(item, view.key_of(item));
+                }
+            }
+            if (cursor.finished) {
+                return { {}, cursor };
+            }
+            return view.index->scan(cursor, limit);
+        }
+        throw std::invalid_argument("Scan order is not supported for this collection");
+    }
+};
+
+#endif // SCAN_H
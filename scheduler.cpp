@@ -0,0 +1,396 @@
+#include "Scheduler.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    const long long MINUTES_PER_DAY = 24 * 60;
+
+    bool testBit(const std::vector<std::uint64_t>& bits, size_t offset, size_t index) {
+        return (bits[offset + index / 64] >> (index % 64)) & 1u;
+    }
+
+    void setBit(std::vector<std::uint64_t>& bits, size_t offset, size_t index) {
+        bits[offset + index / 64] |= std::uint64_t(1) << (index % 64);
+    }
+
+    int countTrailingZeros(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        int count = 0;
+        while ((word & 1u) == 0) {
+            word >>= 1;
+            ++count;
+        }
+        return count;
+#endif
+    }
+}
+
+// Constructor to expand the date windows into an ordered list of slots
+// Throws an exception if there are no venues, no slots, or the rest rule is negative
+SeasonScheduler::SeasonScheduler(Club& club, const std::vector<std::string>& venues,
+                                 const std::vector<ScheduleWindow>& windows, int rest_days)
+    : club(club), venues(venues), rest_days(rest_days), first_day(0), day_count(0), slot_words(0), day_words(0) {
+    if (venues.empty()) {
+        throw std::invalid_argument("At least one venue is required");
+    }
+    if (rest_days < 0) {
+        throw std::invalid_argument("Rest days cannot be negative");
+    }
+
+    for (const auto& window : windows) {
+        const long long first = Date::parse(window.first_date).getDayNumber();
+        const long long last = Date::parse(window.last_date).getDayNumber();
+        for (const auto& times : window.daily_slots) {
+            const int start = DateTime::parseTime(times.first);
+            const int end = DateTime::parseTime(times.second);
+            if (start >= end) {
+                throw std::invalid_argument("Slot must end after it starts");
+            }
+            for (long long day = first; day <= last; ++day) {
+                slots.push_back({ day, start, end, {} });
+            }
+        }
+    }
+    if (slots.empty()) {
+        throw std::invalid_argument("Schedule windows contain no slots");
+    }
+
+    std::sort(slots.begin(), slots.end(), [](const Slot& a, const Slot& b) {
+        if (a.day != b.day) return a.day < b.day;
+        if (a.start_minute != b.start_minute) return a.start_minute < b.start_minute;
+        return a.end_minute < b.end_minute;
+        });
+    slots.erase(std::unique(slots.begin(), slots.end(), [](const Slot& a, const Slot& b) {
+        return a.day == b.day && a.start_minute == b.start_minute && a.end_minute == b.end_minute;
+        }), slots.end());
+
+    // Link slots of the same day that share time so a booking blocks all of them
+    for (size_t i = 0; i < slots.size(); ++i) {
+        for (size_t j = i; j < slots.size() && slots[j].day == slots[i].day; ++j) {
+            if (slots[j].start_minute < slots[i].end_minute && slots[i].start_minute < slots[j].end_minute) {
+                slots[i].overlapping.push_back(static_cast<int>(j));
+                if (j != i) {
+                    slots[j].overlapping.push_back(static_cast<int>(i));
+                }
+            }
+        }
+    }
+
+    first_day = slots.front().day;
+    day_count = static_cast<size_t>(slots.back().day - first_day + 1);
+    slot_words = (slots.size() + 63) / 64;
+    day_words = (day_count + 63) / 64;
+    venue_busy.assign(venues.size() * slot_words, 0);
+    all_venues_busy.assign(slot_words, 0);
+}
+
+// Queue a fixture between the given teams and return its position in the queue
+size_t SeasonScheduler::addFixture(const std::string& name, const std::vector<Team*>& teams) {
+    if (name.empty()) {
+        throw std::invalid_argument("Fixture name cannot be empty");
+    }
+    for (auto team : teams) {
+        if (team == nullptr) {
+            throw std::invalid_argument("Team pointer is null");
+        }
+    }
+    fixtures.push_back({ name, teams, 0, {}, {} });
+    return fixtures.size() - 1;
+}
+
+// Queue a fixture that may not be played before the given date
+size_t SeasonScheduler::addFixture(const std::string& name, const std::vector<Team*>& teams, const std::string& not_before_date) {
+    const size_t index = addFixture(name, teams);
+    const long long day = Date::parse(not_before_date).getDayNumber();
+    auto first = std::lower_bound(slots.begin(), slots.end(), day, [](const Slot& slot, long long value) {
+        return slot.day < value;
+        });
+    fixtures.back().not_before = static_cast<int>(first - slots.begin());
+    return index;
+}
+
+// Queue a fixture that starts only after the given earlier fixtures have finished
+// Reserved teams are not attached to the event, but their people and rest days are
+// blocked, e.g. every team that could still reach a knockout match
+// Throws an exception if a dependency is not an earlier fixture in the queue
+size_t SeasonScheduler::addFixture(const std::string& name, const std::vector<Team*>& teams,
+                                   const std::vector<Team*>& reserved, const std::vector<size_t>& after) {
+    for (size_t dependency : after) {
+        if (dependency >= fixtures.size()) {
+            throw std::invalid_argument("Fixture can only depend on fixtures queued before it");
+        }
+    }
+    for (auto team : reserved) {
+        if (team == nullptr) {
+            throw std::invalid_argument("Team pointer is null");
+        }
+    }
+    const size_t index = addFixture(name, teams);
+    fixtures.back().reserved = reserved;
+    fixtures.back().after = after;
+    return index;
+}
+
+// Get the dense bitset row for a member or coach, creating it on first use
+int SeasonScheduler::resourceId(const void* key) {
+    auto it = resource_ids.find(key);
+    if (it != resource_ids.end()) {
+        return it->second;
+    }
+    const int id = static_cast<int>(resource_ids.size());
+    resource_ids.emplace(key, id);
+    resource_busy.resize(resource_busy.size() + slot_words, 0);
+    return id;
+}
+
+// Collect the distinct members and coaches of the given teams
+std::vector<int> SeasonScheduler::resourcesOf(const std::vector<Team*>& teams) {
+    std::vector<int> result;
+    for (auto team : teams) {
+        if (team->getCoach() != nullptr) {
+            result.push_back(resourceId(team->getCoach()));
+        }
+        for (auto member : team->getMembers()) {
+            result.push_back(resourceId(member));
+        }
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+// Mark a slot and every slot overlapping it as busy in one bitset row
+void SeasonScheduler::markBusy(std::vector<std::uint64_t>& bits, size_t offset, int slot) {
+    for (int other : slots[slot].overlapping) {
+        setBit(bits, offset, other);
+    }
+}
+
+// Block venues, people and rest days already taken by events in the club
+void SeasonScheduler::loadExistingEvents() {
+    const long long last_day = first_day + static_cast<long long>(day_count) - 1;
+    for (auto event : club.getEvents()) {
+        const long long start = event->getStartStamp();
+        const long long end = event->getEndStamp();
+        const long long day = event->getCalendarDate().getDayNumber();
+        if (day < first_day || day > last_day) {
+            continue;
+        }
+
+        auto venue = std::find(venues.begin(), venues.end(), event->getLocation());
+        std::vector<const void*> people;
+        for (auto member : event->getParticipants()) {
+            people.push_back(member);
+        }
+        for (auto team : event->getTeams()) {
+            if (team->getCoach() != nullptr) {
+                people.push_back(team->getCoach());
+            }
+            auto rest = team_rest.find(team);
+            if (rest != team_rest.end()) {
+                for (long long d = day - rest_days; d <= day + rest_days; ++d) {
+                    if (d >= first_day && d <= last_day) {
+                        setBit(rest->second, 0, static_cast<size_t>(d - first_day));
+                    }
+                }
+            }
+        }
+
+        auto first = std::lower_bound(slots.begin(), slots.end(), day, [](const Slot& slot, long long value) {
+            return slot.day < value;
+            });
+        for (auto it = first; it != slots.end() && it->day == day; ++it) {
+            const long long slot_start = it->day * MINUTES_PER_DAY + it->start_minute;
+            const long long slot_end = it->day * MINUTES_PER_DAY + it->end_minute;
+            if (slot_start >= end || start >= slot_end) {
+                continue;
+            }
+            const size_t index = static_cast<size_t>(it - slots.begin());
+            if (venue != venues.end()) {
+                setBit(venue_busy, static_cast<size_t>(venue - venues.begin()) * slot_words, index);
+            }
+            for (auto person : people) {
+                auto id = resource_ids.find(person);
+                if (id != resource_ids.end()) {
+                    setBit(resource_busy, static_cast<size_t>(id->second) * slot_words, index);
+                }
+            }
+        }
+    }
+
+    for (size_t slot = 0; slot < slots.size(); ++slot) {
+        bool full = true;
+        for (size_t v = 0; v < venues.size() && full; ++v) {
+            full = testBit(venue_busy, v * slot_words, slot);
+        }
+        if (full) {
+            setBit(all_venues_busy, 0, slot);
+        }
+    }
+}
+
+// Get the first slot starting once the given slot has ended
+int SeasonScheduler::firstSlotAfter(int slot) const {
+    const long long day = slots[slot].day;
+    const int end = slots[slot].end_minute;
+    auto first = std::lower_bound(slots.begin() + slot, slots.end(), std::make_pair(day, end),
+        [](const Slot& other, const std::pair<long long, int>& value) {
+            return other.day < value.first || (other.day == value.first && other.start_minute < value.second);
+        });
+    return static_cast<int>(first - slots.begin());
+}
+
+// Place every queued fixture in queue order, first free slot first
+// Placed fixtures become club-built events with their teams attached through the club,
+// so the club owns them; fixtures that fit nowhere are reported by getUnplaced()
+std::vector<Event*> SeasonScheduler::schedule() {
+    std::vector<Event*> placed;
+    unplaced.clear();
+    placements.assign(fixtures.size(), nullptr);
+    std::vector<int> placed_slot(fixtures.size(), -1);
+
+    std::unordered_map<const Team*, std::vector<int>> team_resources;
+    for (const auto& fixture : fixtures) {
+        for (const auto* list : { &fixture.teams, &fixture.reserved }) {
+            for (auto team : *list) {
+                if (team_resources.find(team) == team_resources.end()) {
+                    team_resources.emplace(team, resourcesOf({ team }));
+                    team_rest.emplace(team, std::vector<std::uint64_t>(day_words, 0));
+                }
+            }
+        }
+    }
+    loadExistingEvents();
+
+    std::vector<std::uint64_t> busy(slot_words);
+    std::vector<std::uint64_t> rest(day_words);
+    for (size_t index = 0; index < fixtures.size(); ++index) {
+        const Fixture& fixture = fixtures[index];
+
+        // A fixture waits for its dependencies; if one was not placed neither is this one
+        int not_before = fixture.not_before;
+        bool blocked = false;
+        for (size_t dependency : fixture.after) {
+            if (placed_slot[dependency] < 0) {
+                blocked = true;
+                break;
+            }
+            not_before = std::max(not_before, firstSlotAfter(placed_slot[dependency]));
+        }
+        if (blocked || not_before >= static_cast<int>(slots.size())) {
+            unplaced.push_back(fixture.name);
+            continue;
+        }
+
+        // Incremental conflict mask: only the people and teams in this fixture are consulted
+        busy = all_venues_busy;
+        std::fill(rest.begin(), rest.end(), 0);
+        std::vector<Team*> involved = fixture.teams;
+        involved.insert(involved.end(), fixture.reserved.begin(), fixture.reserved.end());
+        std::vector<int> people;
+        for (auto team : involved) {
+            const auto& ids = team_resources[team];
+            people.insert(people.end(), ids.begin(), ids.end());
+            const auto& team_days = team_rest[team];
+            for (size_t w = 0; w < day_words; ++w) {
+                rest[w] |= team_days[w];
+            }
+        }
+        std::sort(people.begin(), people.end());
+        people.erase(std::unique(people.begin(), people.end()), people.end());
+        for (int id : people) {
+            const std::uint64_t* row = &resource_busy[static_cast<size_t>(id) * slot_words];
+            for (size_t w = 0; w < slot_words; ++w) {
+                busy[w] |= row[w];
+            }
+        }
+
+        int chosen_slot = -1;
+        size_t chosen_venue = 0;
+        for (size_t w = static_cast<size_t>(not_before) / 64; w < slot_words && chosen_slot < 0; ++w) {
+            std::uint64_t free_bits = ~busy[w];
+            if (w == static_cast<size_t>(not_before) / 64) {
+                free_bits &= ~std::uint64_t(0) << (not_before % 64);
+            }
+            while (free_bits != 0) {
+                const size_t slot = w * 64 + static_cast<size_t>(countTrailingZeros(free_bits));
+                free_bits &= free_bits - 1;
+                if (slot >= slots.size()) {
+                    break;
+                }
+                if (testBit(rest, 0, static_cast<size_t>(slots[slot].day - first_day))) {
+                    continue;
+                }
+                for (size_t v = 0; v < venues.size(); ++v) {
+                    if (!testBit(venue_busy, v * slot_words, slot)) {
+                        chosen_slot = static_cast<int>(slot);
+                        chosen_venue = v;
+                        break;
+                    }
+                }
+                if (chosen_slot >= 0) {
+                    break;
+                }
+            }
+        }
+
+        if (chosen_slot < 0) {
+            unplaced.push_back(fixture.name);
+            continue;
+        }
+
+        // Commit the booking to the venue, the people and the teams' rest days
+        const Slot& slot = slots[chosen_slot];
+        markBusy(venue_busy, chosen_venue * slot_words, chosen_slot);
+        for (int other : slot.overlapping) {
+            bool full = true;
+            for (size_t v = 0; v < venues.size() && full; ++v) {
+                full = testBit(venue_busy, v * slot_words, other);
+            }
+            if (full) {
+                setBit(all_venues_busy, 0, other);
+            }
+        }
+        for (int id : people) {
+            markBusy(resource_busy, static_cast<size_t>(id) * slot_words, chosen_slot);
+        }
+        const long long day = slot.day - first_day;
+        for (auto team : involved) {
+            auto& team_days = team_rest[team];
+            for (long long d = day - rest_days; d <= day + rest_days; ++d) {
+                if (d >= 0 && d < static_cast<long long>(day_count)) {
+                    setBit(team_days, 0, static_cast<size_t>(d));
+                }
+            }
+        }
+
+        Event* event = club.emplaceEvent(Date(static_cast<std::int32_t>(slot.day)), venues[chosen_venue], fixture.name,
+                                         slot.start_minute, slot.end_minute);
+        for (auto team : fixture.teams) {
+            club.addTeamToEvent(event, team);
+        }
+        placed.push_back(event);
+        placements[index] = event;
+        placed_slot[index] = chosen_slot;
+    }
+
+    fixtures.clear();
+    return placed;
+}
+
+// Get the names of the fixtures the last schedule() call could not place
+std::vector<std::string> SeasonScheduler::getUnplaced() const {
+    return unplaced;
+}
+
+// Get the event of each fixture queued for the last schedule() call, null when unplaced
+std::vector<Event*> SeasonScheduler::getPlacements() const {
+    return placements;
+}
+
+// Get the number of distinct slots in the season
+size_t SeasonScheduler::getSlotCount() const {
+    return slots.size();
+}
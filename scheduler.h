@@ -0,0 +1,79 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Club.h"
+
+// A range of dates with the time slots available on each day
+struct ScheduleWindow {
+    std::string first_date;
+    std::string last_date;
+    std::vector<std::pair<std::string, std::string>> daily_slots;  // start and end times, "HH:MM"
+};
+
+// Places fixtures on a conflict-free calendar for a club
+// Every team, coach and member has a bitset over the season's slots; placing a fixture ORs
+// the bitsets of everyone involved and takes the first free slot with a free venue, so each
+// placement only touches the people in that fixture.
+class SeasonScheduler {
+private:
+    struct Slot {
+        long long day;
+        int start_minute;
+        int end_minute;
+        std::vector<int> overlapping;  // slots on the same day sharing time with this one
+    };
+
+    struct Fixture {
+        std::string name;
+        std::vector<Team*> teams;
+        int not_before;               // first slot index the fixture may use
+        std::vector<Team*> reserved;  // teams that might play, blocked but not attached
+        std::vector<size_t> after;    // earlier fixtures that must finish first
+    };
+
+    Club& club;
+    std::vector<std::string> venues;
+    int rest_days;
+    std::vector<Slot> slots;
+    long long first_day;
+    size_t day_count;
+    size_t slot_words;
+    size_t day_words;
+
+    std::vector<Fixture> fixtures;
+    std::vector<std::string> unplaced;
+    std::vector<Event*> placements;
+
+    std::unordered_map<const void*, int> resource_ids;  // members and coaches
+    std::vector<std::uint64_t> resource_busy;           // resource_count x slot_words
+    std::vector<std::uint64_t> venue_busy;              // venue_count x slot_words
+    std::vector<std::uint64_t> all_venues_busy;         // slot_words
+    std::unordered_map<const Team*, std::vector<std::uint64_t>> team_rest;  // day_words per team
+
+    int resourceId(const void* key);
+    std::vector<int> resourcesOf(const std::vector<Team*>& teams);
+    void markBusy(std::vector<std::uint64_t>& bits, size_t offset, int slot);
+    void loadExistingEvents();
+    int firstSlotAfter(int slot) const;
+
+public:
+    SeasonScheduler(Club& club, const std::vector<std::string>& venues,
+                    const std::vector<ScheduleWindow>& windows, int rest_days);
+
+    size_t addFixture(const std::string& name, const std::vector<Team*>& teams);
+    size_t addFixture(const std::string& name, const std::vector<Team*>& teams, const std::string& not_before_date);
+    size_t addFixture(const std::string& name, const std::vector<Team*>& teams,
+                      const std::vector<Team*>& reserved, const std::vector<size_t>& after);
+
+    std::vector<Event*> schedule();
+    std::vector<std::string> getUnplaced() const;
+    std::vector<Event*> getPlacements() const;
+    size_t getSlotCount() const;
+};
+
+#endif // SCHEDULER_H
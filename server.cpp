@@ -0,0 +1,380 @@
+#include "Server.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+    const size_t READ_CHUNK = 64 * 1024;
+    const int MAX_EVENTS = 64;
+
+    std::system_error systemError(const char* what) {
+        return std::system_error(errno, std::generic_category(), what);
+    }
+
+    MemberRecord recordOf(const Member* member) {
+        return { member->getId(), member->getAge(), member->getName(), member->getRole() };
+    }
+}
+
+// Constructor; binds and listens right away so clients can connect before run()
+// A stale socket file at the path is replaced; any other file there is left alone
+// Throws an exception if the path is too long or the socket cannot be set up
+ClubServer::ClubServer(Club& club, const std::string& socket_path)
+    : club(club), path(socket_path), listen_fd(-1), epoll_fd(-1), wake_fd(-1), stopping(false), accepted(0),
+      answered(0), batches(0), read_buffer(READ_CHUNK) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument("Socket path is empty or too long");
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    struct stat existing;
+    if (::stat(path.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) {
+        ::unlink(path.c_str());
+    }
+
+    try {
+        listen_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listen_fd < 0) {
+            throw systemError("socket");
+        }
+        if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+            throw systemError("bind");
+        }
+        if (::listen(listen_fd, SOMAXCONN) < 0) {
+            throw systemError("listen");
+        }
+        epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+        wake_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epoll_fd < 0 || wake_fd < 0) {
+            throw systemError("epoll");
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = listen_fd;
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &event);
+        event.data.fd = wake_fd;
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &event);
+    }
+    catch (...) {
+        for (int fd : { listen_fd, epoll_fd, wake_fd }) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+        throw;
+    }
+}
+
+// Destructor; closes every connection and removes the socket file
+ClubServer::~ClubServer() {
+    for (const auto& entry : connections) {
+        ::close(entry.first);
+    }
+    ::close(listen_fd);
+    ::close(epoll_fd);
+    ::close(wake_fd);
+    ::unlink(path.c_str());
+}
+
+// Serve requests until stop() is called
+// Throws an exception if waiting for events fails
+void ClubServer::run() {
+    std::vector<epoll_event> events(MAX_EVENTS);
+    while (!stopping.load()) {
+        const int ready = ::epoll_wait(epoll_fd, events.data(), MAX_EVENTS, -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw systemError("epoll_wait");
+        }
+        for (int i = 0; i < ready; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == listen_fd) {
+                acceptAll();
+                continue;
+            }
+            if (fd == wake_fd) {
+                continue;
+            }
+            auto it = connections.find(fd);
+            if (it == connections.end()) {
+                continue;
+            }
+            Connection& connection = it->second;
+            bool open = true;
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                open = readAll(fd, connection);
+                if (open) {
+                    answer(connection);
+                }
+            }
+            if (open && connection.output.size() > connection.sent) {
+                open = flush(fd, connection);
+            }
+            if (!open || (connection.closing && connection.output.size() == connection.sent)) {
+                close(fd);
+            }
+        }
+    }
+}
+
+// Ask run() to return; safe to call from any thread, including signal-driven ones
+void ClubServer::stop() {
+    stopping.store(true);
+    const std::uint64_t one = 1;
+    if (::write(wake_fd, &one, sizeof(one)) < 0) {
+        // The counter is already non-zero, so the loop wakes anyway
+    }
+}
+
+// Get the server's counters
+ServerStats ClubServer::getStats() const {
+    return { accepted.load(), answered.load(), batches.load() };
+}
+
+// Getter for the socket path
+const std::string& ClubServer::getPath() const {
+    return path;
+}
+
+// Accept every pending connection
+void ClubServer::acceptAll() {
+    while (true) {
+        const int fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLET;
+        event.data.fd = fd;
+        if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            ::close(fd);
+            continue;
+        }
+        connections[fd];
+        ++accepted;
+    }
+}
+
+// Read everything the peer has sent so far; the socket is edge-triggered, so this
+// drains it until the kernel has nothing more
+// A peer that shut down its side still gets answers to what it sent before closing
+// Returns false if the connection failed
+bool ClubServer::readAll(int fd, Connection& connection) {
+    while (!connection.closing) {
+        const ssize_t got = ::read(fd, read_buffer.data(), read_buffer.size());
+        if (got > 0) {
+            connection.input.append(read_buffer.data(), static_cast<size_t>(got));
+            continue;
+        }
+        if (got == 0) {
+            connection.closing = true;
+            return true;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+    return true;
+}
+
+// Answer every complete request in the input buffer, in order
+// A malformed frame header leaves the stream unreadable, so the rest of the input is
+// dropped and the connection is answered with an error and closed after the flush
+void ClubServer::answer(Connection& connection) {
+    std::string& input = connection.input;
+    size_t& at = connection.consumed;
+    while (at < input.size()) {
+        size_t length = 0;
+        try {
+            length = frameLength(input.data() + at, input.size() - at);
+        }
+        catch (const std::invalid_argument& e) {
+            const size_t frame = connection.output.beginFrame(static_cast<std::uint8_t>(ClubStatus::Error));
+            connection.output.str(e.what());
+            connection.output.endFrame(frame);
+            ++answered;
+            at = input.size();
+            connection.closing = true;
+            break;
+        }
+        if (length == 0 || input.size() - at < length) {
+            break;
+        }
+        WireReader in(input.data() + at + 5, length - 5);
+        const auto kind = static_cast<ClubRequest>(static_cast<std::uint8_t>(input[at + 4]));
+        WireWriter& out = connection.output;
+        size_t frame = out.beginFrame(static_cast<std::uint8_t>(ClubStatus::Ok));
+        try {
+            handle(kind, in, out);
+        }
+        catch (const std::exception& e) {
+            out.truncate(frame);
+            frame = out.beginFrame(static_cast<std::uint8_t>(ClubStatus::Error));
+            out.str(e.what());
+        }
+        out.endFrame(frame);
+        ++answered;
+        at += length;
+    }
+    if (at == input.size()) {
+        input.clear();
+        at = 0;
+    }
+    else if (at > READ_CHUNK) {
+        input.erase(0, at);
+        at = 0;
+    }
+}
+
+// Run one request against the club and write the response body
+// The Ok status is already written; NotFound is signalled by rewriting it
+// Throws an exception if the request is malformed or the club rejects it
+void ClubServer::handle(ClubRequest kind, WireReader& in, WireWriter& out) {
+    auto notFound = [&out]() {
+        out.bytes()[out.size() - 1] = static_cast<char>(ClubStatus::NotFound);
+    };
+    switch (kind) {
+    case ClubRequest::Ping:
+        return;
+    case ClubRequest::FindMemberById: {
+        const Member* member = club.findMemberById(in.i32());
+        if (member != nullptr) {
+            out.member(recordOf(member));
+        }
+        else {
+            notFound();
+        }
+        return;
+    }
+    case ClubRequest::FindMemberByName: {
+        const Member* member = club.findMemberByName(in.str());
+        if (member != nullptr) {
+            out.member(recordOf(member));
+        }
+        else {
+            notFound();
+        }
+        return;
+    }
+    case ClubRequest::SearchMembers: {
+        const std::string query = in.str();
+        const int max_distance = in.u8();
+        const auto matches = club.searchMembersByName(query, max_distance, in.u16());
+        out.u16(static_cast<std::uint16_t>(matches.size()));
+        for (const auto& match : matches) {
+            out.member(recordOf(match.item));
+        }
+        return;
+    }
+    case ClubRequest::AddMember: {
+        std::string name = in.str();
+        const int age = in.i32();
+        std::string role = in.str();
+        club.emplaceMember(std::move(name), age, std::move(role), in.i32());
+        return;
+    }
+    case ClubRequest::RemoveMember: {
+        Member* member = club.findMemberById(in.i32());
+        if (member == nullptr || club.removeMembers({ member }) == 0) {
+            notFound();
+        }
+        return;
+    }
+    case ClubRequest::SignUp: {
+        const std::string event = in.str();
+        Member* member = club.findMemberById(in.i32());
+        if (member == nullptr) {
+            notFound();
+            return;
+        }
+        // An admitted sign-up always adds a participant, so an unchanged count means no such event
+        const size_t before = club.getParticipantCount(event);
+        const std::vector<Rejection> rejected = club.addMembersToEvent(event, { member });
+        if (!rejected.empty()) {
+            throw std::invalid_argument(std::string("Member is not eligible: ") +
+                                        EligibilityCheck::reasonName(rejected.front().reason));
+        }
+        if (club.getParticipantCount(event) == before) {
+            notFound();
+        }
+        return;
+    }
+    case ClubRequest::ScheduleConflict: {
+        const std::string location = in.str();
+        const std::string date = in.str();
+        const std::string start = in.str();
+        const std::string end = in.str();
+        out.u8(club.hasScheduleConflict(location, date, start, end) ? 1 : 0);
+        return;
+    }
+    case ClubRequest::ParticipantCount:
+        out.u32(static_cast<std::uint32_t>(club.getParticipantCount(in.str())));
+        return;
+    case ClubRequest::SearchEvents: {
+        const std::string query = in.str();
+        const auto matches = club.searchEvents(query, in.u16());
+        out.u16(static_cast<std::uint16_t>(matches.size()));
+        for (const auto& match : matches) {
+            out.str(match.item->getName());
+        }
+        return;
+    }
+    }
+    throw std::invalid_argument("Unknown request kind");
+}
+
+// Write as much pending output as the socket takes, waiting for writability if it fills up
+// Returns false if the connection failed
+bool ClubServer::flush(int fd, Connection& connection) {
+    std::string& output = connection.output.bytes();
+    while (connection.sent < output.size()) {
+        const ssize_t put = ::send(fd, output.data() + connection.sent, output.size() - connection.sent, MSG_NOSIGNAL);
+        if (put < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return false;
+            }
+            if (!connection.writable_wait) {
+                epoll_event event{};
+                event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+                event.data.fd = fd;
+                ::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+                connection.writable_wait = true;
+            }
+            return true;
+        }
+        connection.sent += static_cast<size_t>(put);
+    }
+    ++batches;
+    output.clear();
+    connection.sent = 0;
+    if (connection.writable_wait) {
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLET;
+        event.data.fd = fd;
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event);
+        connection.writable_wait = false;
+    }
+    return true;
+}
+
+// Drop a connection
+void ClubServer::close(int fd) {
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections.erase(fd);
+}
@@ -0,0 +1,69 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Club.h"
+#include "Protocol.h"
+
+// Counters of a running server; readable from any thread
+struct ServerStats {
+    std::uint64_t connections;  // accepted so far
+    std::uint64_t requests;     // answered so far
+    std::uint64_t batches;      // response writes, each carrying every answer ready at the time
+};
+
+// Serves one club to local processes over a UNIX domain socket
+// A single thread runs an epoll loop over the listening socket and every connection.
+// Each wakeup reads everything a connection has sent, answers every complete request
+// in order and sends all the answers in one write, so pipelining clients pay one
+// system call per batch rather than per request. The club is only touched from the
+// loop thread, so it needs no locking; other threads must leave it alone while run()
+// is active.
+class ClubServer {
+private:
+    struct Connection {
+        std::string input;
+        size_t consumed = 0;   // bytes of input already answered
+        WireWriter output;
+        size_t sent = 0;       // bytes of output already written
+        bool writable_wait = false;
+        bool closing = false;  // close once the output is flushed
+    };
+
+    Club& club;
+    std::string path;
+    int listen_fd;
+    int epoll_fd;
+    int wake_fd;
+    std::unordered_map<int, Connection> connections;
+    std::atomic<bool> stopping;
+    std::atomic<std::uint64_t> accepted;
+    std::atomic<std::uint64_t> answered;
+    std::atomic<std::uint64_t> batches;
+    std::vector<char> read_buffer;
+
+    void acceptAll();
+    bool readAll(int fd, Connection& connection);
+    void answer(Connection& connection);
+    void handle(ClubRequest kind, WireReader& in, WireWriter& out);
+    bool flush(int fd, Connection& connection);
+    void close(int fd);
+
+public:
+    ClubServer(Club& club, const std::string& socket_path);
+    ~ClubServer();
+
+    ClubServer(const ClubServer&) = delete;
+    ClubServer& operator=(const ClubServer&) = delete;
+
+    void run();
+    void stop();
+    ServerStats getStats() const;
+    const std::string& getPath() const;
+};
+
+#endif // SERVER_H
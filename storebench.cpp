@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Club.h"
+#include "MemberStore.h"
+
+// Cold-start and warm lookup latency of the disk-backed member store
+// Build with the club sources, e.g. g++ -O2 -std=c++17 storebench.cpp memberstore.cpp btree.cpp club.cpp ... -o storebench,
+// and run as ./storebench --members 1000000 --lookups 20000 --hot 2000 --cache-pages 4096.
+// The store file is filled once and reused by later runs with the same member count.
+// Lookups draw from a hot set of --hot random ids. Each cold pass starts with the buffer
+// pool and the kernel's copy of the file dropped, as after a restart; the warm pass
+// repeats the same lookups, whose pages the cold pass left in the pool.
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    void usage() {
+        std::fprintf(stderr, "usage: storebench [--path FILE] [--members N] [--lookups N] [--hot N] [--cache-pages N]\n");
+        std::exit(2);
+    }
+
+    size_t count(const char* text) {
+        return static_cast<size_t>(std::stoull(text));
+    }
+
+    std::string nameOf(int id) {
+        return "Registry Member " + std::to_string(id);
+    }
+
+    // Print the mean and percentiles of per-lookup latencies in microseconds
+    void report(const char* label, std::vector<double>& micros, size_t found) {
+        std::sort(micros.begin(), micros.end());
+        double total = 0;
+        for (double value : micros) {
+            total += value;
+        }
+        auto at = [&micros](double fraction) {
+            return micros[std::min(micros.size() - 1, static_cast<size_t>(fraction * micros.size()))];
+        };
+        std::printf("%-16s %9zu %10.2f %10.2f %10.2f %10.2f %8zu\n", label, micros.size(), total / micros.size(),
+                    at(0.5), at(0.99), micros.back(), found);
+    }
+
+    // Time each call of a lookup over the sample
+    template <typename Lookup>
+    void measure(const char* label, const std::vector<int>& sample, Lookup lookup) {
+        std::vector<double> micros;
+        micros.reserve(sample.size());
+        size_t found = 0;
+        for (int id : sample) {
+            const auto start = Clock::now();
+            found += lookup(id);
+            micros.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        }
+        report(label, micros, found);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string path = "/tmp/club_members.db";
+    size_t members = 1000000;
+    size_t lookups = 20000;
+    size_t hot = 2000;
+    size_t cache_pages = 4096;
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string flag = argv[i];
+            if (i + 1 >= argc) {
+                usage();
+            }
+            const char* value = argv[++i];
+            if (flag == "--path") {
+                path = value;
+            }
+            else if (flag == "--members") {
+                members = count(value);
+            }
+            else if (flag == "--lookups") {
+                lookups = count(value);
+            }
+            else if (flag == "--hot") {
+                hot = count(value);
+            }
+            else if (flag == "--cache-pages") {
+                cache_pages = count(value);
+            }
+            else {
+                usage();
+            }
+        }
+        if (members == 0 || lookups == 0 || hot == 0) {
+            usage();
+        }
+
+        {
+            MemberStore store(path, cache_pages);
+            if (store.size() != members) {
+                std::printf("filling %s with %zu members\n", path.c_str(), members);
+                const auto start = Clock::now();
+                for (size_t id = 0; id < members; ++id) {
+                    store.put({ static_cast<int>(id), 18 + static_cast<int>(id % 40), nameOf(static_cast<int>(id)),
+                                "Athlete" });
+                }
+                store.flush();
+                std::printf("filled in %.1f s\n", std::chrono::duration<double>(Clock::now() - start).count());
+            }
+            const MemberStoreStats stats = store.getStats();
+            std::printf("%zu members in %zu pages (%.1f MB), cache of %zu pages\n", stats.members, stats.file_pages,
+                        stats.file_pages * PAGE_SIZE / 1e6, cache_pages);
+        }
+
+        std::mt19937_64 rng(42);
+        std::vector<int> hot_ids(hot);
+        for (auto& id : hot_ids) {
+            id = static_cast<int>(rng() % members);
+        }
+        std::vector<int> sample(lookups);
+        for (auto& id : sample) {
+            id = hot_ids[rng() % hot];
+        }
+
+        std::printf("%-16s %9s %10s %10s %10s %10s %8s\n", "lookup", "calls", "mean us", "p50 us", "p99 us", "max us",
+                    "found");
+        {
+            const auto start = Clock::now();
+            MemberStore store(path, cache_pages);
+            store.dropCache();
+            std::printf("store opened in %.3f ms\n",
+                        std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            MemberRecord record;
+            measure("store id cold", sample, [&](int id) { return store.find(id, record); });
+            measure("store id warm", sample, [&](int id) { return store.find(id, record); });
+            store.dropCache();
+            measure("store name cold", sample, [&](int id) { return store.findByName(nameOf(id), record); });
+            measure("store name warm", sample, [&](int id) { return store.findByName(nameOf(id), record); });
+            const BufferStats cache = store.getStats().cache;
+            std::printf("store cache: %llu hits, %llu misses, %llu evictions\n",
+                        static_cast<unsigned long long>(cache.hits), static_cast<unsigned long long>(cache.misses),
+                        static_cast<unsigned long long>(cache.evictions));
+        }
+        {
+            // Through the club, a warm lookup finds the member already loaded in memory
+            Club club("Registry");
+            club.openMemberStore(path, cache_pages).dropCache();
+            measure("club id cold", sample, [&](int id) { return club.findMemberById(id) != nullptr; });
+            measure("club id warm", sample, [&](int id) { return club.findMemberById(id) != nullptr; });
+            club.unloadMembers();
+            measure("club id paged", sample, [&](int id) { return club.findMemberById(id) != nullptr; });
+        }
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "storebench: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -1,78 +1,225 @@
-#include "Team.h"
-#include <algorithm>
-
-// Constructor to initialize a Team object with sport type, coach, and ID
-// Throws an exception if sport type is empty, coach is null, or ID is negative
-Team::Team(const std::string& sport_type, Coach* coach, int id)
-    : sport_type(sport_type), coach(coach), id(id) {
-    if (sport_type.empty()) {
-        throw std::invalid_argument("Sport type cannot be empty");
-    }
-    if (coach == nullptr) {
-        throw std::invalid_argument("Coach cannot be null");
-    }
-    if (id < 0) {
-        throw std::invalid_argument("Team ID cannot be negative");
-    }
-}
-
-// Method to add a member to the team
-void Team::addMember(Member* member) {
-    members.push_back(member);
-}
-
-// Method to remove a member from the team
-void Team::removeMember(Member* member) {
-    auto it = std::find(members.begin(), members.end(), member);
-    if (it != members.end()) {
-        members.erase(it);
-    }
-}
-
-// Method to set the coach of the team
-void Team::setCoach(Coach* coach) {
-    this->coach = coach;
-}
-
-// Getter for the sport type of the team
-std::string Team::getSportType() const {
-    return sport_type;
-}
-
-// Getter for the members of the team
-std::vector<Member*> Team::getMembers() const {
-    return members;
-}
-
-// Getter for the coach of the team
-Coach* Team::getCoach() const {
-    return coach;
-}
-
-// Getter for the ID of the team
-int Team::getId() const {
-    return id;
-}
-
-// Method to remove the coach from the team
-void Team::removeCoach() {
-    coach = nullptr;
-}
-
-// Equality operator to compare two teams
-bool Team::operator==(const Team& other) const {
-    return sport_type == other.sport_type && coach == other.coach && members == other.members;
-}
-
-// Operator to combine two teams
-Team Team::operator+(const Team& other) const {
-    Team combined_team(sport_type, coach, id);
-    combined_team.members = members;
-    combined_team.members.insert(combined_team.members.end(), other.members.begin(), other.members.end());
-    return combined_team;
-}
-
-// Method to get the count of members in the team
-size_t Team::getMemberCount() const {
-    return members.size();
-}
+#include "Team.h"
+#include <algorithm>
+#include <unordered_set>
+#include "Event.h"
+
+// Constructor to initialize a Team object with sport type, coach, and ID
+// The sport type is taken by value and moved in, so an rvalue argument is never copied
+// Throws an exception if sport type is empty, coach is null, or ID is negative
+Team::Team(std::string sport_type, Coach* coach, int id)
+    : sport_type(std::move(sport_type)), coach(coach), id(id) {
+    if (this->sport_type.empty()) {
+        throw std::invalid_argument("Sport type cannot be empty");
+    }
+    if (coach == nullptr) {
+        throw std::invalid_argument("Coach cannot be null");
+    }
+    if (id < 0) {
+        throw std::invalid_argument("Team ID cannot be negative");
+    }
+    attachToCoach();
+}
+
+// Constructor for teams derived from an existing one, which may have no coach
+Team::Team(const std::string& sport_type, int id)
+    : sport_type(sport_type), coach(nullptr), id(id) {}
+
+// Copy constructor; the copy is registered with the coach but not with any event
+Team::Team(const Team& other)
+    : sport_type(other.sport_type), members(other.members), coach(other.coach), id(other.id) {
+    attachToCoach();
+}
+
+// Move constructor; the new team takes over the roster and is registered with the coach,
+// but events keep referring to the original team
+Team::Team(Team&& other) noexcept
+    : sport_type(std::move(other.sport_type)), members(std::move(other.members)), coach(other.coach), id(other.id) {
+    other.members.clear();
+    attachToCoach();
+}
+
+// Copy assignment; the team keeps its own events
+Team& Team::operator=(const Team& other) {
+    if (this != &other) {
+        detachFromCoach();
+        sport_type = other.sport_type;
+        members = other.members;
+        coach = other.coach;
+        id = other.id;
+        attachToCoach();
+    }
+    return *this;
+}
+
+// Destructor to unregister the team from its coach and events
+Team::~Team() {
+    detachFromCoach();
+    for (auto event : events) {
+        auto it = std::find(event->teams.begin(), event->teams.end(), this);
+        if (it != event->teams.end()) {
+            event->teams.erase(it);
+        }
+    }
+}
+
+// Register the team in its coach's reverse index
+void Team::attachToCoach() {
+    if (coach != nullptr) {
+        coach->teams.push_back(this);
+    }
+}
+
+// Remove the team from its coach's reverse index
+void Team::detachFromCoach() {
+    if (coach != nullptr) {
+        auto it = std::find(coach->teams.begin(), coach->teams.end(), this);
+        if (it != coach->teams.end()) {
+            coach->teams.erase(it);
+        }
+    }
+}
+
+// Method to add a member to the team
+void Team::addMember(Member* member) {
+    members.push_back(member);
+}
+
+// Method to remove a member from the team
+void Team::removeMember(Member* member) {
+    auto it = std::find(members.begin(), members.end(), member);
+    if (it != members.end()) {
+        members.erase(it);
+    }
+}
+
+// Remove every roster entry of the given members in one pass
+// Returns the number of entries removed
+size_t Team::removeMembers(const std::unordered_set<const Member*>& doomed) {
+    const size_t before = members.size();
+    members.erase(std::remove_if(members.begin(), members.end(), [&doomed](const Member* member) {
+        return doomed.count(member) != 0;
+        }), members.end());
+    return before - members.size();
+}
+
+// Method to set the coach of the team
+void Team::setCoach(Coach* coach) {
+    if (this->coach == coach) {
+        return;
+    }
+    detachFromCoach();
+    this->coach = coach;
+    attachToCoach();
+}
+
+// Getter for the sport type of the team
+std::string Team::getSportType() const {
+    return sport_type;
+}
+
+// Getter for the members of the team
+std::vector<Member*> Team::getMembers() const {
+    return members;
+}
+
+// Getter for the coach of the team
+Coach* Team::getCoach() const {
+    return coach;
+}
+
+// Getter for the events the team is attached to
+std::vector<Event*> Team::getEvents() const {
+    return events;
+}
+
+// Getter for the ID of the team
+int Team::getId() const {
+    return id;
+}
+
+// Method to remove the coach from the team
+void Team::removeCoach() {
+    detachFromCoach();
+    coach = nullptr;
+}
+
+// Equality operator to compare two teams
+bool Team::operator==(const Team& other) const {
+    return sport_type == other.sport_type && coach == other.coach && members == other.members;
+}
+
+// Operator to combine two teams
+// Members of both teams appear once, in order of first appearance
+Team Team::operator+(const Team& other) const {
+    Team combined_team(*this);
+    combined_team.mergeFrom(other);
+    return combined_team;
+}
+
+// Append the members of another team that are not already in this team
+// The roster grows with at most one allocation and duplicates are found by hashing
+void Team::mergeFrom(const Team& other) {
+    if (&other == this) {
+        return;
+    }
+    std::unordered_set<const Member*> seen(members.begin(), members.end());
+    members.reserve(members.size() + other.members.size());
+    for (auto member : other.members) {
+        if (seen.insert(member).second) {
+            members.push_back(member);
+        }
+    }
+}
+
+// Take over the members of another team, leaving it empty
+// When this team is empty the other roster is moved over without copying
+void Team::mergeFrom(Team&& other) {
+    if (&other == this) {
+        return;
+    }
+    if (members.empty()) {
+        std::unordered_set<const Member*> seen;
+        seen.reserve(other.members.size());
+        members = std::move(other.members);
+        members.erase(std::remove_if(members.begin(), members.end(), [&seen](Member* member) {
+            return !seen.insert(member).second;
+            }), members.end());
+    }
+    else {
+        mergeFrom(static_cast<const Team&>(other));
+    }
+    other.members.clear();
+}
+
+// Move the members matching the predicate into a new team with the same sport and coach
+// The remaining members keep their order; the new team is not attached to any event
+Team Team::splitBy(const std::function<bool(const Member*)>& predicate, int new_id) {
+    if (new_id < 0) {
+        throw std::invalid_argument("Team ID cannot be negative");
+    }
+    Team split_team(sport_type, new_id);
+    split_team.coach = coach;
+    split_team.attachToCoach();
+    auto keep_end = std::stable_partition(members.begin(), members.end(), [&predicate](const Member* member) {
+        return !predicate(member);
+        });
+    split_team.members.assign(keep_end, members.end());
+    members.erase(keep_end, members.end());
+    return split_team;
+}
+
+// Method to get the count of members in the team
+size_t Team::getMemberCount() const {
+    return members.size();
+}
+
+// Get the approximate heap memory used by the roster and event list in bytes
+size_t Team::memoryUsage() const {
+    return members.capacity() * sizeof(Member*) + events.capacity() * sizeof(Event*);
+}
+
+// Release spare roster and event list capacity
+void Team::shrinkToFit() {
+    members.shrink_to_fit();
+    events.shrink_to_fit();
+}
@@ -1,35 +1,59 @@
-#ifndef TEAM_H
-#define TEAM_H
-
-#include <vector>
-#include <string>
-#include "Member.h"
-#include "Coach.h"
-
-class Team {
-private:
-    std::string sport_type;
-    std::vector<Member*> members;
-    Coach* coach;
-    int id;
-
-public:
-   
-    Team(const std::string& sportType, Coach* coach, int id);
-
-    void addMember(Member* member);
-    void removeMember(Member* member);
-    void setCoach(Coach* coach);
-
-    std::string getSportType() const;
-    std::vector<Member*> getMembers() const;
-    Coach* getCoach() const;
-  
-    void removeCoach();
-    bool operator==(const Team& other) const;
-    Team operator+(const Team& other) const;
-    int getId() const;
-    size_t getMemberCount() const;
-};
-
-#endif // TEAM_H
+#ifndef TEAM_H
+#define TEAM_H
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <unordered_set>
+#include "Member.h"
+#include "Coach.h"
+
+class Event;
+
+class Team {
+private:
+    std::string sport_type;
+    std::vector<Member*> members;
+    Coach* coach;
+    int id;
+    std::vector<Event*> events;  // events the team is attached to, maintained by Event
+
+    Team(const std::string& sport_type, int id);
+
+    void attachToCoach();
+    void detachFromCoach();
+
+    friend class Coach;
+    friend class Event;
+
+public:
+   
+    Team(std::string sportType, Coach* coach, int id);
+    Team(const Team& other);
+    Team(Team&& other) noexcept;
+    Team& operator=(const Team& other);
+    ~Team();
+
+    void addMember(Member* member);
+    void removeMember(Member* member);
+    size_t removeMembers(const std::unordered_set<const Member*>& doomed);
+    void setCoach(Coach* coach);
+
+    std::string getSportType() const;
+    std::vector<Member*> getMembers() const;
+    Coach* getCoach() const;
+    std::vector<Event*> getEvents() const;
+  
+    void removeCoach();
+    bool operator==(const Team& other) const;
+    Team operator+(const Team& other) const;
+    void mergeFrom(const Team& other);
+    void mergeFrom(Team&& other);
+    Team splitBy(const std::function<bool(const Member*)>& predicate, int new_id);
+    int getId() const;
+    size_t getMemberCount() const;
+    size_t memoryUsage() const;
+    void shrinkToFit();
+};
+
+#endif // TEAM_H
@@ -1,684 +1,2485 @@
-#include <cassert>
-#include <iostream>
-#include "Member.h"
-#include "Coach.h"
-#include "Team.h"
-#include "Event.h"
-#include "Club.h"
-
-// Test functions for Member class
-void testMember() {
-    try {
-        Member* m1 = new Member("John", 30, "Athlete", 1);
-
-        // Verify Member creation and getters
-        assert(m1->getName() == "John");
-        assert(m1->getAge() == 30);
-        assert(m1->getRole() == "Athlete");
-        assert(m1->getId() == 1);
-
-        // Test updating member details
-        m1->updateDetails("John D.", 31);
-        assert(m1->getName() == "John D." && m1->getAge() == 31);
-
-        // Test invalid name update
-        try {
-            m1->updateDetails("", 31);
-            std::cerr << "testMember failed: no exception on empty name" << std::endl;
-        }
-        catch (const std::invalid_argument& e) {
-            std::cout << "Caught expected exception for empty name: " << e.what() << std::endl;
-        }
-
-        // Test invalid age update
-        try {
-            m1->updateDetails("John D.", -5);
-            std::cerr << "testMember failed: no exception on negative age" << std::endl;
-        }
-        catch (const std::invalid_argument& e) {
-            std::cout << "Caught expected exception for negative age: " << e.what() << std::endl;
-        }
-
-        // Test invalid ID
-        try {
-            Member* m2 = new Member("Jane", 25, "Athlete", -1);
-            std::cerr << "testMember failed: no exception on negative ID" << std::endl;
-            delete m2;
-        }
-        catch (const std::invalid_argument& e) {
-            std::cout << "Caught expected exception for negative ID: " << e.what() << std::endl;
-        }
-
-        std::cout << "testMember passed" << std::endl;
-        delete m1;
-    }
-    catch (const std::exception& e) {
-        std::cerr << "testMember failed: " << e.what() << std::endl;
-    }
-    catch (...) {
-        std::cerr << "testMember failed: unknown exception" << std::endl;
-    }
-}
-
-// Test functions for Coach class
-void testCoach() {
-    try {
-        // Correct Creation Test
-        Coach* c1 = new Coach("Jane", "Football", 1);
-        assert(c1->getName() == "Jane");
-        assert(c1->getSpecialty() == "Football");
-        assert(c1->getId() == 1);
-
-        // Specialty Assignment Test (Correct)
-        c1->setSpecialty("Basketball");
-        assert(c1->getSpecialty() == "Basketball");
-
-        // Specialty Assignment Test (Incorrect)
-        try {
-            Coach* c2 = new Coach("John", "", 2);
-            std::cerr << "testCoach failed: no exception on empty specialty" << std::endl;
-            delete c2;
-        }
-        catch (const std::invalid_argument& e) {
-            std::cout << "Caught expected exception for empty specialty: " << e.what() << std::endl;
-        }
-
-        // Test negative ID
-        try {
-            Coach* c3 = new Coach("John", "Football", -1);
-            std::cerr << "testCoach failed: no exception on negative ID" << std::endl;
-            delete c3;
-        }
-        catch (const std::invalid_argument& e) {
-            std::cout << "Caught expected exception for negative ID: " << e.what() << std::endl;
-        }
-
-        std::cout << "testCoach passed" << std::endl;
-        delete c1;
-    }
-    catch (...) {
-        std::cout << "testCoach failed" << std::endl;
-    }
-}
-
-// Test functions for Team class
-void testTeam() {
-    // Adding Member Test (Correct)
-    try {
-        Coach* coach = new Coach("Jane", "Football", 1);
-        Team team("Football", coach, 1);
-
-        Member* member1 = new Member("John", 30, "Athlete", 1);
-        team.addMember(member1);
-
-        assert(team.getMembers().size() == 1);
-        assert(team.getId() == 1);
-        std::cout << "testAddingMember passed" << std::endl;
-
-        delete member1;
-        delete coach;
-    }
-    catch (...) {
-        std::cout << "testAddingMember failed" << std::endl;
-    }
-
-    // Removing Member Test (Correct)
-    try {
-        Coach* coach = new Coach("Jane", "Football", 1);
-        Team team("Football", coach, 1);
-
-        Member* member1 = new Member("John", 30, "Athlete", 1);
-        team.addMember(member1);
-        assert(team.getMembers().size() == 1);
-
-        team.removeMember(member1);
-        assert(team.getMembers().size() == 0);
-        std::cout << "testRemovingMember passed" << std::endl;
-
-        delete member1;
-        delete coach;
-    }
-    catch (...) {
-        std::cout << "testRemovingMember failed" << std::endl;
-    }
-
-    // Removing Non-Existent Member Test (Incorrect)
-    try {
-        Coach* coach = new Coach("Jane", "Football", 1);
-        Team team("Football", coach, 1);
-
-        Member* member1 = new Member("John", 30, "Athlete", 1);
-        Member* member2 = new Member("Jane", 25, "Athlete", 2);
-
-        team.addMember(member1);
-        assert(team.getMembers().size() == 1);
-
-        team.removeMember(member2); // member2 was never added
-        assert(team.getMembers().size() == 1); // Size should remain unchanged
-        std::cout << "testRemovingNonExistentMember passed" << std::endl;
-
-        delete member1;
-        delete member2;
-        delete coach;
-    }
-    catch (...) {
-        std::cout << "testRemovingNonExistentMember failed" << std::endl;
-    }
-
-    // Test negative ID
-    try {
-        Coach* coach = new Coach("Jane", "Football", 1);
-        Team* team = new Team("Football", coach, -1);
-        std::cerr << "testTeam failed: no exception on negative ID" << std::endl;
-        delete team;
-        delete coach;
-    }
-    catch (const std::invalid_argument& e) {
-        std::cout << "Caught expected exception for negative ID: " << e.what() << std::endl;
-    }
-}
-
-// Test functions for Event class
-void testEvent() {
-    bool allTestsPassed = true;
-
-    // Event Creation Test (Correct)
-    try {
-        Event event("2024-05-01", "Stadium", "Football Match");
-        assert(event.getDate() == "2024-05-01");
-        assert(event.getLocation() == "Stadium");
-        assert(event.getName() == "Football Match");
-    }
-    catch (...) {
-        std::cout << "Event Creation Test failed" << std::endl;
-        allTestsPassed = false;
-    }
-
-    // Reschedule Test (Correct)
-    try {
-        Event event("2024-05-01", "Stadium", "Football Match");
-        event.reschedule("2024-06-01");
-        assert(event.getDate() == "2024-06-01");
-    }
-    catch (...) {
-        std::cout << "Reschedule Test failed" << std::endl;
-        allTestsPassed = false;
-    }
-
-    // Add Participant Test (Correct)
-    try {
-        Event event("2024-05-01", "Stadium", "Football Match");
-        Member* member1 = new Member("John", 30, "Athlete", 1);
-        event.addParticipant(member1);
-        assert(event.getParticipantCount() == 1);
-        delete member1;
-    }
-    catch (...) {
-        std::cout << "Add Participant Test failed" << std::endl;
-        allTestsPassed = false;
-    }
-
-    // Add Invalid Participant Test (Incorrect)
-    try {
-        Event event("2024-05-01", "Stadium", "Football Match");
-        try {
-            event.addParticipant(nullptr); // This should fail or be handled appropriately
-            std::cerr << "Add Invalid Participant Test failed: no exception on invalid participant" << std::endl;
-            allTestsPassed = false;
-        }
-        catch (const std::invalid_argument& e) {
-            // Expected exception, do nothing
-        }
-        assert(event.getParticipantCount() == 0);
-    }
-    catch (...) {
-        std::cout << "Add Invalid Participant Test failed" << std::endl;
-        allTestsPassed = false;
-    }
-
-    if (allTestsPassed) {
-        std::cout << "testEvent passed" << std::endl;
-    }
-    else {
-        std::cout << "testEvent failed" << std::endl;
-    }
-}
-
-void testClub() {
-    try {
-      
-        std::cout << "Starting testClub" << std::endl;
-        // Create a Club object named "Sports Club"
-        Club club("Sports Club");
-
-        // Create members
-        std::cout << "Creating members" << std::endl;
-        // Create two Member objects m1 and m2
-        Member* m1 = new Member("John", 30, "Athlete", 1);
-        Member* m2 = new Member("Jane", 25, "Athlete", 2);
-
-        // Add members to the club
-        std::cout << "Adding members" << std::endl;
-        club.addMember(m1);
-        club.addMember(m2);
-        std::cout << "Added members" << std::endl;
-
-        // Update details of member m1
-        std::cout << "Updating member details" << std::endl;
-        m1->updateDetails("John D.", 31);
-        std::cout << "Updated member details" << std::endl;
-
-        // Remove member m1 from the club
-        std::cout << "Removing member" << std::endl;
-        club.removeMember(m1);
-        std::cout << "Removed member" << std::endl;
-        // Delete member object m1 and set pointer to nullptr
-        delete m1;
-        m1 = nullptr;
-
-        // Create and add coach c1 to the club
-        std::cout << "Creating and adding coach" << std::endl;
-        Coach* c1 = new Coach("Jane", "Football", 1);
-        club.addCoach(c1);
-        std::cout << "Added coach" << std::endl;
-
-        // Remove coach c1 from the club
-        std::cout << "Removing coach" << std::endl;
-        club.removeCoach(c1);
-        std::cout << "Removed coach" << std::endl;
-        // Delete coach object c1 and set pointer to nullptr
-        delete c1;
-        c1 = nullptr;
-
-        // Organize an event e1
-        std::cout << "Organizing event" << std::endl;
-        Event* e1 = new Event("2024-04-19", "Stadium", "Football Match");
-        club.organizeEvent(e1);
-        std::cout << "Organized event" << std::endl;
-
-        // Cancel event e1
-        std::cout << "Cancelling event" << std::endl;
-        club.cancelEvent(e1);
-        std::cout << "Cancelled event" << std::endl;
-        // Delete event object e1 and set pointer to nullptr
-        delete e1;
-        e1 = nullptr;
-
-        // Add member to event
-        std::cout << "Adding member to event" << std::endl;
-        e1 = new Event("2024-04-19", "Stadium", "Football Match");
-        club.organizeEvent(e1);
-        club.addMember(m2);
-        std::vector<Member*> members = { m2 };
-        club.addMembersToEvent("Football Match", members);
-        std::cout << "Added members to event" << std::endl;
-        // Verify the number of participants in the event is 1
-        assert(club.getEvents().front()->getParticipants().size() == 1);
-
-        // Create and add coach c2 to the club
-        Coach* c2 = new Coach("Jane", "Football", 1);
-        club.addCoach(c2);
-        // Check if coach c2 exists
-        Coach* foundCoach = club.findCoachByName("Jane");
-        assert(foundCoach != nullptr);
-        // Update the specialty of coach c2
-        club.updateCoachSpecialty("Jane", "Basketball");
-
-        // Test duplicate member ID exception
-        try {
-            Member* m3 = new Member("Jane", 25, "Athlete", 2);
-            club.addMember(m3);
-            std::cerr << "testDuplicateMember failed: no exception on duplicate member ID" << std::endl;
-            delete m3;
-        }
-        catch (const std::invalid_argument& e) {
-            std::cout << "Caught expected exception for duplicate member ID: " << e.what() << std::endl;
-        }
-
-        // Test duplicate coach ID exception
-        try {
-            Coach* c3 = new Coach("Jane", "Football", 1);
-            club.addCoach(c3);
-            std::cerr << "testDuplicateCoach failed: no exception on duplicate coach ID" << std::endl;
-            delete c3;
-        }
-        catch (const std::invalid_argument& e) {
-            std::cout << "Caught expected exception for duplicate coach ID: " << e.what() << std::endl;
-        }
-
-        // Create and add team t1 to the club
-        Team* t1 = new Team("Football", foundCoach, 1);
-        club.addTeam(t1);
-        // Verify the number of teams in the club is 1
-        assert(club.getTeams().size() == 1);
-
-        std::cout << "testClub passed" << std::endl;
-
-        // Delete remaining objects
-        delete m2;
-        delete c2;
-        delete t1;
-    }
-    catch (const std::exception& e) {
-        std::cerr << "testClub failed: " << e.what() << std::endl;
-    }
-    catch (...) {
-        std::cerr << "testClub failed: unknown exception" << std::endl;
-    }
-}
-
-
-// Test deleting a club and all associated objects
-void testDeleteClub() {
-    try {
-        std::cout << "Starting testDeleteClub" << std::endl;
-        Club* myClub = new Club("Sports Club");
-
-        std::cout << "Adding members and coaches" << std::endl;
-        Member* m1 = new Member("John", 30, "Athlete", 1);
-        Member* m2 = new Member("Jane", 25, "Athlete", 2);
-        myClub->addMember(m1);
-        myClub->addMember(m2);
-
-        Coach* c1 = new Coach("Coach A", "Football", 1);
-        myClub->addCoach(c1);
-
-        std::cout << "Organizing event" << std::endl;
-        Event* e1 = new Event("2024-04-19", "Stadium", "Football Match");
-        myClub->organizeEvent(e1);
-
-        std::cout << "Adding team" << std::endl;
-        Team* t1 = new Team("Football", c1, 1);
-        t1->addMember(m1);
-        t1->addMember(m2);
-        myClub->addTeam(t1);
-
-        // Deleting club and all associated objects
-        std::cout << "Deleting club" << std::endl;
-        delete myClub;
-        std::cout << "testDeleteClub passed" << std::endl;
-    }
-    catch (const std::exception& e) {
-        std::cerr << "testDeleteClub failed: " << e.what() << std::endl;
-    }
-    catch (...) {
-        std::cerr << "testDeleteClub failed: unknown exception" << std::endl;
-    }
-}
-
-// Test scheduling conflict for events
-void testEventScheduleConflict() {
-    try {
-        Club club("Sports Club");
-
-        Event* e1 = new Event("2024-04-19", "Stadium", "Football Match");
-        Event* e2 = new Event("2024-04-20", "Gym", "Basketball Match");
-
-        club.organizeEvent(e1);
-
-        assert(club.hasScheduleConflict("2024-04-19"));
-        assert(!club.hasScheduleConflict("2024-04-20"));
-
-        std::cout << "testEventScheduleConflict passed" << std::endl;
-
-        delete e1;
-        delete e2;
-    }
-    catch (...) {
-        std::cout << "testEventScheduleConflict failed" << std::endl;
-    }
-}
-
-// Test removing a member and its effect on associated teams and events
-void testRemoveMember() {
-    std::cout << "Starting testRemoveMember" << std::endl;
-    Club myClub("Sports Club");
-
-    Member* m1 = new Member("John", 30, "Athlete", 1);
-    Member* m2 = new Member("Jane", 25, "Athlete", 2);
-    myClub.addMember(m1);
-    myClub.addMember(m2);
-
-    Coach* c1 = new Coach("Coach A", "Football", 1);
-    myClub.addCoach(c1);
-
-    Event* e1 = new Event("2024-04-19", "Stadium", "Football Match");
-    myClub.organizeEvent(e1);
-    myClub.addMembersToEvent("Football Match", { m1, m2 });
-
-    Team* t1 = new Team("Football", c1, 1);
-    t1->addMember(m1);
-    t1->addMember(m2);
-    myClub.addTeam(t1);
-
-    std::cout << "Finding person with ID 1 before deletion:" << std::endl;
-    myClub.findPersonById(1);
-
-    std::cout << "Removing member with ID 1:" << std::endl;
-    myClub.removeMember(m1);
-
-    std::cout << "Finding person with ID 1 after deletion:" << std::endl;
-    myClub.findPersonById(1);
-
-    // Check if the member is removed from the team
-    if (t1->getMembers().size() == 1 && t1->getMembers()[0]->getId() == 2) {
-        std::cout << "Member successfully removed from team." << std::endl;
-    }
-    else {
-        std::cerr << "Failed to remove member from team." << std::endl;
-    }
-
-    // Check if the member is removed from the event
-    if (e1->getParticipants().size() == 1 && e1->getParticipants()[0]->getId() == 2) {
-        std::cout << "Member successfully removed from event." << std::endl;
-    }
-    else {
-        std::cerr << "Failed to remove member from event." << std::endl;
-    }
-
-    std::cout << "testRemoveMember completed" << std::endl;
-}
-
-// Test removing a coach and its effect on associated teams
-void testRemoveCoach() {
-    std::cout << "Starting testRemoveCoach" << std::endl;
-    Club myClub("Sports Club");
-
-    Member* m1 = new Member("John", 30, "Athlete", 1);
-    Member* m2 = new Member("Jane", 25, "Athlete", 2);
-    myClub.addMember(m1);
-    myClub.addMember(m2);
-
-    Coach* c1 = new Coach("Coach A", "Football", 1);
-    myClub.addCoach(c1);
-
-    Event* e1 = new Event("2024-04-19", "Stadium", "Football Match");
-    myClub.organizeEvent(e1);
-    myClub.addMembersToEvent("Football Match", { m1, m2 });
-
-    Team* t1 = new Team("Football", c1, 1);
-    t1->addMember(m1);
-    t1->addMember(m2);
-    myClub.addTeam(t1);
-
-    std::cout << "Finding person with ID 1 (Coach) before deletion:" << std::endl;
-    myClub.findPersonById(1);
-
-    std::cout << "Removing coach with ID 1:" << std::endl;
-    myClub.removeCoach(c1);
-
-    std::cout << "Finding person with ID 1 (Coach) after deletion:" << std::endl;
-    myClub.findPersonById(1);
-
-    // Check if the team still exists but without a coach
-    if (t1->getCoach() == nullptr) {
-        std::cout << "Coach successfully removed from team, team still exists." << std::endl;
-    }
-    else {
-        std::cerr << "Failed to remove coach from team." << std::endl;
-    }
-
-    std::cout << "testRemoveCoach completed" << std::endl;
-}
-
-
-
-
-
-void printDivider(const std::string& title) {
-    std::cout << "\n-----------------------------------\n";
-    std::cout << title << '\n';
-    std::cout << "-----------------------------------\n";
-}
-
-void testClubFunctionality() {
-    printDivider("Creating Club: Elite Sports Club");
-    Club club("Elite Sports Club");
-
-    printDivider("Adding Members: Jack, Kelly and Bob");
-    Member* m1 = new Member("Jack", 24, "Athlete", 1);
-    Member* m2 = new Member("Kelly", 26, "Athlete", 2);
-    Member* m3 = new Member("Bob", 30, "Athlete", 3);
-    club.addMember(m1);
-    club.addMember(m2);
-    club.addMember(m3);
-
-    std::cout << "Current Members:\n";
-    for (const auto& member : club.getMembers()) {
-        std::cout << "Name: " << member->getName() << ", Age: " << member->getAge() << ", Role: " << member->getRole() << ", ID: " << member->getId() << '\n';
-    }
-
-    printDivider("Adding Coaches: Laura (Tennis) and Sam (Swimming)");
-    Coach* c1 = new Coach("Laura", "Tennis", 1);
-    Coach* c2 = new Coach("Sam", "Swimming", 2);
-    club.addCoach(c1);
-    club.addCoach(c2);
-
-    std::cout << "Current Coaches:\n";
-    for (const auto& coach : club.getCoaches()) {
-        std::cout << "Name: " << coach->getName() << ", Specialty: " << coach->getSpecialty() << ", ID: " << coach->getId() << '\n';
-    }
-
-    printDivider("Creating and Adding Teams: Tennis Team and Swimming Team");
-    Team* t1 = new Team("Tennis", c1, 1);
-    Team* t2 = new Team("Swimming", c2, 2);
-    t1->addMember(m1);
-    t1->addMember(m2);
-    t2->addMember(m3);
-    club.addTeam(t1);
-    club.addTeam(t2);
-
-    std::cout << "Current Teams:\n";
-    for (const auto& team : club.getTeams()) {
-        std::cout << "Sport Type: " << team->getSportType() << ", ID: " << team->getId() << '\n';
-        std::cout << "Team Members:\n";
-        for (const auto& member : team->getMembers()) {
-            std::cout << "  Name: " << member->getName() << ", ID: " << member->getId() << '\n';
-        }
-    }
-
-    printDivider("Organizing Events: Tennis Tournament and Swimming Competition");
-    Event* e1 = new Event("2024-08-20", "City Arena", "Tennis Tournament");
-    Event* e2 = new Event("2024-09-10", "Aquatic Center", "Swimming Competition");
-    club.organizeEvent(e1);
-    club.organizeEvent(e2);
-    club.addMembersToEvent("Tennis Tournament", { m1, m2 });
-    club.addMembersToEvent("Swimming Competition", { m3 });
-
-    std::cout << "Current Events:\n";
-    for (const auto& event : club.getEvents()) {
-        std::cout << "Event Name: " << event->getName() << ", Date: " << event->getDate() << ", Location: " << event->getLocation() << '\n';
-        std::cout << "Event Participants:\n";
-        for (const auto& participant : event->getParticipants()) {
-            std::cout << "  Name: " << participant->getName() << ", ID: " << participant->getId() << '\n';
-        }
-    }
-
-    printDivider("Updating Coach Specialty: Laura to Basketball");
-    club.updateCoachSpecialty("Laura", "Basketball");
-
-    std::cout << "Updated Coach:\n";
-    for (const auto& coach : club.getCoaches()) {
-        std::cout << "Name: " << coach->getName() << ", Specialty: " << coach->getSpecialty() << ", ID: " << coach->getId() << '\n';
-    }
-
-    printDivider("Checking Schedule Conflict for 2024-08-20 and 2024-09-10");
-    bool conflict1 = club.hasScheduleConflict("2024-08-20");
-    bool conflict2 = club.hasScheduleConflict("2024-09-10");
-    std::cout << "Schedule Conflict on 2024-08-20: " << (conflict1 ? "Yes" : "No") << '\n';
-    std::cout << "Schedule Conflict on 2024-09-10: " << (conflict2 ? "Yes" : "No") << '\n';
-
-    printDivider("Finding Members by Role: Athlete");
-    auto athletes = club.findMembersByRole("Athlete");
-    for (const auto& member : athletes) {
-        std::cout << "Name: " << member->getName() << ", ID: " << member->getId() << '\n';
-    }
-
-    printDivider("Finding Member by Name: Kelly");
-    Member* foundMember = club.findMemberByName("Kelly");
-    if (foundMember) {
-        std::cout << "Found Member: " << foundMember->getName() << ", ID: " << foundMember->getId() << '\n';
-    }
-    else {
-        std::cout << "Member not found\n";
-    }
-
-    printDivider("Removing Member: Jack");
-    club.removeMember(m1);
-    std::cout << "Current Members after removal:\n";
-    for (const auto& member : club.getMembers()) {
-        std::cout << "Name: " << member->getName() << ", ID: " << member->getId() << '\n';
-    }
-
-    printDivider("Removing Coach: Laura");
-    club.removeCoach(c1);
-    std::cout << "Current Coaches after removal:\n";
-    for (const auto& coach : club.getCoaches()) {
-        std::cout << "Name: " << coach->getName() << ", ID: " << coach->getId() << '\n';
-    }
-
-    printDivider("Removing Team: Tennis Team");
-    club.removeTeam(t1);
-    std::cout << "Current Teams after removal:\n";
-    for (const auto& team : club.getTeams()) {
-        std::cout << "Sport Type: " << team->getSportType() << ", ID: " << team->getId() << '\n';
-    }
-
-    printDivider("Canceling Event: Tennis Tournament");
-    club.cancelEvent(e1);
-    std::cout << "Current Events after cancellation:\n";
-    for (const auto& event : club.getEvents()) {
-        std::cout << "Event Name: " << event->getName() << ", Date: " << event->getDate() << ", Location: " << event->getLocation() << '\n';
-    }
-
-
-    delete m2;
-    delete m3;
-    delete c2;
-    delete t1;
-    delete t2;
-    delete e2;
-}
-
-
-
-
-
-int main() {
-    testMember();
-    testCoach();
-    testTeam();
-    testEvent();
-    testClub();
-    testDeleteClub();
-    testEventScheduleConflict();
-    testRemoveMember();
-    testRemoveCoach();
-
-
-
-   testClubFunctionality();
-
-    std::cout << "All tests passed!" << std::endl;
-    return 0;
-}
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include "Member.h"
+#include "Coach.h"
+#include "Team.h"
+#include "Event.h"
+#include "Club.h"
+#include "Scheduler.h"
+#include "Partition.h"
+#include "Tournament.h"
+#include "Workload.h"
+#include "Server.h"
+#include "Client.h"
+#include "Async.h"
+#include "MemberStore.h"
+#include "ClubArchive.h"
+#include "Compress.h"
+
+// Test functions for Member class
+void testMember() {
+    try {
+        Member* m1 = new Member("John", 30, "Athlete", 1);
+
+        // Verify Member creation and getters
+        assert(m1->getName() == "John");
+        assert(m1->getAge() == 30);
+        assert(m1->getRole() == "Athlete");
+        assert(m1->getId() == 1);
+
+        // Test updating member details
+        m1->updateDetails("John D.", 31);
+        assert(m1->getName() == "John D." && m1->getAge() == 31);
+
+        // Test invalid name update
+        try {
+            m1->updateDetails("", 31);
+            std::cerr << "testMember failed: no exception on empty name" << std::endl;
+        }
+        catch (const std::invalid_argument& e) {
+            std::cout << "Caught expected exception for empty name: " << e.what() << std::endl;
+        }
+
+        // Test invalid age update
+        try {
+            m1->updateDetails("John D.", -5);
+            std::cerr << "testMember failed: no exception on negative age" << std::endl;
+        }
+        catch (const std::invalid_argument& e) {
+            std::cout << "Caught expected exception for negative age: " << e.what() << std::endl;
+        }
+
+        // Test invalid ID
+        try {
+            Member* m2 = new Member("Jane", 25, "Athlete", -1);
+            std::cerr << "testMember failed: no exception on negative ID" << std::endl;
+            delete m2;
+        }
+        catch (const std::invalid_argument& e) {
+            std::cout << "Caught expected exception for negative ID: " << e.what() << std::endl;
+        }
+
+        std::cout << "testMember passed" << std::endl;
+        delete m1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testMember failed: " << e.what() << std::endl;
+    }
+    catch (...) {
+        std::cerr << "testMember failed: unknown exception" << std::endl;
+    }
+}
+
+// Test functions for Coach class
+void testCoach() {
+    try {
+        // Correct Creation Test
+        Coach* c1 = new Coach("Jane", "Football", 1);
+        assert(c1->getName() == "Jane");
+        assert(c1->getSpecialty() == "Football");
+        assert(c1->getId() == 1);
+
+        // Specialty Assignment Test (Correct)
+        c1->setSpecialty("Basketball");
+        assert(c1->getSpecialty() == "Basketball");
+
+        // Specialty Assignment Test (Incorrect)
+        try {
+            Coach* c2 = new Coach("John", "", 2);
+            std::cerr << "testCoach failed: no exception on empty specialty" << std::endl;
+            delete c2;
+        }
+        catch (const std::invalid_argument& e) {
+            std::cout << "Caught expected exception for empty specialty: " << e.what() << std::endl;
+        }
+
+        // Test negative ID
+        try {
+            Coach* c3 = new Coach("John", "Football", -1);
+            std::cerr << "testCoach failed: no exception on negative ID" << std::endl;
+            delete c3;
+        }
+        catch (const std::invalid_argument& e) {
+            std::cout << "Caught expected exception for negative ID: " << e.what() << std::endl;
+        }
+
+        std::cout << "testCoach passed" << std::endl;
+        delete c1;
+    }
+    catch (...) {
+        std::cout << "testCoach failed" << std::endl;
+    }
+}
+
+// Test functions for Team class
+void testTeam() {
+    // Adding Member Test (Correct)
+    try {
+        Coach* coach = new Coach("Jane", "Football", 1);
+        Team team("Football", coach, 1);
+
+        Member* member1 = new Member("John", 30, "Athlete", 1);
+        team.addMember(member1);
+
+        assert(team.getMembers().size() == 1);
+        assert(team.getId() == 1);
+        std::cout << "testAddingMember passed" << std::endl;
+
+        delete member1;
+        delete coach;
+    }
+    catch (...) {
+        std::cout << "testAddingMember failed" << std::endl;
+    }
+
+    // Removing Member Test (Correct)
+    try {
+        Coach* coach = new Coach("Jane", "Football", 1);
+        Team team("Football", coach, 1);
+
+        Member* member1 = new Member("John", 30, "Athlete", 1);
+        team.addMember(member1);
+        assert(team.getMembers().size() == 1);
+
+        team.removeMember(member1);
+        assert(team.getMembers().size() == 0);
+        std::cout << "testRemovingMember passed" << std::endl;
+
+        delete member1;
+        delete coach;
+    }
+    catch (...) {
+        std::cout << "testRemovingMember failed" << std::endl;
+    }
+
+    // Removing Non-Existent Member Test (Incorrect)
+    try {
+        Coach* coach = new Coach("Jane", "Football", 1);
+        Team team("Football", coach, 1);
+
+        Member* member1 = new Member("John", 30, "Athlete", 1);
+        Member* member2 = new Member("Jane", 25, "Athlete", 2);
+
+        team.addMember(member1);
+        assert(team.getMembers().size() == 1);
+
+        team.removeMember(member2); // member2 was never added
+        assert(team.getMembers().size() == 1); // Size should remain unchanged
+        std::cout << "testRemovingNonExistentMember passed" << std::endl;
+
+        delete member1;
+        delete member2;
+        delete coach;
+    }
+    catch (...) {
+        std::cout << "testRemovingNonExistentMember failed" << std::endl;
+    }
+
+    // Test negative ID
+    try {
+        Coach* coach = new Coach("Jane", "Football", 1);
+        Team* team = new Team("Football", coach, -1);
+        std::cerr << "testTeam failed: no exception on negative ID" << std::endl;
+        delete team;
+        delete coach;
+    }
+    catch (const std::invalid_argument& e) {
+        std::cout << "Caught expected exception for negative ID: " << e.what() << std::endl;
+    }
+}
+
+// Test functions for Event class
+void testEvent() {
+    bool allTestsPassed = true;
+
+    // Event Creation Test (Correct)
+    try {
+        Event event("2024-05-01", "Stadium", "Football Match");
+        assert(event.getDate() == "2024-05-01");
+        assert(event.getLocation() == "Stadium");
+        assert(event.getName() == "Football Match");
+    }
+    catch (...) {
+        std::cout << "Event Creation Test failed" << std::endl;
+        allTestsPassed = false;
+    }
+
+    // Reschedule Test (Correct)
+    try {
+        Event event("2024-05-01", "Stadium", "Football Match");
+        event.reschedule("2024-06-01");
+        assert(event.getDate() == "2024-06-01");
+    }
+    catch (...) {
+        std::cout << "Reschedule Test failed" << std::endl;
+        allTestsPassed = false;
+    }
+
+    // Add Participant Test (Correct)
+    try {
+        Event event("2024-05-01", "Stadium", "Football Match");
+        Member* member1 = new Member("John", 30, "Athlete", 1);
+        event.addParticipant(member1);
+        assert(event.getParticipantCount() == 1);
+        delete member1;
+    }
+    catch (...) {
+        std::cout << "Add Participant Test failed" << std::endl;
+        allTestsPassed = false;
+    }
+
+    // Add Invalid Participant Test (Incorrect)
+    try {
+        Event event("2024-05-01", "Stadium", "Football Match");
+        try {
+            event.addParticipant(nullptr); // This should fail or be handled appropriately
+            std::cerr << "Add Invalid Participant Test failed: no exception on invalid participant" << std::endl;
+            allTestsPassed = false;
+        }
+        catch (const std::invalid_argument& e) {
+            // Expected exception, do nothing
+        }
+        assert(event.getParticipantCount() == 0);
+    }
+    catch (...) {
+        std::cout << "Add Invalid Participant Test failed" << std::endl;
+        allTestsPassed = false;
+    }
+
+    if (allTestsPassed) {
+        std::cout << "testEvent passed" << std::endl;
+    }
+    else {
+        std::cout << "testEvent failed" << std::endl;
+    }
+}
+
+void testClub() {
+    try {
+      
+        std::cout << "Starting testClub" << std::endl;
+        // Create a Club object named "Sports Club"
+        Club club("Sports Club");
+
+        // Create members
+        std::cout << "Creating members" << std::endl;
+        // Create two Member objects m1 and m2
+        Member* m1 = new Member("John", 30, "Athlete", 1);
+        Member* m2 = new Member("Jane", 25, "Athlete", 2);
+
+        // Add members to the club
+        std::cout << "Adding members" << std::endl;
+        club.addMember(m1);
+        club.addMember(m2);
+        std::cout << "Added members" << std::endl;
+
+        // Update details of member m1
+        std::cout << "Updating member details" << std::endl;
+        m1->updateDetails("John D.", 31);
+        std::cout << "Updated member details" << std::endl;
+
+        // Remove member m1 from the club
+        std::cout << "Removing member" << std::endl;
+        club.removeMember(m1);
+        std::cout << "Removed member" << std::endl;
+        // Delete member object m1 and set pointer to nullptr
+        delete m1;
+        m1 = nullptr;
+
+        // Create and add coach c1 to the club
+        std::cout << "Creating and adding coach" << std::endl;
+        Coach* c1 = new Coach("Jane", "Football", 1);
+        club.addCoach(c1);
+        std::cout << "Added coach" << std::endl;
+
+        // Remove coach c1 from the club
+        std::cout << "Removing coach" << std::endl;
+        club.removeCoach(c1);
+        std::cout << "Removed coach" << std::endl;
+        // Delete coach object c1 and set pointer to nullptr
+        delete c1;
+        c1 = nullptr;
+
+        // Organize an event e1
+        std::cout << "Organizing event" << std::endl;
+        Event* e1 = new Event("2024-04-19", "Stadium", "Football Match");
+        club.organizeEvent(e1);
+        std::cout << "Organized event" << std::endl;
+
+        // Cancel event e1
+        std::cout << "Cancelling event" << std::endl;
+        club.cancelEvent(e1);
+        std::cout << "Cancelled event" << std::endl;
+        // Delete event object e1 and set pointer to nullptr
+        delete e1;
+        e1 = nullptr;
+
+        // Add member to event
+        std::cout << "Adding member to event" << std::endl;
+        e1 = new Event("2024-04-19", "Stadium", "Football Match");
+        club.organizeEvent(e1);
+        club.addMember(m2);
+        std::vector<Member*> members = { m2 };
+        club.addMembersToEvent("Football Match", members);
+        std::cout << "Added members to event" << std::endl;
+        // Verify the number of participants in the event is 1
+        assert(club.getEvents().front()->getParticipants().size() == 1);
+
+        // Create and add coach c2 to the club
+        Coach* c2 = new Coach("Jane", "Football", 1);
+        club.addCoach(c2);
+        // Check if coach c2 exists
+        Coach* foundCoach = club.findCoachByName("Jane");
+        assert(foundCoach != nullptr);
+        // Update the specialty of coach c2
+        club.updateCoachSpecialty("Jane", "Basketball");
+
+        // Test duplicate member ID exception
+        try {
+            Member* m3 = new Member("Jane", 25, "Athlete", 2);
+            club.addMember(m3);
+            std::cerr << "testDuplicateMember failed: no exception on duplicate member ID" << std::endl;
+            delete m3;
+        }
+        catch (const std::invalid_argument& e) {
+            std::cout << "Caught expected exception for duplicate member ID: " << e.what() << std::endl;
+        }
+
+        // Test duplicate coach ID exception
+        try {
+            Coach* c3 = new Coach("Jane", "Football", 1);
+            club.addCoach(c3);
+            std::cerr << "testDuplicateCoach failed: no exception on duplicate coach ID" << std::endl;
+            delete c3;
+        }
+        catch (const std::invalid_argument& e) {
+            std::cout << "Caught expected exception for duplicate coach ID: " << e.what() << std::endl;
+        }
+
+        // Create and add team t1 to the club
+        Team* t1 = new Team("Football", foundCoach, 1);
+        club.addTeam(t1);
+        // Verify the number of teams in the club is 1
+        assert(club.getTeams().size() == 1);
+
+        std::cout << "testClub passed" << std::endl;
+
+        // Delete remaining objects
+        delete m2;
+        delete c2;
+        delete t1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testClub failed: " << e.what() << std::endl;
+    }
+    catch (...) {
+        std::cerr << "testClub failed: unknown exception" << std::endl;
+    }
+}
+
+
+// Test deleting a club and all associated objects
+void testDeleteClub() {
+    try {
+        std::cout << "Starting testDeleteClub" << std::endl;
+        Club* myClub = new Club("Sports Club");
+
+        std::cout << "Adding members and coaches" << std::endl;
+        Member* m1 = new Member("John", 30, "Athlete", 1);
+        Member* m2 = new Member("Jane", 25, "Athlete", 2);
+        myClub->addMember(m1);
+        myClub->addMember(m2);
+
+        Coach* c1 = new Coach("Coach A", "Football", 1);
+        myClub->addCoach(c1);
+
+        std::cout << "Organizing event" << std::endl;
+        Event* e1 = new Event("2024-04-19", "Stadium", "Football Match");
+        myClub->organizeEvent(e1);
+
+        std::cout << "Adding team" << std::endl;
+        Team* t1 = new Team("Football", c1, 1);
+        t1->addMember(m1);
+        t1->addMember(m2);
+        myClub->addTeam(t1);
+
+        // Deleting club and all associated objects
+        std::cout << "Deleting club" << std::endl;
+        delete myClub;
+        std::cout << "testDeleteClub passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testDeleteClub failed: " << e.what() << std::endl;
+    }
+    catch (...) {
+        std::cerr << "testDeleteClub failed: unknown exception" << std::endl;
+    }
+}
+
+// Test scheduling conflict for events
+void testEventScheduleConflict() {
+    try {
+        Club club("Sports Club");
+
+        Event* e1 = new Event("2024-04-19", "Stadium", "Football Match");
+        Event* e2 = new Event("2024-04-20", "Gym", "Basketball Match");
+
+        club.organizeEvent(e1);
+
+        assert(club.hasScheduleConflict("2024-04-19"));
+        assert(!club.hasScheduleConflict("2024-04-20"));
+
+        std::cout << "testEventScheduleConflict passed" << std::endl;
+
+        delete e1;
+        delete e2;
+    }
+    catch (...) {
+        std::cout << "testEventScheduleConflict failed" << std::endl;
+    }
+}
+
+// Test the compact date type and its use in Event
+void testDate() {
+    try {
+        Date d = Date::parse("2024-02-29");
+        assert(d.toString() == "2024-02-29");
+        assert(d.addDays(1).toString() == "2024-03-01");
+        assert(Date::parse("1970-01-01").getDayNumber() == 0);
+        assert(Date::parse("2024-05-01") < Date::parse("2024-05-02"));
+
+        DateTime dt = DateTime::parse("2024-05-01T09:30");
+        assert(dt.hasTime() && dt.getMinute() == 9 * 60 + 30);
+        assert(dt.toString() == "2024-05-01T09:30");
+        assert(!DateTime::parse("2024-05-01").hasTime());
+
+        // Non-ISO and impossible dates are rejected
+        Date ignored;
+        assert(!Date::tryParse("2024-5-1", ignored));
+        assert(!Date::tryParse("2023-02-29", ignored));
+        assert(!Date::tryParse("2024-13-01", ignored));
+        try {
+            Event event("2024-5-1", "Stadium", "Football Match");
+            std::cerr << "testDate failed: no exception on non-ISO date" << std::endl;
+        }
+        catch (const std::invalid_argument& e) {
+            std::cout << "Caught expected exception for non-ISO date: " << e.what() << std::endl;
+        }
+        try {
+            Event event("2024-05-01", "Stadium", "Football Match");
+            event.reschedule("next tuesday");
+            std::cerr << "testDate failed: no exception on free-form reschedule" << std::endl;
+        }
+        catch (const std::invalid_argument& e) {
+            std::cout << "Caught expected exception for free-form reschedule: " << e.what() << std::endl;
+        }
+
+        Club club("Sports Club");
+        Event* e1 = club.emplaceEvent("2024-05-03", "Stadium", "Third");
+        Event* e2 = club.emplaceEvent("2024-05-01", "Stadium", "First");
+        Event* e3 = club.emplaceEvent("2024-06-01", "Stadium", "Later");
+        auto sorted = club.getEventsSortedByDate();
+        assert(sorted.size() == 3 && sorted[0] == e2 && sorted[1] == e1 && sorted[2] == e3);
+        auto may = club.getEventsBetween("2024-05-01", "2024-05-31");
+        assert(may.size() == 2 && may[0] == e2 && may[1] == e1);
+        assert(club.getEventsBetween("2024-05-03", "2024-05-03").size() == 1);
+        assert(club.getEventsBetween("2024-05-04", "2024-05-31").empty());
+        assert(club.getEventsBetween("2024-06-01", "2024-05-01").empty());
+
+        std::cout << "testDate passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testDate failed: " << e.what() << std::endl;
+    }
+}
+
+// Test venue and time-of-day aware conflict detection
+void testVenueCalendar() {
+    try {
+        Club club("Sports Club");
+
+        Event* e1 = new Event("2024-04-19", "Stadium", "Morning Training", "09:00", "11:00");
+        Event* e2 = new Event("2024-04-19", "Gym", "Basketball Match", "10:00", "12:00");
+        club.organizeEvent(e1);
+        club.organizeEvent(e2);
+
+        // Same venue, overlapping and touching ranges
+        assert(club.hasScheduleConflict("Stadium", "2024-04-19", "10:30", "12:00"));
+        assert(!club.hasScheduleConflict("Stadium", "2024-04-19", "11:00", "12:00"));
+        // Other venue or other day
+        assert(!club.hasScheduleConflict("Pool", "2024-04-19", "09:00", "11:00"));
+        assert(!club.hasScheduleConflict("Stadium", "2024-04-20", "09:00", "11:00"));
+
+        // Free slots at the stadium that day: 00:00-09:00 and 11:00-24:00
+        auto slots = club.findFreeSlots("Stadium", "2024-04-19", 1);
+        assert(slots.size() == 2);
+        assert(slots[0].end - slots[0].start == 9 * 60);
+        assert(DateTime::formatTime(static_cast<int>(slots[1].start % (24 * 60))) == "11:00");
+
+        // Rescheduling moves the booking
+        club.rescheduleEvent(e1, "2024-04-20", "09:00", "11:00");
+        assert(!club.hasScheduleConflict("Stadium", "2024-04-19", "09:00", "11:00"));
+        assert(club.hasScheduleConflict("Stadium", "2024-04-20", "10:00", "10:30"));
+        assert(e1->getDate() == "2024-04-20" && e1->getStartTime() == "09:00");
+
+        club.cancelEvent(e2);
+        assert(!club.hasScheduleConflict("Gym", "2024-04-19", "10:00", "12:00"));
+
+        // Rescheduling the event directly goes through the club as well
+        e1->reschedule("2024-04-22");
+        assert(!club.hasScheduleConflict("Stadium", "2024-04-20", "10:00", "10:30"));
+        assert(club.hasScheduleConflict("Stadium", "2024-04-22", "10:00", "10:30"));
+        assert(club.hasScheduleConflict("2024-04-22") && !club.hasScheduleConflict("2024-04-20"));
+
+        // A cancelled club-built event leaves nothing behind once it is freed
+        Event* friendly = club.emplaceEvent("2024-04-23", "Stadium", "Friendly", "09:00", "10:00");
+        friendly->reschedule(Date::parse("2024-04-24"), 9 * 60, 10 * 60);
+        club.cancelEvent(friendly);
+        club.compact();
+        assert(!club.hasScheduleConflict("Stadium", "2024-04-24", "09:00", "10:00"));
+        assert(!club.hasScheduleConflict("Stadium", "2024-04-23", "09:00", "10:00"));
+
+        // Days before 1970 are filed under the right day
+        club.emplaceEvent("1969-12-31", "Stadium", "Old Final", "20:00", "22:00");
+        assert(club.hasScheduleConflict("1969-12-31") && !club.hasScheduleConflict("1969-12-30"));
+        assert(club.hasScheduleConflict("Stadium", "1969-12-31", "21:00", "21:30"));
+
+        // Malformed times are rejected
+        try {
+            Event bad("2024-04-19", "Stadium", "Bad", "12:00", "11:00");
+            std::cerr << "testVenueCalendar failed: no exception on inverted time range" << std::endl;
+        }
+        catch (const std::invalid_argument& e) {
+            std::cout << "Caught expected exception for inverted time range: " << e.what() << std::endl;
+        }
+
+        std::cout << "testVenueCalendar passed" << std::endl;
+
+        delete e1;
+        delete e2;
+    }
+    catch (...) {
+        std::cout << "testVenueCalendar failed" << std::endl;
+    }
+}
+
+// Test the season scheduler keeps venues, teams and shared members conflict-free
+void testSeasonScheduler() {
+    try {
+        Club club("Sports Club");
+
+        Coach* c1 = new Coach("Coach A", "Football", 1);
+        Coach* c2 = new Coach("Coach B", "Football", 2);
+        club.addCoach(c1);
+        club.addCoach(c2);
+
+        Member* m1 = new Member("John", 20, "Athlete", 1);
+        Member* m2 = new Member("Jane", 21, "Athlete", 2);
+        Member* m3 = new Member("Jack", 22, "Athlete", 3);
+        club.addMember(m1);
+        club.addMember(m2);
+        club.addMember(m3);
+
+        // Jane plays for both t1 and t3; Coach A runs t1 and t2
+        Team* t1 = new Team("Football", c1, 1);
+        Team* t2 = new Team("Football", c1, 2);
+        Team* t3 = new Team("Football", c2, 3);
+        t1->addMember(m1);
+        t1->addMember(m2);
+        t2->addMember(m3);
+        t3->addMember(m2);
+        club.addTeam(t1);
+        club.addTeam(t2);
+        club.addTeam(t3);
+
+        // The stadium is already booked on the first morning
+        Event* booked = new Event("2024-05-01", "Stadium", "Open Day", "10:00", "12:00");
+        club.organizeEvent(booked);
+        CoParticipationGraph& graph = club.enableCoParticipationGraph();
+
+        SeasonScheduler scheduler(club, { "Stadium", "Field" },
+            { { "2024-05-01", "2024-05-04", { { "10:00", "12:00" }, { "14:00", "16:00" } } } }, 1);
+        scheduler.addFixture("t1 training", { t1 });
+        scheduler.addFixture("t2 training", { t2 });
+        scheduler.addFixture("t3 training", { t3 });
+        scheduler.addFixture("t1 second", { t1 });
+        std::vector<Event*> placed = scheduler.schedule();
+
+        assert(placed.size() == 4);
+        assert(scheduler.getUnplaced().empty());
+        // Teams join the placed events through the club, so its graph and counts see them
+        const auto partners = graph.topPartners(1, 1);
+        assert(partners.size() == 1 && partners[0].first == 2 && partners[0].second == 2);
+        assert(club.getParticipantCount("t1 training") == 2);
+        // No two placed events share a person or a venue at the same time
+        for (size_t i = 0; i < placed.size(); ++i) {
+            for (size_t j = i + 1; j < placed.size(); ++j) {
+                const bool overlap = placed[i]->getStartStamp() < placed[j]->getEndStamp() &&
+                    placed[j]->getStartStamp() < placed[i]->getEndStamp();
+                if (!overlap) {
+                    continue;
+                }
+                assert(placed[i]->getLocation() != placed[j]->getLocation());
+                assert(placed[i]->getTeams()[0]->getCoach() != placed[j]->getTeams()[0]->getCoach());
+                for (auto member : placed[i]->getParticipants()) {
+                    auto others = placed[j]->getParticipants();
+                    assert(std::find(others.begin(), others.end(), member) == others.end());
+                }
+            }
+            assert(!(placed[i]->getLocation() == "Stadium" && placed[i]->getDate() == "2024-05-01" &&
+                placed[i]->getStartTime() == "10:00"));
+        }
+        // One rest day between the two t1 fixtures
+        assert(placed[3]->getStartStamp() / (24 * 60) - placed[0]->getStartStamp() / (24 * 60) >= 2);
+
+        std::cout << "testSeasonScheduler passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testSeasonScheduler failed: " << e.what() << std::endl;
+    }
+}
+
+// Test the coach to teams index, cascade on coach removal and workload query
+void testCoachWorkload() {
+    try {
+        Club club("Sports Club");
+
+        Coach* c1 = new Coach("Coach A", "Football", 1);
+        Coach* c2 = new Coach("Coach B", "Football", 2);
+        club.addCoach(c1);
+        club.addCoach(c2);
+
+        Member* m1 = new Member("John", 20, "Athlete", 1);
+        Member* m2 = new Member("Jane", 21, "Athlete", 2);
+        club.addMember(m1);
+        club.addMember(m2);
+
+        Team* t1 = new Team("Football", c1, 1);
+        Team* t2 = new Team("Football", c1, 2);
+        t1->addMember(m1);
+        t1->addMember(m2);
+        t2->addMember(m2);
+        club.addTeam(t1);
+        club.addTeam(t2);
+        assert(c1->getTeamCount() == 2 && c2->getTeamCount() == 0);
+
+        Event* past = new Event("2024-01-10", "Stadium", "Old Match");
+        Event* next = new Event("2024-06-10", "Stadium", "Next Match");
+        club.organizeEvent(past);
+        club.organizeEvent(next);
+        club.addTeamToEvent("Old Match", t1);
+        club.addTeamToEvent("Next Match", t1);
+        club.addTeamToEvent("Next Match", t2);
+
+        CoachWorkload workload = club.getCoachWorkload(c1, "2024-03-01");
+        assert(workload.teams.size() == 2);
+        assert(workload.total_athletes == 2);
+        assert(workload.upcoming_events.size() == 1 && workload.upcoming_events[0] == next);
+
+        // A cancelled event leaves its teams and the workload at once
+        Event* extra = club.emplaceEvent("2024-07-01", "Stadium", "Extra Match");
+        club.addTeamToEvent(extra, t2);
+        assert(club.getCoachWorkload(c1, "2024-03-01").upcoming_events.size() == 2);
+        club.cancelEvent(extra);
+        assert(t2->getEvents().size() == 1 && extra->getTeams().empty());
+        assert(club.getCoachWorkload(c1, "2024-03-01").upcoming_events.size() == 1);
+
+        // Moving a team updates both coaches
+        t2->setCoach(c2);
+        assert(c1->getTeamCount() == 1 && c2->getTeamCount() == 1);
+
+        // Removing a coach hands its teams to the replacement
+        club.removeCoach(c1, c2);
+        assert(t1->getCoach() == c2 && c2->getTeamCount() == 2 && c1->getTeamCount() == 0);
+
+        // Removing the last coach detaches the teams
+        club.removeCoach(c2);
+        assert(t1->getCoach() == nullptr && t2->getCoach() == nullptr);
+
+        std::cout << "testCoachWorkload passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testCoachWorkload failed: " << e.what() << std::endl;
+    }
+}
+
+// Test in-place team merges and splits
+void testTeamMergeSplit() {
+    try {
+        Club club("Sports Club");
+        Coach* c1 = new Coach("Coach A", "Football", 1);
+        club.addCoach(c1);
+
+        Member* m1 = new Member("John", 17, "Athlete", 1);
+        Member* m2 = new Member("Jane", 19, "Athlete", 2);
+        Member* m3 = new Member("Jack", 16, "Athlete", 3);
+        club.addMember(m1);
+        club.addMember(m2);
+        club.addMember(m3);
+
+        Team* t1 = new Team("Football", c1, 1);
+        Team* t2 = new Team("Football", c1, 2);
+        t1->addMember(m1);
+        t1->addMember(m2);
+        t2->addMember(m2);
+        t2->addMember(m3);
+        club.addTeam(t1);
+        club.addTeam(t2);
+
+        // operator+ no longer duplicates shared members
+        {
+            Team combined = *t1 + *t2;
+            assert(combined.getMemberCount() == 3);
+        }
+
+        Event* e1 = new Event("2024-05-01", "Stadium", "Cup Match");
+        club.organizeEvent(e1);
+        club.addTeamToEvent("Cup Match", t2);
+
+        club.mergeTeams(t1, t2);
+        assert(club.getTeams().size() == 1);
+        assert(t1->getMemberCount() == 3);
+        assert(e1->getTeams().size() == 1 && e1->getTeams()[0] == t1);
+        assert(t1->getEvents().size() == 1);
+        assert(c1->getTeamCount() == 1);
+
+        // Split the under-18s off into their own team
+        Team* juniors = club.splitTeam(t1, [](const Member* member) { return member->getAge() < 18; }, 3);
+        assert(juniors->getMemberCount() == 2 && t1->getMemberCount() == 1);
+        assert(t1->getMembers()[0] == m2);
+        assert(juniors->getCoach() == c1 && c1->getTeamCount() == 2);
+        assert(club.getTeams().size() == 2);
+
+        std::cout << "testTeamMergeSplit passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testTeamMergeSplit failed: " << e.what() << std::endl;
+    }
+}
+
+// Test building entities directly in club-owned storage
+void testEmplace() {
+    try {
+        Club club("Sports Club");
+
+        std::string name = "John";
+        Member* m1 = club.emplaceMember(std::move(name), 30, "Athlete", 1);
+        Member* m2 = club.emplaceMember(std::string_view("Jane"), 25, std::string("Athlete"), 2);
+        assert(m1->getName() == "John" && m2->getName() == "Jane");
+        assert(club.findMemberById(2) == m2);
+
+        // Same validation as addMember: duplicates and bad values are rejected
+        try {
+            club.emplaceMember("Jane", 25, "Athlete", 3);
+            std::cerr << "testEmplace failed: no exception on duplicate member" << std::endl;
+        }
+        catch (const std::invalid_argument& e) {
+            std::cout << "Caught expected exception for duplicate member: " << e.what() << std::endl;
+        }
+        try {
+            club.emplaceMember("", 25, "Athlete", 4);
+            std::cerr << "testEmplace failed: no exception on empty name" << std::endl;
+        }
+        catch (const std::invalid_argument& e) {
+            std::cout << "Caught expected exception for empty name: " << e.what() << std::endl;
+        }
+        assert(club.getMembers().size() == 2);
+
+        Coach* c1 = club.emplaceCoach("Laura", "Tennis", 1);
+        Team* t1 = club.emplaceTeam("Tennis", c1, 1);
+        t1->addMember(m1);
+        Event* e1 = club.emplaceEvent("2024-05-01", "Court", "Tennis Cup", "10:00", "12:00");
+        club.addTeamToEvent("Tennis Cup", t1);
+        assert(e1->getParticipantCount() == 1);
+        assert(club.hasScheduleConflict("Court", "2024-05-01", "11:00", "11:30"));
+
+        // Removing a club-built team frees it from the pool
+        club.removeTeam(t1);
+        assert(club.getTeams().empty() && e1->getTeams().empty() && c1->getTeamCount() == 0);
+
+        std::cout << "testEmplace passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testEmplace failed: " << e.what() << std::endl;
+    }
+}
+
+// Test roster bitmaps and set algebra across teams and events
+void testRosterBitmap() {
+    try {
+        // Dense and sparse containers give the same answers
+        RosterBitmap evens;
+        RosterBitmap thirds;
+        for (int id = 0; id < 200000; id += 2) {
+            evens.add(id);
+        }
+        for (int id = 0; id < 200000; id += 3) {
+            thirds.add(id);
+        }
+        assert(evens.cardinality() == 100000);
+        assert((evens & thirds).cardinality() == 33334);
+        assert(evens.intersectionCardinality(thirds) == 33334);
+        assert((evens | thirds).cardinality() == 133333);
+        assert((evens - thirds).cardinality() == 66666);
+        assert((evens & thirds).contains(6) && !(evens & thirds).contains(4));
+        RosterBitmap sparse;
+        sparse.add(6);
+        sparse.add(70000);
+        sparse.add(7);
+        assert((sparse & evens).toIds() == std::vector<int>({ 6, 70000 }));
+        sparse.remove(6);
+        assert(sparse.cardinality() == 2 && !sparse.contains(6));
+
+        Club club("Sports Club");
+        Coach* c1 = club.emplaceCoach("Coach A", "Football", 1);
+        Member* m1 = club.emplaceMember("John", 17, "Athlete", 1);
+        Member* m2 = club.emplaceMember("Jane", 16, "Athlete", 2);
+        Member* m3 = club.emplaceMember("Jack", 19, "Athlete", 3);
+        Team* u18 = club.emplaceTeam("Football", c1, 1);
+        u18->addMember(m1);
+        u18->addMember(m2);
+        Event* final_match = club.emplaceEvent("2024-05-20", "Stadium", "Regional Final");
+        Event* training = club.emplaceEvent("2024-06-02", "Stadium", "Training");
+        club.addMembersToEvent("Regional Final", { m2, m3 });
+        club.addMembersToEvent("Training", { m1 });
+
+        // Members in both the U18 team and the regional final
+        assert(club.membersIn(club.rosterOf(u18) & club.rosterOf(final_match)) == std::vector<Member*>({ m2 }));
+        // Team members who skipped the final
+        assert(club.membersIn(club.rosterOf(u18) - club.rosterOf(final_match)) == std::vector<Member*>({ m1 }));
+        // Members in any event in May
+        assert(club.rosterOfEventsBetween("2024-05-01", "2024-05-31").cardinality() == 2);
+        assert((club.rosterOfClub() - club.rosterOf(training)).cardinality() == 2);
+
+        std::cout << "testRosterBitmap passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testRosterBitmap failed: " << e.what() << std::endl;
+    }
+}
+
+// Test the co-participation graph and its incremental updates
+void testCoParticipationGraph() {
+    try {
+        Club club("Sports Club");
+        Member* m1 = club.emplaceMember("John", 20, "Athlete", 1);
+        Member* m2 = club.emplaceMember("Jane", 21, "Athlete", 2);
+        Member* m3 = club.emplaceMember("Jack", 22, "Athlete", 3);
+        Member* m4 = club.emplaceMember("Kelly", 23, "Athlete", 4);
+        club.emplaceMember("Bob", 24, "Athlete", 5);
+        club.emplaceEvent("2024-05-01", "Stadium", "Match A");
+        club.emplaceEvent("2024-05-02", "Stadium", "Match B");
+        Event* c = club.emplaceEvent("2024-05-03", "Pool", "Swim C");
+        club.addMembersToEvent("Match A", { m1, m2 });
+        club.addMembersToEvent("Match B", { m1, m2, m3 });
+        club.addMembersToEvent("Swim C", { m4 });
+
+        CoParticipationGraph& graph = club.enableCoParticipationGraph(2);
+        assert(graph.degree(1) == 2 && graph.degree(4) == 0);
+        auto partners = graph.topPartners(1, 1);
+        assert(partners.size() == 1 && partners[0].first == 2 && partners[0].second == 2);
+        assert(graph.connectedComponents().size() == 2);  // {1,2,3} and {4}
+
+        // Incremental: Kelly joins Match B, linking the swimmer to the others
+        club.addMembersToEvent("Match B", { m4 });
+        assert(graph.pendingChanges() > 0);
+        assert(graph.degree(4) == 3);
+        assert(graph.connectedComponents().size() == 1);
+
+        // Removing Jane drops her edges; cancelling the swim changes nothing for the rest
+        club.removeMember(m2);
+        assert(graph.degree(2) == 0 && graph.degree(1) == 2);
+        club.cancelEvent(c);
+        graph.compact();
+        assert(graph.pendingChanges() == 0);
+        assert(graph.degree(1) == 2 && graph.edgeCount() == 3);
+
+        std::cout << "testCoParticipationGraph passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testCoParticipationGraph failed: " << e.what() << std::endl;
+    }
+}
+
+void testRosterPartitioner() {
+    try {
+        Club club("Sports Club");
+        club.emplaceCoach("Coach A", "Football", 1);
+        club.emplaceCoach("Coach B", "Football", 2);
+        club.emplaceCoach("Coach C", "Tennis", 3);
+        std::vector<Member*> players;
+        for (int i = 0; i < 30; ++i) {
+            const char* role = i % 10 == 0 ? "Goalkeeper" : "Athlete";
+            players.push_back(club.emplaceMember("Player " + std::to_string(i), 15 + i % 12, role, 100 + i));
+        }
+
+        PartitionConstraints constraints;
+        constraints.team_count = 3;
+        constraints.sport_type = "Football";
+        constraints.first_team_id = 10;
+        constraints.role_quotas["Goalkeeper"] = 1;
+        constraints.keep_together.push_back({ players[1], players[2] });
+        constraints.keep_apart.push_back({ players[3], players[4] });
+        std::vector<Team*> teams = RosterPartitioner(club, constraints).partition(players);
+
+        assert(teams.size() == 3 && club.getTeams().size() == 3);
+        for (auto team : teams) {
+            std::vector<Member*> roster = team->getMembers();
+            assert(roster.size() == 10);
+            assert(team->getCoach()->getSpecialty() == "Football");
+            auto goalkeepers = std::count_if(roster.begin(), roster.end(), [](const Member* m) {
+                return m->getRole() == "Goalkeeper";
+                });
+            assert(goalkeepers == 1);
+            auto has = [&roster](const Member* m) {
+                return std::find(roster.begin(), roster.end(), m) != roster.end();
+            };
+            assert(has(players[1]) == has(players[2]));
+            assert(!(has(players[3]) && has(players[4])));
+        }
+
+        // No coach for the sport
+        try {
+            constraints.sport_type = "Basketball";
+            RosterPartitioner(club, constraints).partition(players);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {}
+
+        std::cout << "testRosterPartitioner passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testRosterPartitioner failed: " << e.what() << std::endl;
+    }
+}
+
+void testTournament() {
+    try {
+        Club club("Sports Club");
+        Event* cup = club.emplaceEvent("2024-05-31", "Stadium", "Cup");
+        std::vector<Team*> teams;
+        for (int i = 1; i <= 5; ++i) {
+            Coach* coach = club.emplaceCoach("Coach " + std::to_string(i), "Football", 100 + i);
+            Team* team = club.emplaceTeam("Football", coach, i);
+            team->addMember(club.emplaceMember("Player " + std::to_string(i), 20 + i, "Athlete", i));
+            club.addTeamToEvent("Cup", team);
+            teams.push_back(team);
+        }
+        teams[1]->addMember(teams[0]->getMembers()[0]);  // Player 1 also plays for team 2
+
+        TournamentOptions options;
+        assert(TournamentGenerator(cup, options).generate().size() == 10);
+        options.home_and_away = true;
+        assert(TournamentGenerator(cup, options).generate().size() == 20);
+        options.format = TournamentFormat::DoubleElimination;
+        assert(TournamentGenerator(cup, options).generate().size() == 8);
+        options.format = TournamentFormat::GroupStage;
+        options.home_and_away = false;
+        options.group_count = 2;
+        options.advance_per_group = 1;
+        assert(TournamentGenerator(cup, options).generate().size() == 5);  // 3 + 1 group matches and a final
+
+        // Single elimination: the top seeds get byes and the final waits for both semis
+        options.format = TournamentFormat::SingleElimination;
+        TournamentGenerator knockout(cup, options);
+        const std::vector<Match>& bracket = knockout.generate();
+        assert(bracket.size() == 4);
+        const Match& final_match = bracket.back();
+        assert(final_match.home == nullptr && final_match.away == nullptr);
+        assert(final_match.candidates.size() == 5 && final_match.after.size() == 2);
+
+        SeasonScheduler scheduler(club, { "Stadium", "Field" },
+            { { "2024-06-01", "2024-06-03", { { "10:00", "12:00" }, { "14:00", "16:00" } } } }, 0);
+        std::vector<Event*> placed = knockout.schedule(scheduler);
+        assert(placed.size() == 4 && scheduler.getUnplaced().empty());
+        // The matches are club events, with their teams' players counted as participants
+        assert(club.getEvents().size() == 5);
+        for (auto event : placed) {
+            assert(club.findEvent(event->getName(), event->getDate()) == event);
+            assert(club.getParticipantCount(event->getName()) == event->getParticipantCount());
+        }
+        assert(bracket.front().event->getParticipantCount() >= 2);
+        for (const auto& match : knockout.getMatches()) {
+            for (size_t dependency : match.after) {
+                assert(knockout.getMatches()[dependency].event->getEndStamp() <= match.event->getStartStamp());
+            }
+        }
+        // Nobody plays two matches at once, even Player 1 who is on two teams
+        for (size_t i = 0; i < placed.size(); ++i) {
+            for (size_t j = i + 1; j < placed.size(); ++j) {
+                if (placed[i]->getStartStamp() < placed[j]->getEndStamp() &&
+                    placed[j]->getStartStamp() < placed[i]->getEndStamp()) {
+                    for (auto member : placed[i]->getParticipants()) {
+                        auto others = placed[j]->getParticipants();
+                        assert(std::find(others.begin(), others.end(), member) == others.end());
+                    }
+                }
+            }
+        }
+
+        std::cout << "testTournament passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testTournament failed: " << e.what() << std::endl;
+    }
+}
+
+void testAttendance() {
+    try {
+        Club club("Sports Club");
+        Member* m1 = club.emplaceMember("John", 20, "Athlete", 1);
+        Member* m2 = club.emplaceMember("Jane", 21, "Athlete", 2);
+        Event* e1 = club.emplaceEvent("2024-03-01", "Stadium", "Training");
+        Event* e2 = club.emplaceEvent("2024-03-02", "Stadium", "Training");
+        Event* e3 = club.emplaceEvent("2024-03-10", "Pool", "Swim", "09:00", "10:00");
+        club.addMembersToEvent("Swim", { m1, m2 });
+        e1->addParticipant(m1);
+        e2->addParticipant(m1);
+        assert(club.recordAttendance(e1) == 1);
+        assert(club.recordAttendance(e2) == 1);
+        assert(club.recordAttendance(e3) == 2);
+        assert(club.recordAttendance(e3) == 0);  // already recorded
+
+        // History survives the event being cancelled
+        club.cancelEvent(e3);
+        const AttendanceStore& attendance = club.getAttendance();
+        auto history = attendance.historyBetween(1, Date::parse("2024-03-01"), Date::parse("2024-03-31"));
+        assert(history.size() == 3 && history[2].event_name == "Swim" && history[2].location == "Pool");
+        assert(history[2].start_minute == 9 * 60);
+        assert(attendance.countBetween(2, Date::parse("2024-03-01"), Date::parse("2024-03-09")) == 0);
+        AttendanceStreak streak = attendance.longestStreak(1);
+        assert(streak.days == 2 && streak.first == Date::parse("2024-03-01"));
+        assert(attendance.longestStreak(1, 8).days == 3);
+
+        // A year of daily sessions spans several skip blocks; a back-filled day lands in order
+        AttendanceStore store;
+        const Date start = Date::parse("2023-01-01");
+        for (int day = 0; day < 365; ++day) {
+            if (day != 100) {
+                store.record(7, Event(start.addDays(day), "Gym", "Session", 18 * 60, 19 * 60));
+            }
+        }
+        assert(store.longestStreak(7).days == 264);
+        store.record(7, Event(start.addDays(100), "Gym", "Session", 18 * 60, 19 * 60));
+        assert(store.longestStreak(7).days == 365);
+        const Date today = start.addDays(364);
+        assert(store.countBetween(7, today.addDays(-89), today) == 90);
+        assert(store.countBetween(7, start.addDays(50), start.addDays(149)) == 100);
+        assert(store.recordCount() == 365 && store.memoryUsage() < 365 * 4 + store.eventCount() * 256);
+
+        try {
+            store.longestStreak(7, 0);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {}
+
+        // Two sessions at one venue on the same day stay separate records
+        assert(store.record(8, Event(start, "Gym", "Session", 9 * 60, 10 * 60)));
+        assert(store.record(8, Event(start, "Gym", "Session", 18 * 60, 19 * 60)));
+        auto sessions = store.historyBetween(8, start, start);
+        assert(sessions.size() == 2 && sessions[0].start_minute + sessions[1].start_minute == 27 * 60);
+
+        std::cout << "testAttendance passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testAttendance failed: " << e.what() << std::endl;
+    }
+}
+
+void testQueryCache() {
+    try {
+        Club club("Sports Club");
+        Member* m1 = club.emplaceMember("John", 20, "Athlete", 1);
+        club.emplaceMember("Jane", 21, "Coach Assistant", 2);
+        club.emplaceEvent("2024-05-01", "Stadium", "Match");
+        club.enableQueryCache(64 * 1024);
+
+        assert(club.findMembersByRole("Athlete").size() == 1);
+        assert(club.findMembersByRole("Athlete").size() == 1);
+        assert(club.findMemberByName("John") == m1);
+        assert(club.findMemberByName("John") == m1);
+        assert(club.getParticipantCount("Match") == 0);
+        assert(club.getParticipantCount("Match") == 0);
+        QueryCacheStats stats = club.getQueryCacheStats();
+        assert(stats.hits == 3 && stats.misses == 3 && stats.entries == 3);
+        assert(stats.memory_bytes > 0 && stats.memory_bytes <= stats.capacity_bytes);
+
+        // Each edit invalidates exactly the results that depend on it
+        Member* m3 = club.emplaceMember("Jack", 22, "Athlete", 3);
+        assert(club.findMembersByRole("Athlete").size() == 2);
+        club.addMembersToEvent("Match", { m1, m3 });
+        assert(club.getParticipantCount("Match") == 2);
+        m1->updateDetails("Johnny", 20);
+        assert(club.findMemberByName("John") == nullptr);
+        assert(club.findMemberByName("Johnny") == m1);
+        club.removeMember(m3);
+        assert(club.getParticipantCount("Match") == 1);
+        assert(club.findMembersByRole("Athlete").size() == 1);
+        stats = club.getQueryCacheStats();
+        assert(stats.stale == 5 && stats.hits == 3);
+
+        // Assigning over a member may change its role, which also invalidates role results
+        *m1 = Member("Johnny", 20, "Captain", 1);
+        assert(club.findMembersByRole("Athlete").empty() && club.findMembersByRole("Captain").size() == 1);
+
+        // A tiny budget evicts the least recently used entries
+        club.enableQueryCache(300);
+        for (int i = 0; i < 20; ++i) {
+            club.findMembersByRole("Role " + std::to_string(i));
+        }
+        stats = club.getQueryCacheStats();
+        assert(stats.evictions > 0 && stats.memory_bytes <= 300);
+
+        club.disableQueryCache();
+        assert(club.getQueryCacheStats().entries == 0);
+        assert(club.findMemberByName("Jane") != nullptr);
+
+        std::cout << "testQueryCache passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testQueryCache failed: " << e.what() << std::endl;
+    }
+}
+
+void testFuzzyNameSearch() {
+    try {
+        assert(TrigramIndex::editDistance("kitten", "sitting", 5) == 3);
+        assert(TrigramIndex::editDistance("kitten", "sitting", 2) == 3);  // bound + 1
+
+        Club club("Sports Club");
+        Member* m1 = club.emplaceMember("Jonathan Smith", 20, "Athlete", 1);
+        Member* m2 = club.emplaceMember("Johnathan Smyth", 21, "Athlete", 2);
+        Member* m3 = club.emplaceMember("Jane Doe", 22, "Athlete", 3);
+        club.emplaceMember("Jon", 23, "Athlete", 4);
+        club.emplaceCoach("Maria Lopez", "Tennis", 5);
+
+        auto hits = club.searchMembersByName("jonathon smith");
+        assert(hits.size() == 1 && hits[0].item == m1 && hits[0].distance == 1);
+        hits = club.searchMembersByName("jonathon smith", 3);
+        assert(hits.size() == 2 && hits[1].item == m2 && hits[1].distance == 3);
+        assert(club.searchMembersByName("jonathon smith", 3, 1).size() == 1);
+        assert(club.searchMembersByName("JAN", 1).size() == 1);  // short query, checked by length
+        assert(club.searchCoachesByName("Mario Lopes").size() == 1);
+
+        // Renames through the club and directly on the member are both picked up
+        club.updateMemberDetails(m3, "Janet Dow", 22);
+        assert(club.searchMembersByName("Jane Doe", 1).empty());
+        assert(club.searchMembersByName("Janet Doe", 1)[0].item == m3);
+        m2->updateDetails("Ann Smyth", 21);
+        assert(club.searchMembersByName("jonathon smith", 3).size() == 1);
+        assert(club.findMemberByName("Ann Smyth") == m2 && club.findMemberByName("Johnathan Smyth") == nullptr);
+        assert(club.scanMembers(ScanCursor(), 1, ScanOrder::Name).items[0] == m2);
+
+        // A member belongs to one club, and renames elsewhere leave this club alone
+        Club other("Other Club");
+        bool rejected = false;
+        try {
+            other.addMember(m3);
+        }
+        catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        assert(rejected);
+        other.emplaceMember("Jane Doe", 30, "Athlete", 9)->updateDetails("Jonathan Smit", 30);
+        assert(club.searchMembersByName("Jonathan Smit", 1).size() == 1 && other.searchMembersByName("Jonathan Smit", 0).size() == 1);
+        club.removeMember(m1);
+        assert(club.searchMembersByName("jonathon smith", 3).empty());
+
+        std::cout << "testFuzzyNameSearch passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testFuzzyNameSearch failed: " << e.what() << std::endl;
+    }
+}
+
+// Test full-text search over events, teams and coaches
+void testTextSearch() {
+    try {
+        assert((InvertedIndex::tokenize("U-12 Football, Main-Field") == std::vector<std::string>{ "u", "12", "football", "main", "field" }));
+
+        Club club("Sports Club");
+        Event* final_match = club.emplaceEvent("2024-05-01", "North Stadium", "Football Cup Final");
+        Event* friendly = club.emplaceEvent("2024-05-02", "Football Park", "Friendly Match");
+        Event* swim = club.emplaceEvent("2024-05-03", "City Pool", "Swimming Gala");
+        Coach* c1 = club.emplaceCoach("Anna Berg", "Tennis", 1);
+        club.emplaceCoach("Tom Tennison", "Swimming", 2);
+        Team* t1 = club.emplaceTeam("Table Tennis", c1, 1);
+        club.emplaceTeam("Football", c1, 2);
+
+        // A match in the name outranks one in the location
+        auto hits = club.searchEvents("football");
+        assert(hits.size() == 2 && hits[0].item == final_match && hits[1].item == friendly);
+        assert(hits[0].score > hits[1].score);
+        assert(club.searchEvents("FOOTBALL stadium", 10, true).size() == 1);
+        assert(club.searchEvents("football pool").size() == 3);
+        assert(club.searchEvents("football", 1).size() == 1);
+        assert(club.searchEvents("cricket").empty());
+
+        club.cancelEvent(final_match);
+        hits = club.searchEvents("football");
+        assert(hits.size() == 1 && hits[0].item == friendly);
+        assert(club.searchEvents("gala")[0].item == swim);
+
+        assert(club.searchTeams("tennis table", 10, true)[0].item == t1);
+        club.removeTeam(t1);
+        assert(club.searchTeams("tennis").empty());
+
+        // Specialty changes are reindexed
+        assert(club.searchCoaches("tennis")[0].item == c1);
+        club.updateCoachSpecialty("Anna Berg", "Rowing");
+        assert(club.searchCoaches("tennis").empty());
+        assert(club.searchCoaches("rowing")[0].item == c1);
+        c1->setSpecialty("Swimming");  // directly on the coach, still re-indexed by the club
+        assert(club.searchCoaches("rowing").empty() && club.searchCoaches("swimming").size() == 2);
+        bool rejected = false;
+        try {
+            club.emplaceCoach("Anna Berg", "Swimming", 3);
+        }
+        catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        assert(rejected && club.emplaceCoach("Anna Berg", "Rowing", 4) != nullptr);
+
+        std::cout << "testTextSearch passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testTextSearch failed: " << e.what() << std::endl;
+    }
+}
+
+// Test cursor-based scans that resume by key across concurrent changes
+void testScanCursors() {
+    try {
+        Club club("Sports Club");
+        std::vector<Member*> added;
+        for (int i = 0; i < 10; ++i) {
+            added.push_back(club.emplaceMember("Player " + std::to_string(9 - i), 20, "Athlete", 100 - i));
+        }
+
+        // Pages come back in id order and the last one is marked finished
+        ScanCursor cursor;
+        std::vector<Member*> seen;
+        auto page = club.scanMembers(cursor, 4);
+        assert(page.items.size() == 4 && page.items[0]->getId() == 91 && !page.next.finished);
+        seen.insert(seen.end(), page.items.begin(), page.items.end());
+
+        // Changes between pages: a removed member is skipped, one added ahead is returned
+        club.removeMember(added[2]);  // id 98
+        Member* late = club.emplaceMember("Late Joiner", 20, "Athlete", 99);
+        club.emplaceMember("Early Joiner", 20, "Athlete", 1);
+        while (!page.next.finished) {
+            page = club.scanMembers(page.next, 4);
+            seen.insert(seen.end(), page.items.begin(), page.items.end());
+        }
+        assert(seen.size() == 10 && seen[8] == late && seen.back()->getId() == 100);
+        assert(club.scanMembers(page.next, 4).items.empty());
+
+        // Name order, including renames made directly on a member
+        assert(club.scanMembers(ScanCursor(), 1, ScanOrder::Name).items[0]->getName() == "Early Joiner");
+        added[0]->updateDetails("Aaron", 20);
+        page = club.scanMembers(ScanCursor(), 2, ScanOrder::Name);
+        assert(page.items[0] == added[0] && page.items[1]->getName() == "Early Joiner");
+
+        Coach* coach = club.emplaceCoach("Coach A", "Football", 1);
+        club.emplaceTeam("Football", coach, 2);
+        club.emplaceTeam("Hockey", coach, 1);
+        assert(club.scanTeams(ScanCursor(), 10).items[0]->getId() == 1);
+        assert(club.scanCoaches(ScanCursor(), 10, ScanOrder::Name).items.size() == 1);
+        bool rejected = false;
+        try {
+            club.scanTeams(ScanCursor(), 10, ScanOrder::Date);
+        }
+        catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        assert(rejected);
+
+        // Events by start time follow reschedules
+        Event* late_event = club.emplaceEvent("2024-06-01", "Stadium", "Final");
+        Event* early_event = club.emplaceEvent("2024-05-01", "Stadium", "Opener");
+        assert(club.scanEvents(ScanCursor(), 1).items[0] == early_event);
+        club.rescheduleEvent(late_event, "2024-04-01", "10:00", "12:00");
+        assert(club.scanEvents(ScanCursor(), 1).items[0] == late_event);
+        assert(club.scanEvents(ScanCursor(), 1, ScanOrder::Name).items[0] == late_event);
+
+        // Participants in join order, resuming after the last one returned leaves
+        club.addMembersToEvent("Final", { added[0], added[1], added[3] });
+        page = club.scanEventParticipants(late_event, ScanCursor(), 2);
+        assert(page.items.size() == 2 && page.items[1] == added[1] && !page.next.finished);
+        late_event->removeParticipant(added[1]);
+        late_event->addParticipant(late);
+        page = club.scanEventParticipants(late_event, page.next, 2);
+        assert(page.items.size() == 2 && page.items[0] == added[3] && page.items[1] == late && page.next.finished);
+
+        std::cout << "testScanCursors passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testScanCursors failed: " << e.what() << std::endl;
+    }
+}
+
+// Test the indexed entity tables behind the club
+void testEntityStore() {
+    try {
+        using ById = FirstByKey<Member, IdOf>;
+        EntityStore<Member, UniqueByValue<Member>, ById> table;
+        std::vector<std::unique_ptr<Member>> people;
+        for (int i = 0; i < 40; ++i) {
+            people.emplace_back(new Member("Player " + std::to_string(i), 20, "Athlete", i % 2 == 0 ? 7 : 100 + i));
+            assert(table.insert(people.back().get()));
+        }
+        Member twin("Player 3", 20, "Athlete", 3);
+        assert(!table.insert(&twin) && !table.insert(people[0].get()));
+
+        // The id index answers with the first holder in table order, also after removals
+        assert(table.index<ById>().find(7) == people[0].get());
+        for (int i = 0; i < 30; ++i) {
+            assert(table.erase(people[i].get()));
+        }
+        assert(!table.erase(people[0].get()));
+        assert(table.index<ById>().find(7) == people[30].get());
+        assert(table.index<ById>().find(101) == nullptr);
+        auto rest = table.list();
+        assert(rest.size() == 10 && rest.front() == people[30].get() && rest.back() == people[39].get());
+
+        // Keys changed through modify are re-indexed; rejected equal values become insertable
+        assert(table.insert(&twin));
+        table.modify(people[31].get(), [&]() { people[31]->updateDetails("Player 99", 20); });
+        Member renamed("Player 99", 20, "Athlete", 8);
+        Member former("Player 31", 20, "Athlete", 9);
+        assert(!table.insert(&renamed) && table.insert(&former));
+
+        // A key changed behind the table's back does not unbalance the other holders
+        *people[33] = Member("Player 33", 20, "Athlete", 135);
+        assert(table.erase(people[33].get()));
+        assert(table.index<ById>().find(135) == people[35].get() && table.index<ById>().find(133) == nullptr);
+
+        // Club lookups and date order go through the tables
+        Club club("Sports Club");
+        Coach* coach = club.emplaceCoach("Coach A", "Football", 5);
+        assert(club.findCoachById(5) == coach && club.findCoachByName("Coach A") == coach);
+        club.updateCoachSpecialty("Coach A", "Hockey");
+        club.emplaceCoach("Coach A", "Football", 6);
+        assert(club.findCoachByName("Coach A") == coach);
+
+        // Assigning to a coach of the club re-indexes it
+        Coach* ann = club.emplaceCoach("Ann", "Tennis", 1);
+        Coach* bob = club.emplaceCoach("Bob", "Tennis", 2);
+        *ann = Coach("Bob", "Golf", 3);
+        assert(club.findCoachById(3) == ann && club.findCoachById(1) == nullptr && club.findCoachByName("Ann") == nullptr);
+        assert(club.searchCoaches("golf").size() == 1 && club.searchCoachesByName("Bob", 0).size() == 2);
+        club.removeCoach(ann);
+        assert(club.findCoachByName("Bob") == bob && club.findCoachByName("Ann") == nullptr && club.searchCoaches("golf").empty());
+        Event* first = club.emplaceEvent("2024-06-01", "Stadium", "First");
+        Event* second = club.emplaceEvent("2024-07-01", "Stadium", "Second");
+        club.rescheduleEvent(second, "2024-05-01", "10:00", "12:00");
+        auto sorted = club.getEventsSortedByDate();
+        assert(sorted.size() == 2 && sorted[0] == second && sorted[1] == first);
+
+        std::cout << "testEntityStore passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testEntityStore failed: " << e.what() << std::endl;
+    }
+}
+
+// Test memory reporting and compaction after mass removals
+void testMemoryCompaction() {
+    try {
+        Club club("Sports Club");
+        Coach* coach = club.emplaceCoach("Coach A", "Football", 1);
+        Team* team = club.emplaceTeam("Football", coach, 1);
+        std::vector<Member*> added;
+        for (int i = 0; i < 2000; ++i) {
+            added.push_back(club.emplaceMember("Player " + std::to_string(i), 20, "Athlete", 100 + i));
+            team->addMember(added.back());
+        }
+        Event* event = club.emplaceEvent("2024-05-01", "Stadium", "Match");
+        club.addMembersToEvent("Match", added);
+
+        auto partBytes = [](const MemoryReport& report, const std::string& part) {
+            for (const auto& usage : report.parts) {
+                if (usage.part == part) {
+                    return usage.bytes;
+                }
+            }
+            return size_t(0);
+        };
+        const MemoryReport before = club.getMemoryReport();
+        assert(partBytes(before, "members") > 0 && partBytes(before, "members.by_id") > 0);
+        assert(partBytes(before, "teams.rosters") >= 2000 * sizeof(Member*));
+        size_t sum = 0;
+        for (const auto& usage : before.parts) {
+            sum += usage.bytes;
+        }
+        assert(sum == before.total_bytes);
+
+        // Offboard most members; the survivors keep their addresses and lookups
+        std::streambuf* saved = std::cout.rdbuf(nullptr);
+        for (int i = 0; i < 1990; ++i) {
+            club.removeMember(added[i]);
+        }
+        std::cout.rdbuf(saved);
+        club.compact();
+        const MemoryReport after = club.getMemoryReport();
+        assert(after.total_bytes < before.total_bytes / 2);
+        assert(partBytes(after, "members.storage") < partBytes(before, "members.storage"));
+        assert(partBytes(after, "teams.rosters") < 64 * sizeof(Member*));
+        assert(club.findMemberById(2095) == added[1995] && added[1995]->getName() == "Player 1995");
+        assert(team->getMemberCount() == 10 && event->getParticipantCount() == 10);
+
+        // A threshold gives back capacity on its own but leaves removed entities alive;
+        // only an explicit compact() frees them
+        club.setCompactThreshold(2);
+        Event* extra = club.emplaceEvent("2024-05-02", "Stadium", "Extra");
+        club.cancelEvent(extra);
+        assert(club.getMemoryReport().parts.size() == after.parts.size());
+        club.cancelEvent(event);
+        Member* leaving = added[1990];
+        club.removeMembers({ leaving, added[1991] });
+        assert(extra->getName() == "Extra" && event->getParticipantCount() == 10 && leaving->getName() == "Player 1990");
+        assert(partBytes(club.getMemoryReport(), "events.storage") > 0);
+        club.compact();
+        assert(partBytes(club.getMemoryReport(), "events.storage") == 0);
+        assert(club.getEvents().empty() && club.getMembers().size() == 8);
+
+        std::cout << "testMemoryCompaction passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testMemoryCompaction failed: " << e.what() << std::endl;
+    }
+}
+
+// Test bulk removal of members and teams
+void testBulkRemoval() {
+    try {
+        Club club("Sports Club");
+        Coach* coach = club.emplaceCoach("Coach A", "Football", 1);
+        std::vector<Team*> squads;
+        for (int t = 0; t < 4; ++t) {
+            squads.push_back(club.emplaceTeam("Football", coach, t + 1));
+        }
+        std::vector<Member*> added;
+        for (int i = 0; i < 100; ++i) {
+            added.push_back(club.emplaceMember("Player " + std::to_string(i), 20, "Athlete", 100 + i));
+            squads[i % 4]->addMember(added.back());
+        }
+        Event* match = club.emplaceEvent("2024-05-01", "Stadium", "Match");
+        club.addMembersToEvent("Match", added);
+        club.addTeamToEvent("Match", squads[0]);
+        club.addTeamToEvent("Match", squads[1]);
+        CoParticipationGraph& graph = club.enableCoParticipationGraph(1);
+        assert(graph.degree(100) == 99);
+
+        // Even-indexed members leave; duplicates and strangers in the input are ignored
+        std::vector<Member*> leaving;
+        for (int i = 0; i < 100; i += 2) {
+            leaving.push_back(added[i]);
+        }
+        leaving.push_back(added[0]);
+        Member stranger("Stranger", 30, "Athlete", 999);
+        leaving.push_back(&stranger);
+        assert(club.removeMembers(leaving) == 50);
+        assert(club.getMembers().size() == 50 && club.findMemberById(100) == nullptr);
+        assert(squads[0]->getMemberCount() == 0 && squads[1]->getMemberCount() == 25);
+        assert(match->getParticipantCount() == 50 && match->getParticipants()[0] == added[1]);
+        assert(graph.degree(101) == 49 && graph.degree(100) == 0);
+        assert(club.removeMembers(leaving) == 0);
+        assert(club.searchMembersByName("Player 0", 0).empty());
+        assert(club.searchMembersByName("Player 1", 0).size() == 1);
+        club.removeMembers({ added[1] });
+        assert(club.searchMembersByName("Player 1", 0).empty() && club.searchMembersByName("Player 3", 0).size() == 1);
+
+        // Removed teams are detached from their events
+        assert(club.removeTeams({ squads[0], squads[2], squads[0] }) == 2);
+        auto remaining = club.getTeams();
+        assert(remaining.size() == 2 && remaining[0] == squads[1] && remaining[1] == squads[3]);
+        assert(squads[1]->getMemberCount() == 24);
+        auto attached = match->getTeams();
+        assert(attached.size() == 1 && attached[0] == squads[1]);
+        assert(coach->getTeamCount() == 2);
+
+        std::cout << "testBulkRemoval passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testBulkRemoval failed: " << e.what() << std::endl;
+    }
+}
+
+// Test the synthetic workload driver and deterministic record and replay
+void testWorkload() {
+    try {
+        WorkloadConfig config;
+        config.members = 300;
+        config.coaches = 5;
+        config.teams = 20;
+        config.events = 40;
+        config.venues = 4;
+        config.operations = 2000;
+        config.threads = 2;
+        config.seed = 7;
+
+        Club club("Synthetic Club");
+        WorkloadDriver::populate(club, config);
+        assert(club.getMembers().size() == 300 && club.getTeams().size() == 20 && club.getEvents().size() == 40);
+        assert(club.findMemberById(300) != nullptr && club.findMemberById(301) == nullptr);
+        size_t rostered = 0;
+        size_t largest = 0;
+        for (auto team : club.getTeams()) {
+            rostered += team->getMemberCount();
+            largest = std::max(largest, team->getMemberCount());
+        }
+        assert(rostered == 300 && largest > 300 / 20);
+
+        Workload workload = WorkloadDriver::generate(config);
+        assert(workload.streams.size() == 2 && workload.streams[0].size() == 2000);
+        WorkloadReport report = WorkloadDriver::run(workload);
+        assert(report.total_operations == 4000);
+        size_t counted = 0;
+        for (const auto& stats : report.operations) {
+            counted += stats.count;
+            assert(stats.p50 <= stats.p99 && stats.p99 <= stats.p999 && stats.p999 <= stats.max);
+        }
+        assert(counted == 4000 && report.operations[0].count > report.operations[4].count);
+        assert(report.throughput > 0);
+
+        // A recording replays to the same results, and generation is deterministic
+        std::stringstream recording;
+        workload.write(recording);
+        Workload replayed = Workload::read(recording);
+        assert(replayed.streams == workload.streams && replayed.config.seed == 7);
+        assert(WorkloadDriver::run(replayed).result_digest == report.result_digest);
+        assert(WorkloadDriver::generate(config).streams == workload.streams);
+        config.seed = 8;
+        assert(WorkloadDriver::generate(config).streams != workload.streams);
+
+        std::stringstream broken("workload 1\nconfig 10 1 1 1 1 1 5 1 0 0 0 0 1 1\nstream 0 5\nfind 1 0 0\n");
+        try {
+            Workload::read(broken);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+        config.threads = 0;
+        try {
+            WorkloadDriver::generate(config);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+
+        std::cout << "testWorkload passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testWorkload failed: " << e.what() << std::endl;
+    }
+}
+
+// Test serving a club over a UNIX domain socket with pipelined requests
+void testClubServer() {
+    try {
+        Club club("Served Club");
+        club.emplaceMember("Alice Smith", 25, "Athlete", 1);
+        club.emplaceMember("Bob Jones", 30, "Captain", 2);
+        club.emplaceEvent("2024-06-01", "Court", "Summer Cup", "10:00", "12:00");
+        const std::string path = "/tmp/club_test." + std::to_string(getpid()) + ".sock";
+        ClubServer server(club, path);
+        std::thread loop([&server]() { server.run(); });
+
+        {
+            // Everything is queued, then sent in one write and answered in order
+            ClubClient client(path);
+            client.ping();
+            client.findMemberById(1);
+            client.findMemberById(99);
+            client.addMember("Carol White", 28, "Reserve", 3);
+            client.addMember("Carol White", 28, "Reserve", 3);
+            client.findMemberByName("Carol White");
+            client.searchMembers("Alise Smith", 1, 5);
+            client.signUp("Summer Cup", 2);
+            client.signUp("Winter Cup", 2);
+            client.getParticipantCount("Summer Cup");
+            client.hasScheduleConflict("Court", "2024-06-01", "11:00", "13:00");
+            client.searchEvents("summer", 5);
+            client.removeMember(1);
+            client.removeMember(1);
+            assert(client.pending() == 14);
+            client.flush();
+
+            assert(client.receive().ok());
+            MemberRecord alice = client.receive().member();
+            assert(alice.id == 1 && alice.age == 25 && alice.name == "Alice Smith" && alice.role == "Athlete");
+            assert(client.receive().status == ClubStatus::NotFound);
+            assert(client.receive().ok());
+            ClubResponse duplicate = client.receive();
+            assert(duplicate.status == ClubStatus::Error && !duplicate.error().empty());
+            assert(client.receive().member().id == 3);
+            auto similar = client.receive().members();
+            assert(similar.size() == 1 && similar[0].id == 1);
+            assert(client.receive().ok());
+            assert(client.receive().status == ClubStatus::NotFound);
+            assert(client.receive().count() == 1);
+            assert(client.receive().flag());
+            auto events = client.receive().names();
+            assert(events.size() == 1 && events[0] == "Summer Cup");
+            assert(client.receive().ok());
+            assert(client.receive().status == ClubStatus::NotFound);
+            assert(client.pending() == 0);
+
+            // Deep pipelines from two connections are answered in batches
+            ClubClient other(path);
+            for (int i = 0; i < 1000; ++i) {
+                client.findMemberById(2 + i % 2);
+                other.ping();
+            }
+            client.flush();
+            other.flush();
+            for (int i = 0; i < 1000; ++i) {
+                assert(client.receive().member().id == 2 + i % 2);
+                assert(other.receive().ok());
+            }
+            try {
+                client.receive();
+                assert(false);
+            }
+            catch (const std::invalid_argument&) {
+            }
+        }
+
+        server.stop();
+        loop.join();
+        ServerStats stats = server.getStats();
+        assert(stats.connections == 2 && stats.requests == 2014 && stats.batches < stats.requests);
+        assert(club.getMembers().size() == 2 && club.findMemberById(3) != nullptr);
+        try {
+            ClubServer bad(club, std::string(200, 'x'));
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+
+        std::cout << "testClubServer passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testClubServer failed: " << e.what() << std::endl;
+    }
+}
+
+// Test coroutine bulk operations: chunking, cancellation, failures and backpressure
+void testAsyncBulk() {
+    try {
+        Club club("Async Club");
+        QueueExecutor executor;
+        std::vector<Member*> people;
+        for (int i = 0; i < 1000; ++i) {
+            people.push_back(new Member("Async " + std::to_string(i), 20, "Athlete", 5000 + i));
+        }
+
+        // Nothing runs until the executor is pumped; each step applies at most one chunk
+        BulkTask import = addMembersAsync(club, people, executor, { 100 });
+        assert(!import.done() && club.getMembers().empty() && executor.pending() == 1);
+        size_t steps = 0;
+        while (executor.runOne()) {
+            ++steps;
+            assert(import.getProgress().processed == std::min<size_t>(steps * 100, 1000));
+            assert(club.findMemberById(5000) != nullptr && club.getMembers().size() == steps * 100);
+        }
+        assert(steps == 10 && import.done() && !import.getProgress().cancelled);
+        import.rethrowIfFailed();
+
+        // A cancel stops at the next chunk boundary and keeps what was applied
+        club.emplaceEvent("2024-07-01", "Arena", "Cup");
+        BulkTask signup = addMembersToEventAsync(club, "Cup", people, executor, { 250 });
+        executor.runOne();
+        signup.cancel();
+        executor.runUntilIdle();
+        BulkProgress progress = signup.getProgress();
+        assert(progress.done && progress.cancelled && progress.processed == 250 && progress.total == 1000);
+        assert(club.getParticipantCount("Cup") == 250);
+
+        // A failing item stops the operation and is reported
+        Member* fresh = new Member("Async fresh", 20, "Athlete", 6000);
+        BulkTask failing = addMembersAsync(club, { fresh, people[0] }, executor, { 1 });
+        executor.runUntilIdle();
+        assert(failing.done() && failing.getProgress().failed && failing.getProgress().processed == 1);
+        try {
+            failing.rethrowIfFailed();
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+
+        Coach* coach = club.emplaceCoach("Async Coach", "Football", 1);
+        std::vector<Team*> squads;
+        for (int t = 0; t < 3; ++t) {
+            squads.push_back(club.emplaceTeam("Football", coach, t + 1));
+        }
+        BulkTask teams = addTeamsToEventAsync(club, "Cup", squads, executor, { 2 });
+        assert(executor.runUntilIdle() == 2 && teams.done() && club.getEvents()[0]->getTeams().size() == 3);
+
+        BulkTask removal = removeMembersAsync(club, std::vector<Member*>(people.begin(), people.begin() + 500),
+                                              executor, { 200 });
+        assert(executor.runUntilIdle() == 3 && removal.getProgress().processed == 500);
+        assert(club.getMembers().size() == 501 && club.getParticipantCount("Cup") == 0);
+
+        // A full channel refuses items until the import makes room; a coroutine producer
+        // is parked instead
+        BoundedChannel<Member*> channel(executor, 10);
+        BulkTask feed = importMembersAsync(club, channel, executor, { 4 });
+        for (int i = 0; i < 10; ++i) {
+            assert(channel.tryPush(new Member("Fed " + std::to_string(i), 30, "Athlete", 7000 + i)));
+        }
+        Member extra("Extra", 30, "Athlete", 9999);
+        assert(channel.full() && !channel.tryPush(&extra));
+        executor.runOne();
+        assert(channel.size() == 6 && feed.getProgress().processed == 4);
+        auto produce = [&channel, &executor](int first, int count) -> BulkTask {
+            co_await Reschedule{ executor };
+            for (int i = 0; i < count; ++i) {
+                co_await channel.push(new Member("Fed " + std::to_string(first + i), 30, "Athlete", first + i));
+                assert(channel.size() <= 10);
+            }
+            channel.close();
+        };
+        BulkTask producer = produce(7010, 20);
+        executor.runUntilIdle();
+        assert(producer.done() && !producer.getProgress().failed);
+        assert(feed.done() && !feed.getProgress().failed && feed.getProgress().processed == 30);
+        assert(club.findMemberById(7029) != nullptr && channel.isClosed() && !channel.tryPush(&extra));
+
+        // Work abandoned by its executor counts as cancelled
+        BulkTask abandoned = [&club]() {
+            QueueExecutor local;
+            return addMembersAsync(club, {}, local);
+        }();
+        assert(abandoned.done() && abandoned.getProgress().cancelled);
+        try {
+            addMembersAsync(club, {}, executor, { 0 });
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+
+        std::cout << "testAsyncBulk passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testAsyncBulk failed: " << e.what() << std::endl;
+    }
+}
+
+// Test the disk-backed member store on its own and behind a club
+void testMemberStore() {
+    const std::string path = "/tmp/club_test." + std::to_string(getpid()) + ".members";
+    ::unlink(path.c_str());
+    try {
+        {
+            // A small cache forces splits and evictions early
+            MemberStore store(path, 8);
+            for (int i = 0; i < 5000; ++i) {
+                const int id = (i * 7919) % 5000 + 100;
+                assert(store.put({ id, 20 + id % 30, "Stored " + std::to_string(id), "Athlete" }));
+            }
+            assert(!store.put({ 100, 20 + 100 % 30, "Stored 100", "Athlete" }));
+            assert(store.size() == 5000);
+            MemberRecord record;
+            assert(store.find(4321, record) && record.name == "Stored 4321" && record.age == 20 + 4321 % 30);
+            assert(!store.find(99, record) && !store.find(5100, record));
+            assert(store.findByName("Stored 777", record) && record.id == 777);
+            assert(!store.findByName("Stored 77", record));
+            assert(store.findAllByName("Stored 4321").size() == 1 && store.findAllByName("Stored 77").empty());
+            assert(store.put({ 777, 40, "Renamed", "Captain" }) == false);
+            assert(!store.findByName("Stored 777", record) && store.findByName("Renamed", record) && record.id == 777);
+            assert(store.erase(778) && !store.erase(778) && !store.contains(778) && store.size() == 4999);
+
+            // Scans page through the trees in order and resume after the cursor
+            ScanCursor cursor;
+            std::vector<int> ids;
+            while (!cursor.finished) {
+                MemberRecordPage page = store.scan(ScanOrder::Id, cursor, 700);
+                for (const auto& item : page.records) {
+                    ids.push_back(item.id);
+                }
+                cursor = page.next;
+            }
+            assert(ids.size() == 4999 && std::is_sorted(ids.begin(), ids.end()) && ids.front() == 100);
+            MemberRecordPage by_name = store.scan(ScanOrder::Name, {}, 3);
+            assert(by_name.records.size() == 3 && by_name.records[0].name == "Renamed" && !by_name.next.finished);
+            assert(by_name.records[1].name == "Stored 100" && by_name.records[2].name == "Stored 1000");
+            assert(store.scan(ScanOrder::Name, by_name.next, 1).records[0].name == "Stored 1001");
+            BufferStats cache = store.getStats().cache;
+            assert(cache.cached_pages <= 8 && cache.evictions > 0 && cache.misses > 0);
+            try {
+                store.put({ 1, 20, std::string(2000, 'x'), "Athlete" });
+                assert(false);
+            }
+            catch (const std::invalid_argument&) {
+            }
+        }
+
+        // A reopened store reads everything back from the file
+        MemberStore reopened(path);
+        MemberRecord record;
+        assert(reopened.size() == 4999 && reopened.find(777, record) && record.role == "Captain");
+        reopened.dropCache();
+        assert(reopened.getStats().cache.cached_pages == 0 && reopened.findByName("Stored 4000", record));
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testMemberStore failed: " << e.what() << std::endl;
+        ::unlink(path.c_str());
+        return;
+    }
+
+    try {
+        Club club("Registry Club");
+        Member* resident = club.emplaceMember("Resident", 30, "Coach", 1);
+        MemberStore& store = club.openMemberStore(path, 64);
+        assert(store.size() == 5000 && store.contains(1) && club.getMemberStore() == &store);
+
+        // Lookups fall back to the store and load each member once
+        Member* loaded = club.findMemberById(4321);
+        assert(loaded != nullptr && loaded->getName() == "Stored 4321" && club.findMemberById(4321) == loaded);
+        assert(club.findMemberByName("Stored 4000") == club.findMemberById(4000));
+        assert(club.findMemberById(1) == resident && club.findMemberById(99) == nullptr);
+        assert(club.getMembers().size() == 1);
+
+        // Duplicates are found by value, as without a store; a new member takes over the id
+        Member* twin = new Member("Stored 4100", 20 + 4100 % 30, "Athlete", 9100);
+        try {
+            club.addMember(twin);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+            delete twin;
+        }
+        Member* clash = club.emplaceMember("Clash", 20, "Athlete", 4322);
+        MemberRecord record;
+        assert(store.find(4322, record) && record.name == "Clash" && club.findMemberById(4322) == clash);
+
+        // Changes through the club are written through to the store
+        club.emplaceMember("Newcomer", 22, "Athlete", 9000);
+        club.updateMemberDetails(loaded, "Loaded Renamed", 41);
+        assert(store.find(9000, record) && store.find(4321, record) && record.name == "Loaded Renamed");
+        assert(club.findMemberByName("Loaded Renamed") == loaded);
+
+        // Renames in another club cost this club's store nothing
+        const BufferStats before = store.getStats().cache;
+        Club elsewhere("Elsewhere Club");
+        elsewhere.emplaceMember("Visitor", 30, "Athlete", 1)->updateDetails("Visitor Renamed", 31);
+        club.searchMembersByName("Resident");
+        const BufferStats after = store.getStats().cache;
+        assert(after.hits == before.hits && after.misses == before.misses);
+        Member* leaving = club.findMemberById(4000);
+        club.removeMember(leaving);
+        assert(!store.contains(4000) && club.findMemberById(4000) == nullptr);
+
+        // A scan covers the whole registry
+        ScanCursor cursor;
+        size_t seen = 0;
+        while (!cursor.finished) {
+            ScanPage<Member> page = club.scanMembers(cursor, 1000);
+            seen += page.items.size();
+            cursor = page.next;
+        }
+        assert(seen == store.size() && seen == 5000);
+
+        // Compaction leaves loaded members alone; unloading keeps only those on a roster
+        Coach* coach = club.emplaceCoach("Registry Coach", "Football", 1);
+        Team* team = club.emplaceTeam("Football", coach, 1);
+        Member* kept = club.findMemberById(200);
+        team->addMember(kept);
+        club.compact();
+        assert(club.findMemberById(4321) == loaded && loaded->getName() == "Loaded Renamed");
+        assert(club.unloadMembers() > 0);
+        assert(club.findMemberById(200) == kept && club.findMemberById(4321)->getName() == "Loaded Renamed");
+        club.addMember(kept);
+        assert(club.getMembers().size() == 4);
+        assert(club.getMemoryReport().parts.size() > 2);
+
+        try {
+            club.openMemberStore(path);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+        std::cout << "testMemberStore passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testMemberStore failed: " << e.what() << std::endl;
+    }
+    ::unlink(path.c_str());
+}
+
+// Test compressing blocks and round-tripping a club through an archive
+void testArchive() {
+    try {
+        std::string repetitive;
+        for (int i = 0; i < 2000; ++i) {
+            repetitive += "Athlete " + std::to_string(i % 40) + ";";
+        }
+        std::string packed = compressBlock(repetitive.data(), repetitive.size());
+        assert(packed.size() < repetitive.size() / 4);
+        std::string unpacked(repetitive.size(), '\0');
+        decompressBlock(packed.data(), packed.size(), &unpacked[0], unpacked.size());
+        assert(unpacked == repetitive);
+
+        std::string noise(5000, '\0');
+        std::uint32_t state = 12345;
+        for (auto& c : noise) {
+            state = state * 1103515245u + 12345u;
+            c = static_cast<char>(state >> 24);
+        }
+        packed = compressBlock(noise.data(), noise.size());
+        unpacked.assign(noise.size(), '\0');
+        decompressBlock(packed.data(), packed.size(), &unpacked[0], unpacked.size());
+        assert(unpacked == noise);
+        try {
+            decompressBlock(packed.data(), packed.size() - 1, &unpacked[0], unpacked.size());
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+
+        Club club("Sports Club");
+        Coach* laura = club.emplaceCoach("Laura", "Tennis", 7);
+        Coach* mark = club.emplaceCoach("Mark", "Football", 9);
+        for (int id = 1; id <= 300; ++id) {
+            club.emplaceMember("Member " + std::to_string(id), 18 + id % 20, id % 10 == 0 ? "Captain" : "Athlete", id * 3);
+        }
+        std::vector<Member*> members = club.getMembers();
+        Team* tennis = club.emplaceTeam("Tennis", laura, 1);
+        Team* football = club.emplaceTeam("Football", mark, 2);
+        Coach* temporary = club.emplaceCoach("Temporary", "Chess", 11);
+        club.emplaceTeam("Chess", temporary, 3)->removeCoach();
+        for (size_t i = 0; i < 40; ++i) {
+            tennis->addMember(members[i]);
+            football->addMember(members[i * 5]);
+        }
+        Event* cup = club.emplaceEvent("2024-05-03", "Stadium", "Cup", "10:00", "12:30");
+        Event* open = club.emplaceEvent("2024-06-01", "Court 2", "Open");
+        cup->addTeam(tennis);
+        cup->addParticipant(members[299]);
+        open->addParticipant(members[7]);
+        open->addTeam(football);
+
+        for (bool compress : { true, false }) {
+            std::stringstream stream;
+            ArchiveOptions options;
+            options.compress = compress;
+            options.block_rows = 64;
+            const ArchiveStats written = exportClub(club, stream, options);
+            assert(written.members == 300 && written.coaches == 3 && written.teams == 3 && written.events == 2);
+            assert(written.archive_bytes == stream.str().size());
+            assert(compress ? written.archive_bytes < written.encoded_bytes : written.archive_bytes > written.encoded_bytes);
+
+            Club copy("Copy Club");
+            CoParticipationGraph& graph = copy.enableCoParticipationGraph();
+            const ArchiveStats read = importClub(copy, stream);
+            assert(graph.topPartners(900, 100).size() == 40);  // members[299] met the tennis team at the cup
+            assert(read.members == 300 && read.events == 2 && read.archive_bytes == written.archive_bytes);
+            Member* member = copy.findMemberById(30);
+            assert(member != nullptr && member->getName() == "Member 10" && member->getAge() == 28 &&
+                   member->getRole() == "Captain");
+            std::vector<Team*> teams = copy.getTeams();
+            auto teamWithId = [&teams](int id) {
+                auto it = std::find_if(teams.begin(), teams.end(), [id](Team* t) { return t->getId() == id; });
+                return it == teams.end() ? nullptr : *it;
+            };
+            Team* team = teamWithId(1);
+            assert(team != nullptr && team->getCoach() != nullptr && team->getCoach()->getName() == "Laura");
+            assert(team->getMembers().size() == 40 && teamWithId(3)->getCoach() == nullptr);
+            std::vector<Event*> events = copy.getEventsSortedByDate();
+            assert(events.size() == 2 && events[0]->getName() == "Cup" && events[0]->getLocation() == "Stadium");
+            assert(events[0]->getStartTime() == "10:00" && events[0]->getEndTime() == "12:30");
+            assert(events[0]->getParticipants().size() == 41 && events[0]->getTeams().size() == 1);
+            assert(events[1]->getDate() == "2024-06-01" && events[1]->getParticipants().front()->getId() == 24);
+        }
+
+        // A damaged archive is rejected rather than half-read silently
+        std::stringstream stream;
+        exportClub(club, stream);
+        std::string bytes = stream.str();
+        std::istringstream truncated(bytes.substr(0, bytes.size() / 2));
+        Club partial("Partial Club");
+        try {
+            importClub(partial, truncated);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+        std::istringstream foreign("not an archive at all, but long enough to hold a header");
+        try {
+            importClub(partial, foreign);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+        std::cout << "testArchive passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testArchive failed: " << e.what() << std::endl;
+    }
+}
+
+// Test eligibility rules checked on sign-up
+void testEligibility() {
+    try {
+        Club club("Sports Club");
+        Coach* coach = club.emplaceCoach("Laura", "Tennis", 1);
+        Team* juniors = club.emplaceTeam("Tennis", coach, 1);
+        Team* rowers = club.emplaceTeam("Rowing", coach, 2);
+        std::vector<Member*> candidates;
+        for (int id = 1; id <= 500; ++id) {
+            Member* member = club.emplaceMember("Player " + std::to_string(id), 10 + id % 20,
+                                                id % 50 == 0 ? "Guest" : "Athlete", id);
+            candidates.push_back(member);
+            juniors->addMember(member);
+        }
+        rowers->addMember(candidates[0]);
+
+        Event* open = club.emplaceEvent("2024-07-01", "Court 1", "Open");
+        assert(open->getEligibility() == nullptr);
+        EligibilityRules rules;
+        rules.min_age = 12;
+        rules.max_age = 25;
+        rules.allowed_roles = { "Athlete", "Captain", "Athlete" };
+        rules.sport_type = "Tennis";
+        rules.max_participants = 300;
+        open->setEligibility(rules);
+        assert(open->getEligibility()->allowed_roles.size() == 2);
+
+        // The whole team is checked in one batch; the reason is the first rule broken
+        const std::vector<Rejection> rejected = club.addTeamToEvent("Open", juniors);
+        size_t young = 0;
+        size_t old = 0;
+        size_t barred = 0;
+        size_t full = 0;
+        for (const auto& rejection : rejected) {
+            const int age = rejection.member->getAge();
+            switch (rejection.reason) {
+            case Ineligibility::TooYoung:
+                assert(age < 12);
+                ++young;
+                break;
+            case Ineligibility::TooOld:
+                assert(age > 25);
+                ++old;
+                break;
+            case Ineligibility::RoleNotAllowed:
+                assert(age >= 12 && age <= 25 && rejection.member->getRole() == "Guest");
+                ++barred;
+                break;
+            default:
+                assert(rejection.reason == Ineligibility::EventFull);
+                ++full;
+            }
+        }
+        assert(young == 50 && old == 100 && barred == 5 && full == 45);
+        assert(open->getParticipantCount() == 300 && open->getTeams().size() == 1);
+        for (auto member : open->getParticipants()) {
+            assert(member->getAge() >= 12 && member->getAge() <= 25 && member->getRole() == "Athlete");
+        }
+
+        // A team of another sport is turned away as a whole
+        try {
+            open->addTeam(rowers);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+        assert(open->getTeams().size() == 1);
+
+        // A member listed twice on a team is signed up, and takes a place, once
+        Team* pairs = club.emplaceTeam("Tennis", coach, 3);
+        pairs->addMember(candidates[10]);
+        pairs->addMember(candidates[10]);
+        pairs->addMember(candidates[12]);
+        Event* doubles = club.emplaceEvent("2024-07-03", "Court 3", "Doubles");
+        EligibilityRules pair_rules;
+        pair_rules.max_participants = 2;
+        doubles->setEligibility(pair_rules);
+        assert(club.addTeamToEvent(doubles, pairs).empty() && doubles->getParticipantCount() == 2);
+
+        // Single sign-ups throw with the reason; batches report it
+        try {
+            open->addParticipant(candidates[0]);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+        Event* clinic = club.emplaceEvent("2024-07-02", "Court 2", "Clinic");
+        EligibilityRules clinic_rules;
+        clinic_rules.allowed_roles = { "Athlete" };
+        clinic->setEligibility(clinic_rules);
+        const std::vector<Rejection> guests = club.addMembersToEvent("Clinic", { candidates[48], candidates[49], candidates[99] });
+        assert(guests.size() == 2 && guests[0].member == candidates[49] && guests[1].reason == Ineligibility::RoleNotAllowed);
+        assert(clinic->getParticipantCount() == 1);
+        try {
+            club.addMembersToEvent("Clinic", { candidates[1], nullptr });
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+        assert(clinic->getParticipantCount() == 1);
+
+        // Copies share the rules, clearing them admits anyone
+        Event copy(*clinic);
+        assert(copy.getEligibility() != nullptr && !copy.addParticipants({ candidates[49] }).empty());
+        clinic->clearEligibility();
+        assert(club.addMembersToEvent("Clinic", { candidates[49] }).empty() && clinic->getParticipantCount() == 2);
+
+        try {
+            EligibilityRules inverted;
+            inverted.min_age = 30;
+            inverted.max_age = 20;
+            clinic->setEligibility(inverted);
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+        std::cout << "testEligibility passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testEligibility failed: " << e.what() << std::endl;
+    }
+}
+
+// Test looking events up by name and by name and date
+void testEventNameIndex() {
+    try {
+        Club club("Sports Club");
+        Coach* coach = club.emplaceCoach("Laura", "Tennis", 1);
+        Team* team = club.emplaceTeam("Tennis", coach, 1);
+        Member* m1 = club.emplaceMember("Alice", 20, "Athlete", 1);
+        Member* m2 = club.emplaceMember("Bob", 22, "Athlete", 2);
+        team->addMember(m2);
+        Event* cup2023 = club.emplaceEvent("2023-05-01", "Stadium", "Cup");
+        Event* cup2024 = club.emplaceEvent("2024-05-01", "Stadium", "Cup");
+        Event* open = club.emplaceEvent("2024-06-01", "Court", "Open");
+
+        std::vector<Event*> cups = club.findEventsByName("Cup");
+        assert(cups.size() == 2 && cups[0] == cup2023 && cups[1] == cup2024);
+        assert(club.findEventsByName("Final").empty());
+        assert(club.findEvent("Cup", "2024-05-01") == cup2024 && club.findEvent("Cup", "2024-05-02") == nullptr);
+
+        // A name reaches every event of that name, a date narrows it to one season
+        club.addMembersToEvent("Cup", { m1 });
+        assert(cup2023->getParticipantCount() == 1 && cup2024->getParticipantCount() == 1);
+        club.addMembersToEvent("Cup", "2024-05-01", { m2 });
+        assert(cup2023->getParticipantCount() == 1 && cup2024->getParticipantCount() == 2);
+        club.addTeamToEvent("Cup", "2023-05-01", team);
+        assert(cup2023->getTeams().size() == 1 && cup2024->getTeams().empty());
+        assert(club.addMembersToEvent("Final", { m1 }).empty());
+
+        // Pointer overloads skip the lookup but still check the event belongs to the club
+        club.addMembersToEvent(open, { m1, m2 });
+        club.addTeamToEvent(open, team);
+        assert(open->getParticipantCount() == 2 && club.getParticipantCount("Open") == 2);
+        Event outsider("2024-06-01", "Court", "Outsider");
+        try {
+            club.addMembersToEvent(&outsider, { m1 });
+            assert(false);
+        }
+        catch (const std::invalid_argument&) {
+        }
+
+        // Rescheduling and cancelling keep both indexes current
+        club.rescheduleEvent(cup2023, "2023-05-08", "10:00", "12:00");
+        assert(club.findEvent("Cup", "2023-05-01") == nullptr && club.findEvent("Cup", "2023-05-08") == cup2023);
+        assert(club.findEventsByName("Cup")[0] == cup2023);
+        cup2024->reschedule("2024-05-15");  // directly on the event, still re-keyed by the club
+        assert(club.findEvent("Cup", "2024-05-01") == nullptr && club.findEvent("Cup", "2024-05-15") == cup2024);
+        open->reschedule("2024-06-02", "09:00", "11:00");
+        assert(club.findEvent("Open", "2024-06-02") == open && club.findEventsByName("Open").size() == 1);
+        club.cancelEvent(cup2023);
+        assert(club.findEventsByName("Cup").size() == 1 && club.findEvent("Cup", "2023-05-08") == nullptr);
+        assert(club.findEvent("Cup", "2024-05-15") == cup2024);
+        assert(club.getParticipantCount("Cup") == 2);
+        std::cout << "testEventNameIndex passed" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "testEventNameIndex failed: " << e.what() << std::endl;
+    }
+}
+
+// Test removing a member and its effect on associated teams and events
+void testRemoveMember() {
+    std::cout << "Starting testRemoveMember" << std::endl;
+    Club myClub("Sports Club");
+
+    Member* m1 = new Member("John", 30, "Athlete", 1);
+    Member* m2 = new Member("Jane", 25, "Athlete", 2);
+    myClub.addMember(m1);
+    myClub.addMember(m2);
+
+    Coach* c1 = new Coach("Coach A", "Football", 1);
+    myClub.addCoach(c1);
+
+    Event* e1 = new Event("2024-04-19", "Stadium", "Football Match");
+    myClub.organizeEvent(e1);
+    myClub.addMembersToEvent("Football Match", { m1, m2 });
+
+    Team* t1 = new Team("Football", c1, 1);
+    t1->addMember(m1);
+    t1->addMember(m2);
+    myClub.addTeam(t1);
+
+    std::cout << "Finding person with ID 1 before deletion:" << std::endl;
+    myClub.findPersonById(1);
+
+    std::cout << "Removing member with ID 1:" << std::endl;
+    myClub.removeMember(m1);
+
+    std::cout << "Finding person with ID 1 after deletion:" << std::endl;
+    myClub.findPersonById(1);
+
+    // Check if the member is removed from the team
+    if (t1->getMembers().size() == 1 && t1->getMembers()[0]->getId() == 2) {
+        std::cout << "Member successfully removed from team." << std::endl;
+    }
+    else {
+        std::cerr << "Failed to remove member from team." << std::endl;
+    }
+
+    // Check if the member is removed from the event
+    if (e1->getParticipants().size() == 1 && e1->getParticipants()[0]->getId() == 2) {
+        std::cout << "Member successfully removed from event." << std::endl;
+    }
+    else {
+        std::cerr << "Failed to remove member from event." << std::endl;
+    }
+
+    std::cout << "testRemoveMember completed" << std::endl;
+}
+
+// Test removing a coach and its effect on associated teams
+void testRemoveCoach() {
+    std::cout << "Starting testRemoveCoach" << std::endl;
+    Club myClub("Sports Club");
+
+    Member* m1 = new Member("John", 30, "Athlete", 1);
+    Member* m2 = new Member("Jane", 25, "Athlete", 2);
+    myClub.addMember(m1);
+    myClub.addMember(m2);
+
+    Coach* c1 = new Coach("Coach A", "Football", 1);
+    myClub.addCoach(c1);
+
+    Event* e1 = new Event("2024-04-19", "Stadium", "Football Match");
+    myClub.organizeEvent(e1);
+    myClub.addMembersToEvent("Football Match", { m1, m2 });
+
+    Team* t1 = new Team("Football", c1, 1);
+    t1->addMember(m1);
+    t1->addMember(m2);
+    myClub.addTeam(t1);
+
+    std::cout << "Finding person with ID 1 (Coach) before deletion:" << std::endl;
+    myClub.findPersonById(1);
+
+    std::cout << "Removing coach with ID 1:" << std::endl;
+    myClub.removeCoach(c1);
+
+    std::cout << "Finding person with ID 1 (Coach) after deletion:" << std::endl;
+    myClub.findPersonById(1);
+
+    // Check if the team still exists but without a coach
+    if (t1->getCoach() == nullptr) {
+        std::cout << "Coach successfully removed from team, team still exists." << std::endl;
+    }
+    else {
+        std::cerr << "Failed to remove coach from team." << std::endl;
+    }
+
+    std::cout << "testRemoveCoach completed" << std::endl;
+}
+
+
+
+
+
+void printDivider(const std::string& title) {
+    std::cout << "\n-----------------------------------\n";
+    std::cout << title << '\n';
+    std::cout << "-----------------------------------\n";
+}
+
+void testClubFunctionality() {
+    printDivider("Creating Club: Elite Sports Club");
+    Club club("Elite Sports Club");
+
+    printDivider("Adding Members: Jack, Kelly and Bob");
+    Member* m1 = new Member("Jack", 24, "Athlete", 1);
+    Member* m2 = new Member("Kelly", 26, "Athlete", 2);
+    Member* m3 = new Member("Bob", 30, "Athlete", 3);
+    club.addMember(m1);
+    club.addMember(m2);
+    club.addMember(m3);
+
+    std::cout << "Current Members:\n";
+    for (const auto& member : club.getMembers()) {
+        std::cout << "Name: " << member->getName() << ", Age: " << member->getAge() << ", Role: " << member->getRole() << ", ID: " << member->getId() << '\n';
+    }
+
+    printDivider("Adding Coaches: Laura (Tennis) and Sam (Swimming)");
+    Coach* c1 = new Coach("Laura", "Tennis", 1);
+    Coach* c2 = new Coach("Sam", "Swimming", 2);
+    club.addCoach(c1);
+    club.addCoach(c2);
+
+    std::cout << "Current Coaches:\n";
+    for (const auto& coach : club.getCoaches()) {
+        std::cout << "Name: " << coach->getName() << ", Specialty: " << coach->getSpecialty() << ", ID: " << coach->getId() << '\n';
+    }
+
+    printDivider("Creating and Adding Teams: Tennis Team and Swimming Team");
+    Team* t1 = new Team("Tennis", c1, 1);
+    Team* t2 = new Team("Swimming", c2, 2);
+    t1->addMember(m1);
+    t1->addMember(m2);
+    t2->addMember(m3);
+    club.addTeam(t1);
+    club.addTeam(t2);
+
+    std::cout << "Current Teams:\n";
+    for (const auto& team : club.getTeams()) {
+        std::cout << "Sport Type: " << team->getSportType() << ", ID: " << team->getId() << '\n';
+        std::cout << "Team Members:\n";
+        for (const auto& member : team->getMembers()) {
+            std::cout << "  Name: " << member->getName() << ", ID: " << member->getId() << '\n';
+        }
+    }
+
+    printDivider("Organizing Events: Tennis Tournament and Swimming Competition");
+    Event* e1 = new Event("2024-08-20", "City Arena", "Tennis Tournament");
+    Event* e2 = new Event("2024-09-10", "Aquatic Center", "Swimming Competition");
+    club.organizeEvent(e1);
+    club.organizeEvent(e2);
+    club.addMembersToEvent("Tennis Tournament", { m1, m2 });
+    club.addMembersToEvent("Swimming Competition", { m3 });
+
+    std::cout << "Current Events:\n";
+    for (const auto& event : club.getEvents()) {
+        std::cout << "Event Name: " << event->getName() << ", Date: " << event->getDate() << ", Location: " << event->getLocation() << '\n';
+        std::cout << "Event Participants:\n";
+        for (const auto& participant : event->getParticipants()) {
+            std::cout << "  Name: " << participant->getName() << ", ID: " << participant->getId() << '\n';
+        }
+    }
+
+    printDivider("Updating Coach Specialty: Laura to Basketball");
+    club.updateCoachSpecialty("Laura", "Basketball");
+
+    std::cout << "Updated Coach:\n";
+    for (const auto& coach : club.getCoaches()) {
+        std::cout << "Name: " << coach->getName() << ", Specialty: " << coach->getSpecialty() << ", ID: " << coach->getId() << '\n';
+    }
+
+    printDivider("Checking Schedule Conflict for 2024-08-20 and 2024-09-10");
+    bool conflict1 = club.hasScheduleConflict("2024-08-20");
+    bool conflict2 = club.hasScheduleConflict("2024-09-10");
+    std::cout << "Schedule Conflict on 2024-08-20: " << (conflict1 ? "Yes" : "No") << '\n';
+    std::cout << "Schedule Conflict on 2024-09-10: " << (conflict2 ? "Yes" : "No") << '\n';
+
+    printDivider("Finding Members by Role: Athlete");
+    auto athletes = club.findMembersByRole("Athlete");
+    for (const auto& member : athletes) {
+        std::cout << "Name: " << member->getName() << ", ID: " << member->getId() << '\n';
+    }
+
+    printDivider("Finding Member by Name: Kelly");
+    Member* foundMember = club.findMemberByName("Kelly");
+    if (foundMember) {
+        std::cout << "Found Member: " << foundMember->getName() << ", ID: " << foundMember->getId() << '\n';
+    }
+    else {
+        std::cout << "Member not found\n";
+    }
+
+    printDivider("Removing Member: Jack");
+    club.removeMember(m1);
+    std::cout << "Current Members after removal:\n";
+    for (const auto& member : club.getMembers()) {
+        std::cout << "Name: " << member->getName() << ", ID: " << member->getId() << '\n';
+    }
+
+    printDivider("Removing Coach: Laura");
+    club.removeCoach(c1);
+    std::cout << "Current Coaches after removal:\n";
+    for (const auto& coach : club.getCoaches()) {
+        std::cout << "Name: " << coach->getName() << ", ID: " << coach->getId() << '\n';
+    }
+
+    printDivider("Removing Team: Tennis Team");
+    club.removeTeam(t1);
+    std::cout << "Current Teams after removal:\n";
+    for (const auto& team : club.getTeams()) {
+        std::cout << "Sport Type: " << team->getSportType() << ", ID: " << team->getId() << '\n';
+    }
+
+    printDivider("Canceling Event: Tennis Tournament");
+    club.cancelEvent(e1);
+    std::cout << "Current Events after cancellation:\n";
+    for (const auto& event : club.getEvents()) {
+        std::cout << "Event Name: " << event->getName() << ", Date: " << event->getDate() << ", Location: " << event->getLocation() << '\n';
+    }
+
+
+    delete m2;
+    delete m3;
+    delete c2;
+    delete t1;
+    delete t2;
+    delete e2;
+}
+
+
+
+
+
+int main() {
+    testMember();
+    testCoach();
+    testTeam();
+    testEvent();
+    testClub();
+    testDeleteClub();
+    testEventScheduleConflict();
+    testDate();
+    testVenueCalendar();
+    testSeasonScheduler();
+    testCoachWorkload();
+    testTeamMergeSplit();
+    testEmplace();
+    testRosterBitmap();
+    testCoParticipationGraph();
+    testRosterPartitioner();
+    testTournament();
+    testAttendance();
+    testQueryCache();
+    testFuzzyNameSearch();
+    testTextSearch();
+    testScanCursors();
+    testEntityStore();
+    testMemoryCompaction();
+    testBulkRemoval();
+    testWorkload();
+    testClubServer();
+    testAsyncBulk();
+    testMemberStore();
+    testArchive();
+    testEligibility();
+    testEventNameIndex();
+    testRemoveMember();
+    testRemoveCoach();
+
+
+
+   testClubFunctionality();
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,291 @@
+#include "TextSearch.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+namespace {
+    // BM25 parameters
+    const double K1 = 1.2;
+    const double B = 0.75;
+}
+
+// Constructor for an empty index
+InvertedIndex::InvertedIndex() : live_count(0), dead_count(0), total_length(0) {}
+
+// Split text into lowercase alphanumeric tokens
+std::vector<std::string> InvertedIndex::tokenize(const std::string& text) {
+    std::vector<std::string> tokens;
+    std::string current;
+    for (unsigned char c : text) {
+        if (std::isalnum(c)) {
+            current.push_back(static_cast<char>(std::tolower(c)));
+        }
+        else if (!current.empty()) {
+            tokens.push_back(std::move(current));
+            current.clear();
+        }
+    }
+    if (!current.empty()) {
+        tokens.push_back(std::move(current));
+    }
+    return tokens;
+}
+
+// Index a document made of weighted fields and return its id
+std::uint32_t InvertedIndex::add(const std::vector<TextField>& fields) {
+    const auto doc = static_cast<std::uint32_t>(lengths.size());
+    std::unordered_map<std::string, std::uint32_t> frequencies;
+    std::uint32_t length = 0;
+    for (const auto& field : fields) {
+        const auto weight = static_cast<std::uint32_t>(std::max(field.weight, 1));
+        for (auto& token : tokenize(field.text)) {
+            frequencies[std::move(token)] += weight;
+            length += weight;
+        }
+    }
+    for (auto& entry : frequencies) {
+        postings[entry.first].push_back({ doc, entry.second });
+    }
+    lengths.push_back(length);
+    live.push_back(true);
+    ++live_count;
+    total_length += length;
+    return doc;
+}
+
+// Remove a document; its postings are dropped at the next purge
+void InvertedIndex::remove(std::uint32_t doc) {
+    if (doc >= live.size() || !live[doc]) {
+        return;
+    }
+    live[doc] = false;
+    --live_count;
+    ++dead_count;
+    total_length -= lengths[doc];
+    if (dead_count > live_count + 1024) {
+        purge();
+    }
+}
+
+// Drop the postings of removed documents
+void InvertedIndex::purge() {
+    for (auto it = postings.begin(); it != postings.end();) {
+        auto& list = it->second;
+        list.erase(std::remove_if(list.begin(), list.end(), [this](const Posting& posting) {
+            return !live[posting.doc];
+            }), list.end());
+        if (list.empty()) {
+            it = postings.erase(it);
+        }
+        else {
+            list.shrink_to_fit();
+            ++it;
+        }
+    }
+    dead_count = 0;
+}
+
+// Get up to limit documents ranked by BM25 against the query, best first
+// With match_all only documents containing every query term are returned
+std::vector<std::pair<std::uint32_t, double>> InvertedIndex::search(const std::string& query, size_t limit, bool match_all) const {
+    std::vector<std::pair<std::uint32_t, double>> result;
+    std::vector<std::string> terms = tokenize(query);
+    std::sort(terms.begin(), terms.end());
+    terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+    if (terms.empty() || limit == 0 || live_count == 0) {
+        return result;
+    }
+
+    const double documents = static_cast<double>(live_count);
+    const double average_length = std::max(total_length / documents, 1.0);
+    std::vector<const std::vector<Posting>*> lists;
+    std::vector<double> idfs;
+    for (const auto& term : terms) {
+        auto it = postings.find(term);
+        if (it == postings.end()) {
+            if (match_all) {
+                return result;
+            }
+            continue;
+        }
+        // Tombstoned postings still count towards df until the next purge
+        const double df = static_cast<double>(it->second.size());
+        lists.push_back(&it->second);
+        idfs.push_back(std::log(1.0 + (documents - df + 0.5) / (df + 0.5)));
+    }
+    if (lists.empty()) {
+        return result;
+    }
+
+    auto contribution = [&](size_t term, const Posting& posting) {
+        const double frequency = posting.frequency;
+        const double norm = K1 * (1.0 - B + B * lengths[posting.doc] / average_length);
+        return idfs[term] * frequency * (K1 + 1.0) / (frequency + norm);
+    };
+    // Move a cursor to the first posting at or after doc, galloping then bisecting
+    auto seek = [&lists](size_t term, size_t& position, std::uint32_t doc) {
+        const auto& list = *lists[term];
+        size_t step = 1;
+        size_t high = position;
+        while (high < list.size() && list[high].doc < doc) {
+            position = high;
+            high += step;
+            step *= 2;
+        }
+        position = static_cast<size_t>(std::lower_bound(list.begin() + position, list.begin() + std::min(high, list.size()), doc,
+            [](const Posting& posting, std::uint32_t value) {
+                return posting.doc < value;
+            }) - list.begin());
+    };
+
+    // Min-heap of the best results so far
+    using Scored = std::pair<double, std::uint32_t>;
+    std::priority_queue<Scored, std::vector<Scored>, std::greater<Scored>> best;
+    auto offer = [&best, limit](std::uint32_t doc, double score) {
+        if (best.size() < limit) {
+            best.push({ score, doc });
+        }
+        else if (score > best.top().first) {
+            best.pop();
+            best.push({ score, doc });
+        }
+    };
+
+    const size_t term_count = lists.size();
+    std::vector<size_t> positions(term_count, 0);
+    if (match_all) {
+        // Walk the rarest list and probe the others
+        std::vector<size_t> order(term_count);
+        for (size_t i = 0; i < term_count; ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&lists](size_t a, size_t b) {
+            return lists[a]->size() < lists[b]->size();
+            });
+        const auto& driver = *lists[order[0]];
+        for (const auto& posting : driver) {
+            if (!live[posting.doc]) {
+                continue;
+            }
+            double score = contribution(order[0], posting);
+            bool everywhere = true;
+            for (size_t i = 1; i < term_count && everywhere; ++i) {
+                const size_t term = order[i];
+                seek(term, positions[term], posting.doc);
+                const auto& list = *lists[term];
+                everywhere = positions[term] < list.size() && list[positions[term]].doc == posting.doc;
+                if (everywhere) {
+                    score += contribution(term, list[positions[term]]);
+                }
+            }
+            if (everywhere) {
+                offer(posting.doc, score);
+            }
+        }
+    }
+    else {
+        // MaxScore: terms sorted by upper bound; the low ones are "non-essential" once their
+        // combined bound cannot beat the current k-th score, and are only probed
+        std::vector<size_t> order(term_count);
+        std::vector<double> bounds(term_count);
+        for (size_t i = 0; i < term_count; ++i) {
+            order[i] = i;
+            bounds[i] = idfs[i] * (K1 + 1.0);
+        }
+        std::sort(order.begin(), order.end(), [&bounds](size_t a, size_t b) {
+            return bounds[a] < bounds[b];
+            });
+        std::vector<double> prefix_bound(term_count);
+        for (size_t i = 0; i < term_count; ++i) {
+            prefix_bound[i] = bounds[order[i]] + (i > 0 ? prefix_bound[i - 1] : 0.0);
+        }
+
+        size_t first_essential = 0;
+        double threshold = -1.0;
+        while (true) {
+            std::uint32_t doc = UINT32_MAX;
+            for (size_t i = first_essential; i < term_count; ++i) {
+                const size_t term = order[i];
+                if (positions[term] < lists[term]->size()) {
+                    doc = std::min(doc, (*lists[term])[positions[term]].doc);
+                }
+            }
+            if (doc == UINT32_MAX) {
+                break;
+            }
+
+            double score = 0;
+            for (size_t i = first_essential; i < term_count; ++i) {
+                const size_t term = order[i];
+                const auto& list = *lists[term];
+                if (positions[term] < list.size() && list[positions[term]].doc == doc) {
+                    score += contribution(term, list[positions[term]]);
+                    ++positions[term];
+                }
+            }
+            if (!live[doc]) {
+                continue;
+            }
+            for (size_t i = first_essential; i-- > 0;) {
+                if (score + prefix_bound[i] <= threshold) {
+                    break;
+                }
+                const size_t term = order[i];
+                seek(term, positions[term], doc);
+                const auto& list = *lists[term];
+                if (positions[term] < list.size() && list[positions[term]].doc == doc) {
+                    score += contribution(term, list[positions[term]]);
+                }
+            }
+
+            offer(doc, score);
+            if (best.size() == limit) {
+                threshold = best.top().first;
+                while (first_essential < term_count && prefix_bound[first_essential] <= threshold) {
+                    ++first_essential;
+                }
+            }
+        }
+    }
+
+    result.resize(best.size());
+    for (size_t i = result.size(); i-- > 0;) {
+        result[i] = { best.top().second, best.top().first };
+        best.pop();
+    }
+    return result;
+}
+
+// Get the number of live documents
+size_t InvertedIndex::size() const {
+    return live_count;
+}
+
+// Get the number of distinct indexed terms
+size_t InvertedIndex::termCount() const {
+    return postings.size();
+}
+
+// Get the approximate heap memory used by the index in bytes
+size_t InvertedIndex::memoryUsage() const {
+    size_t total = lengths.capacity() * sizeof(std::uint32_t) + live.capacity() / 8;
+    total += postings.bucket_count() * sizeof(void*);
+    for (const auto& entry : postings) {
+        total += sizeof(entry) + 2 * sizeof(void*) + entry.second.capacity() * sizeof(Posting);
+        total += entry.first.capacity() > 15 ? entry.first.capacity() + 1 : 0;
+    }
+    return total;
+}
+
+// Drop the postings of removed documents now and release spare capacity
+void InvertedIndex::shrinkToFit() {
+    if (dead_count > 0) {
+        purge();
+    }
+    for (auto& entry : postings) {
+        entry.second.shrink_to_fit();
+    }
+    postings.rehash(0);
+}
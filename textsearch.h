@@ -0,0 +1,116 @@
+#ifndef TEXTSEARCH_H
+#define TEXTSEARCH_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// A piece of text to index and how much a match in it counts
+struct TextField {
+    std::string text;
+    int weight;
+};
+
+// Tokenized inverted index with BM25 ranking
+// Text is split into lowercase alphanumeric tokens. Documents get increasing ids, so
+// every posting list is sorted by document and appending is O(tokens). Removal leaves
+// a tombstone that queries skip; lists are rebuilt once tombstones outnumber live
+// documents. Queries walk the lists document-at-a-time with MaxScore pruning: once
+// k results are known, terms whose best possible contribution cannot lift a document
+// into the top k are only probed for documents found through the other terms.
+class InvertedIndex {
+private:
+    struct Posting {
+        std::uint32_t doc;
+        std::uint32_t frequency;  // field-weighted term count
+    };
+
+    std::unordered_map<std::string, std::vector<Posting>> postings;
+    std::vector<std::uint32_t> lengths;  // field-weighted token count per document
+    std::vector<bool> live;
+    size_t live_count;
+    size_t dead_count;
+    double total_length;
+
+    void purge();
+
+public:
+    InvertedIndex();
+
+    static std::vector<std::string> tokenize(const std::string& text);
+
+    std::uint32_t add(const std::vector<TextField>& fields);
+    void remove(std::uint32_t doc);
+    std::vector<std::pair<std::uint32_t, double>> search(const std::string& query, size_t limit, bool match_all) const;
+    size_t size() const;
+    size_t termCount() const;
+    size_t memoryUsage() const;
+    void shrinkToFit();
+};
+
+// A text search hit and its relevance score
+template <typename T>
+struct TextMatch {
+    T* item;
+    double score;
+};
+
+// Typed front end of InvertedIndex keeping the document of each object
+template <typename T>
+class TextSearchIndex {
+private:
+    InvertedIndex index;
+    std::vector<T*> items;  // document -> object, null once removed
+    std::unordered_map<const T*, std::uint32_t> doc_of;
+
+public:
+    // Index an object under the given fields, replacing any earlier entry for it
+    void add(T* item, const std::vector<TextField>& fields) {
+        remove(item);
+        const std::uint32_t doc = index.add(fields);
+        if (doc >= items.size()) {
+            items.resize(doc + 1, nullptr);
+        }
+        items[doc] = item;
+        doc_of[item] = doc;
+    }
+
+    // Stop indexing an object
+    void remove(const T* item) {
+        auto it = doc_of.find(item);
+        if (it == doc_of.end()) {
+            return;
+        }
+        index.remove(it->second);
+        items[it->second] = nullptr;
+        doc_of.erase(it);
+    }
+
+    // Get up to limit objects ranked by relevance to the query, best first
+    std::vector<TextMatch<T>> search(const std::string& query, size_t limit, bool match_all) const {
+        std::vector<TextMatch<T>> result;
+        for (const auto& hit : index.search(query, limit, match_all)) {
+            result.push_back({ items[hit.first], hit.second });
+        }
+        return result;
+    }
+
+    size_t size() const {
+        return doc_of.size();
+    }
+
+    // Get the approximate heap memory used by the index in bytes
+    size_t memoryUsage() const {
+        return index.memoryUsage() + items.capacity() * sizeof(T*) + doc_of.bucket_count() * sizeof(void*) +
+               doc_of.size() * (sizeof(std::pair<const T* const, std::uint32_t>) + sizeof(void*));
+    }
+
+    void shrinkToFit() {
+        index.shrinkToFit();
+        doc_of.rehash(0);
+    }
+};
+
+#endif // TEXTSEARCH_H
@@ -0,0 +1,320 @@
+#include "Tournament.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    std::string teamLabel(const Team* team) {
+        return "Team " + std::to_string(team->getId());
+    }
+
+    // Seed positions of a bracket of the given power-of-two size, 1 v n, 2 v n-1, ...
+    // with the top two seeds in opposite halves
+    std::vector<size_t> bracketOrder(size_t size) {
+        std::vector<size_t> order = { 0 };
+        while (order.size() < size) {
+            const size_t doubled = order.size() * 2;
+            std::vector<size_t> next;
+            next.reserve(doubled);
+            for (size_t seed : order) {
+                next.push_back(seed);
+                next.push_back(doubled - 1 - seed);
+            }
+            order.swap(next);
+        }
+        return order;
+    }
+
+    template <typename T>
+    void appendUnique(std::vector<T>& into, const std::vector<T>& from) {
+        into.insert(into.end(), from.begin(), from.end());
+        std::sort(into.begin(), into.end());
+        into.erase(std::unique(into.begin(), into.end()), into.end());
+    }
+}
+
+// Constructor to bind the generator to an event and its teams
+// Throws an exception if the event is null or the group settings are invalid
+TournamentGenerator::TournamentGenerator(Event* event, const TournamentOptions& options)
+    : event(event), options(options) {
+    if (event == nullptr) {
+        throw std::invalid_argument("Event pointer is null");
+    }
+    if (options.group_count <= 0) {
+        throw std::invalid_argument("Group count must be positive");
+    }
+    if (options.advance_per_group < 0) {
+        throw std::invalid_argument("Teams advancing per group cannot be negative");
+    }
+}
+
+// Make a source for a side that is already known
+TournamentGenerator::Source TournamentGenerator::known(Team* team) {
+    if (team == nullptr) {
+        return { Source::Kind::Bye, nullptr, 0, {}, {}, "Bye" };
+    }
+    return { Source::Kind::Known, team, 0, { team }, {}, teamLabel(team) };
+}
+
+// Make a source for the winner or loser of a match
+TournamentGenerator::Source TournamentGenerator::fromMatch(size_t match, bool winner) const {
+    const Match& played = matches[match];
+    return { winner ? Source::Kind::Winner : Source::Kind::Loser, nullptr, match, played.candidates, { match },
+             (winner ? "Winner of " : "Loser of ") + played.name };
+}
+
+// Every team meets every other once (twice home and away), using the circle method
+void TournamentGenerator::roundRobin(const std::vector<Team*>& teams, const std::string& prefix, int first_round) {
+    if (teams.size() < 2) {
+        return;
+    }
+    std::vector<Team*> circle = teams;
+    if (circle.size() % 2 != 0) {
+        circle.push_back(nullptr);  // the team drawn against it rests that round
+    }
+    const size_t size = circle.size();
+    const int rounds = static_cast<int>(size) - 1;
+    const int legs = options.home_and_away ? 2 : 1;
+    std::vector<std::vector<std::pair<Team*, Team*>>> pairings(rounds);
+    for (int round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < size / 2; ++i) {
+            Team* home = circle[i];
+            Team* away = circle[size - 1 - i];
+            if (home == nullptr || away == nullptr) {
+                continue;
+            }
+            if (i == 0 && round % 2 == 1) {
+                std::swap(home, away);  // the fixed team alternates home and away
+            }
+            pairings[round].push_back({ home, away });
+        }
+        std::rotate(circle.begin() + 1, circle.end() - 1, circle.end());
+    }
+
+    for (int leg = 0; leg < legs; ++leg) {
+        for (int round = 0; round < rounds; ++round) {
+            const int number = first_round + leg * rounds + round;
+            int count = 0;
+            for (auto pairing : pairings[round]) {
+                if (leg == 1) {
+                    std::swap(pairing.first, pairing.second);
+                }
+                matches.push_back({ prefix + " R" + std::to_string(number) + " M" + std::to_string(++count), number,
+                                    pairing.first, pairing.second, teamLabel(pairing.first), teamLabel(pairing.second),
+                                    {}, { pairing.first, pairing.second }, nullptr });
+            }
+        }
+    }
+}
+
+// Create the match between two sides, or pass a side straight through against a bye
+// Returns the winner and loser sources
+std::pair<TournamentGenerator::Source, TournamentGenerator::Source> TournamentGenerator::play(
+    const Source& home, const Source& away, const std::string& name, int round) {
+    const Source bye = known(nullptr);
+    if (home.kind == Source::Kind::Bye) {
+        return { away, bye };
+    }
+    if (away.kind == Source::Kind::Bye) {
+        return { home, bye };
+    }
+    Match match = { name, round,
+                    home.kind == Source::Kind::Known ? home.team : nullptr,
+                    away.kind == Source::Kind::Known ? away.team : nullptr,
+                    home.label, away.label, home.after, home.candidates, nullptr };
+    appendUnique(match.after, away.after);
+    appendUnique(match.candidates, away.candidates);
+    matches.push_back(std::move(match));
+    return { fromMatch(matches.size() - 1, true), fromMatch(matches.size() - 1, false) };
+}
+
+// Single-elimination bracket over the seeds, byes going to the top seeds
+// Records the losers of each round when asked, for a losers bracket
+// Returns the source of the champion
+TournamentGenerator::Source TournamentGenerator::knockout(std::vector<Source> seeds, const std::string& prefix, int first_round,
+                                                          std::vector<std::vector<Source>>* losers_by_round) {
+    if (seeds.empty()) {
+        return known(nullptr);
+    }
+    size_t size = 1;
+    while (size < seeds.size()) {
+        size *= 2;
+    }
+    seeds.resize(size, known(nullptr));
+
+    std::vector<Source> current;
+    current.reserve(size);
+    for (size_t position : bracketOrder(size)) {
+        current.push_back(seeds[position]);
+    }
+    for (int round = first_round; current.size() > 1; ++round) {
+        std::vector<Source> next;
+        std::vector<Source> losers;
+        int count = 0;
+        for (size_t i = 0; i + 1 < current.size(); i += 2) {
+            const std::string name = prefix + " R" + std::to_string(round) + " M" + std::to_string(count + 1);
+            const size_t before = matches.size();
+            auto result = play(current[i], current[i + 1], name, round);
+            count += matches.size() > before;
+            next.push_back(std::move(result.first));
+            losers.push_back(std::move(result.second));
+        }
+        if (losers_by_round != nullptr) {
+            losers_by_round->push_back(std::move(losers));
+        }
+        current.swap(next);
+    }
+    return current.front();
+}
+
+// Winners bracket, a losers bracket fed by each winners round, and a grand final
+void TournamentGenerator::doubleElimination(const std::vector<Source>& seeds) {
+    const std::string prefix = event->getName();
+    std::vector<std::vector<Source>> dropped;
+    const Source champion = knockout(seeds, prefix + " WB", 1, &dropped);
+    if (dropped.empty()) {
+        return;
+    }
+
+    int round = 1;
+    auto losersRound = [this, &prefix, &round](const std::vector<Source>& home, const std::vector<Source>& away) {
+        std::vector<Source> winners;
+        int count = 0;
+        for (size_t i = 0; i < home.size(); ++i) {
+            const std::string name = prefix + " LB R" + std::to_string(round) + " M" + std::to_string(count + 1);
+            const size_t before = matches.size();
+            winners.push_back(play(home[i], away[i], name, round).first);
+            count += matches.size() > before;
+        }
+        ++round;
+        return winners;
+    };
+
+    // Round 1 pairs the first-round losers; after that, losers bracket winners meet the next
+    // batch dropping down (in reverse order on alternate rounds to avoid early rematches),
+    // then play each other
+    std::vector<Source> alive = dropped[0];
+    if (alive.size() > 1) {
+        std::vector<Source> home, away;
+        for (size_t i = 0; i + 1 < alive.size(); i += 2) {
+            home.push_back(alive[i]);
+            away.push_back(alive[i + 1]);
+        }
+        alive = losersRound(home, away);
+    }
+    for (size_t wb_round = 1; wb_round < dropped.size(); ++wb_round) {
+        std::vector<Source> incoming = dropped[wb_round];
+        if (wb_round % 2 == 1) {
+            std::reverse(incoming.begin(), incoming.end());
+        }
+        alive = losersRound(alive, incoming);
+        if (alive.size() > 1) {
+            std::vector<Source> home, away;
+            for (size_t i = 0; i + 1 < alive.size(); i += 2) {
+                home.push_back(alive[i]);
+                away.push_back(alive[i + 1]);
+            }
+            alive = losersRound(home, away);
+        }
+    }
+    play(champion, alive.front(), prefix + " Grand Final",
+         std::max(static_cast<int>(dropped.size()), round - 1) + 1);
+}
+
+// Build the match list for the event's teams in the configured format
+const std::vector<Match>& TournamentGenerator::generate() {
+    matches.clear();
+    const std::vector<Team*> teams = event->getTeams();
+    const std::string prefix = event->getName();
+    std::vector<Source> seeds;
+    for (auto team : teams) {
+        seeds.push_back(known(team));
+    }
+
+    switch (options.format) {
+    case TournamentFormat::RoundRobin:
+        roundRobin(teams, prefix, 1);
+        break;
+    case TournamentFormat::SingleElimination:
+        knockout(seeds, prefix, 1, nullptr);
+        break;
+    case TournamentFormat::DoubleElimination:
+        doubleElimination(seeds);
+        break;
+    case TournamentFormat::GroupStage: {
+        // Snake seeding spreads the top seeds over the groups
+        const size_t group_count = std::min(static_cast<size_t>(options.group_count), std::max<size_t>(teams.size(), 1));
+        std::vector<std::vector<Team*>> groups(group_count);
+        for (size_t i = 0; i < teams.size(); ++i) {
+            const size_t pass = i / group_count;
+            const size_t position = i % group_count;
+            groups[pass % 2 == 0 ? position : group_count - 1 - position].push_back(teams[i]);
+        }
+        std::vector<std::vector<size_t>> group_matches(group_count);
+        for (size_t g = 0; g < group_count; ++g) {
+            const size_t first = matches.size();
+            roundRobin(groups[g], prefix + " Group " + std::to_string(g + 1), 1);
+            for (size_t m = first; m < matches.size(); ++m) {
+                group_matches[g].push_back(m);
+            }
+        }
+
+        // Knockout seeds: group winners first, then runners-up, and so on
+        std::vector<Source> qualified;
+        for (int rank = 1; rank <= options.advance_per_group; ++rank) {
+            for (size_t g = 0; g < group_count; ++g) {
+                if (static_cast<size_t>(rank) <= groups[g].size()) {
+                    qualified.push_back({ Source::Kind::Standing, nullptr, 0, groups[g], group_matches[g],
+                                          "Group " + std::to_string(g + 1) + " #" + std::to_string(rank) });
+                }
+            }
+        }
+        if (qualified.size() > 1) {
+            knockout(qualified, prefix + " Knockout", 1, nullptr);
+        }
+        break;
+    }
+    }
+    return matches;
+}
+
+// Queue every match on the scheduler in dependency order and place them
+// Knockout matches reserve all their candidate teams so nobody can be double-booked
+// whichever way earlier results go; the matches' events are filled in
+// The events are built and joined through the club, which owns them from then on
+// Returns the events of the placed matches
+std::vector<Event*> TournamentGenerator::schedule(SeasonScheduler& scheduler) {
+    if (matches.empty()) {
+        generate();
+    }
+    std::vector<size_t> fixture_of(matches.size());
+    for (size_t i = 0; i < matches.size(); ++i) {
+        const Match& match = matches[i];
+        std::vector<Team*> playing;
+        for (auto team : { match.home, match.away }) {
+            if (team != nullptr) {
+                playing.push_back(team);
+            }
+        }
+        std::vector<size_t> after;
+        for (size_t dependency : match.after) {
+            after.push_back(fixture_of[dependency]);
+        }
+        fixture_of[i] = scheduler.addFixture(match.name, playing, match.candidates, after);
+    }
+
+    scheduler.schedule();
+    const std::vector<Event*> placements = scheduler.getPlacements();
+    std::vector<Event*> placed;
+    for (size_t i = 0; i < matches.size(); ++i) {
+        matches[i].event = placements[fixture_of[i]];
+        if (matches[i].event != nullptr) {
+            placed.push_back(matches[i].event);
+        }
+    }
+    return placed;
+}
+
+// Get the matches of the last generate() call
+const std::vector<Match>& TournamentGenerator::getMatches() const {
+    return matches;
+}
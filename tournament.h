@@ -0,0 +1,75 @@
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include <string>
+#include <vector>
+#include "Club.h"
+#include "Scheduler.h"
+
+enum class TournamentFormat {
+    RoundRobin,
+    SingleElimination,
+    DoubleElimination,
+    GroupStage
+};
+
+// How a tournament is laid out
+struct TournamentOptions {
+    TournamentFormat format = TournamentFormat::RoundRobin;
+    bool home_and_away = false;  // round robin: every pairing is played twice
+    int group_count = 4;         // group stage: number of groups
+    int advance_per_group = 2;   // group stage: teams per group going to the knockout, 0 for none
+};
+
+// One match of a tournament
+// Teams are null while the side depends on an earlier result; the source then says which
+struct Match {
+    std::string name;
+    int round;
+    Team* home;
+    Team* away;
+    std::string home_source;
+    std::string away_source;
+    std::vector<size_t> after;       // matches that must be played first
+    std::vector<Team*> candidates;   // every team that could play in this match
+    Event* event;                    // set once the match is scheduled
+};
+
+// Turns the teams attached to an event into a list of matches
+// Teams are seeded in the order they were added to the event. Knockout brackets are
+// padded to a power of two with byes given to the top seeds; a side decided by an
+// earlier match is tracked as a source, so generation is linear in the number of
+// matches (n log n counting the candidate lists of later knockout rounds).
+class TournamentGenerator {
+private:
+    struct Source {
+        enum class Kind { Bye, Known, Winner, Loser, Standing };
+        Kind kind;
+        Team* team;
+        size_t match;
+        std::vector<Team*> candidates;
+        std::vector<size_t> after;
+        std::string label;
+    };
+
+    Event* event;
+    TournamentOptions options;
+    std::vector<Match> matches;
+
+    static Source known(Team* team);
+    Source fromMatch(size_t match, bool winner) const;
+    void roundRobin(const std::vector<Team*>& teams, const std::string& prefix, int first_round);
+    std::pair<Source, Source> play(const Source& home, const Source& away, const std::string& name, int round);
+    Source knockout(std::vector<Source> seeds, const std::string& prefix, int first_round,
+                    std::vector<std::vector<Source>>* losers_by_round);
+    void doubleElimination(const std::vector<Source>& seeds);
+
+public:
+    TournamentGenerator(Event* event, const TournamentOptions& options);
+
+    const std::vector<Match>& generate();
+    std::vector<Event*> schedule(SeasonScheduler& scheduler);
+    const std::vector<Match>& getMatches() const;
+};
+
+#endif // TOURNAMENT_H
@@ -0,0 +1,462 @@
+#include "Workload.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    const int SEASON_DAYS = 365;
+    const int FIRST_START = 8 * 60;       // events and checks start between 08:00
+    const int START_WINDOW = 12 * 60;     // and 20:00
+    const int EVENT_MINUTES = 90;
+    const int CHECK_MINUTES = 60;
+    const char* const SPORTS[] = { "Football", "Basketball", "Tennis", "Swimming", "Athletics", "Volleyball" };
+    const char* const ROLES[] = { "Athlete", "Captain", "Reserve" };
+
+    // Draws from the raw generator only: the standard distributions are not specified
+    // bit-for-bit, so they would make streams differ between standard libraries
+    size_t uniform(std::mt19937_64& rng, size_t n) {
+        return static_cast<size_t>(rng() % n);
+    }
+
+    double unit(std::mt19937_64& rng) {
+        return static_cast<double>(rng() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Cumulative Zipf weights over n ranks; exponent 0 is uniform
+    std::vector<double> zipfTable(size_t n, double exponent) {
+        std::vector<double> cumulative(n);
+        double total = 0;
+        for (size_t i = 0; i < n; ++i) {
+            total += 1.0 / std::pow(static_cast<double>(i + 1), exponent);
+            cumulative[i] = total;
+        }
+        for (auto& weight : cumulative) {
+            weight /= total;
+        }
+        return cumulative;
+    }
+
+    size_t zipf(std::mt19937_64& rng, const std::vector<double>& cumulative) {
+        const auto it = std::lower_bound(cumulative.begin(), cumulative.end(), unit(rng));
+        return std::min(static_cast<size_t>(it - cumulative.begin()), cumulative.size() - 1);
+    }
+
+    // Independent, reproducible seed for each stream
+    std::uint64_t streamSeed(std::uint64_t seed, size_t stream) {
+        std::uint64_t z = seed + 0x9E3779B97F4A7C15ull * (stream + 1);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    std::uint64_t mix(std::uint64_t digest, std::uint64_t value) {
+        return (digest ^ value) * 0x100000001B3ull;
+    }
+
+    std::string eventName(size_t index) {
+        return "Event " + std::to_string(index);
+    }
+
+    std::string venueName(size_t index) {
+        return "Venue " + std::to_string(index);
+    }
+
+    std::string memberName(int id) {
+        return "Member " + std::to_string(id);
+    }
+
+    // Nearest-rank percentile of sorted samples
+    double percentile(const std::vector<double>& sorted, double fraction) {
+        if (sorted.empty()) {
+            return 0;
+        }
+        const size_t rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+        return sorted[std::max<size_t>(rank, 1) - 1];
+    }
+
+    OperationKind kindFromName(const std::string& name) {
+        for (size_t i = 0; i < OPERATION_KINDS; ++i) {
+            const auto kind = static_cast<OperationKind>(i);
+            if (name == WorkloadDriver::kindName(kind)) {
+                return kind;
+            }
+        }
+        throw std::invalid_argument("Unknown workload operation: " + name);
+    }
+
+    // Check a config before anything is built from it
+    void validate(const WorkloadConfig& config) {
+        if (config.threads == 0) {
+            throw std::invalid_argument("Workload needs at least one thread");
+        }
+        if (config.venues == 0) {
+            throw std::invalid_argument("Workload needs at least one venue");
+        }
+        if (config.roster_skew < 0) {
+            throw std::invalid_argument("Roster skew cannot be negative");
+        }
+        if (config.members > 1000000000) {
+            throw std::invalid_argument("Workload member count is too large");
+        }
+        unsigned total = 0;
+        for (auto weight : config.mix) {
+            total += weight;
+        }
+        if (total == 0) {
+            throw std::invalid_argument("Workload mix needs at least one non-zero weight");
+        }
+    }
+
+    // Latencies and result digest of one stream
+    struct StreamResult {
+        std::array<std::vector<double>, OPERATION_KINDS> latencies;
+        double seconds = 0;
+        std::uint64_t digest = 0xCBF29CE484222325ull;
+    };
+
+    // Replay one stream against a freshly populated club
+    // Arguments are turned into the strings and pointers the club API takes before the
+    // clock starts, so the figures are the club's own cost
+    void runStream(const WorkloadConfig& config, const std::vector<Operation>& stream, size_t index,
+                   std::atomic<size_t>& ready, StreamResult& result) {
+        Club club("Workload shard " + std::to_string(index));
+        WorkloadDriver::populate(club, config);
+        const Date season = Date::fromCivil(2024, 1, 1);
+        for (auto& samples : result.latencies) {
+            samples.reserve(stream.size() / 2);
+        }
+
+        ++ready;
+        while (ready.load() < config.threads) {
+            std::this_thread::yield();
+        }
+
+        const auto begin = Clock::now();
+        for (const auto& operation : stream) {
+            std::uint64_t outcome = 0;
+            Clock::time_point start;
+            switch (operation.kind) {
+            case OperationKind::FindMember: {
+                start = Clock::now();
+                Member* member = club.findMemberById(operation.member);
+                outcome = member != nullptr ? static_cast<std::uint64_t>(member->getAge()) + 1 : 0;
+                break;
+            }
+            case OperationKind::AddMember: {
+                std::string name = memberName(operation.member);
+                start = Clock::now();
+                outcome = club.emplaceMember(std::move(name), 16 + operation.member % 40, ROLES[0], operation.member)
+                              ->getId();
+                break;
+            }
+            case OperationKind::RemoveMember: {
+                start = Clock::now();
+                Member* member = club.findMemberById(operation.member);
+                outcome = member != nullptr ? club.removeMembers({ member }) : 0;
+                break;
+            }
+            case OperationKind::SignUp: {
+                const std::string name = eventName(static_cast<size_t>(operation.target));
+                start = Clock::now();
+                Member* member = club.findMemberById(operation.member);
+                if (member != nullptr) {
+                    club.addMembersToEvent(name, { member });
+                    outcome = 1;
+                }
+                break;
+            }
+            case OperationKind::ScheduleCheck: {
+                const std::string venue = venueName(static_cast<size_t>(operation.target));
+                const int day = operation.minute / DateTime::MINUTES_PER_DAY;
+                const int minute = operation.minute % DateTime::MINUTES_PER_DAY;
+                const std::string date = season.addDays(day).toString();
+                const std::string from = DateTime::formatTime(minute);
+                const std::string to = DateTime::formatTime(minute + CHECK_MINUTES);
+                start = Clock::now();
+                outcome = club.hasScheduleConflict(venue, date, from, to) ? 1 : 0;
+                break;
+            }
+            }
+            const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            result.latencies[static_cast<size_t>(operation.kind)].push_back(ns);
+            result.digest = mix(result.digest, outcome);
+        }
+        result.seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    }
+}
+
+// Get the name an operation kind is recorded and reported under
+const char* WorkloadDriver::kindName(OperationKind kind) {
+    switch (kind) {
+    case OperationKind::FindMember:
+        return "find";
+    case OperationKind::AddMember:
+        return "add";
+    case OperationKind::RemoveMember:
+        return "remove";
+    case OperationKind::SignUp:
+        return "signup";
+    case OperationKind::ScheduleCheck:
+        return "schedule";
+    }
+    return "unknown";
+}
+
+// Fill a club with the synthetic coaches, members, teams and events of a config
+// Members join one team each and events draw one team each, both by a Zipf law over
+// team rank, so a few teams and their events dominate as in real clubs
+// Throws an exception if the config is invalid
+void WorkloadDriver::populate(Club& club, const WorkloadConfig& config) {
+    validate(config);
+    std::mt19937_64 rng(config.seed);
+
+    std::vector<Coach*> coaches;
+    for (size_t i = 0; i < config.coaches; ++i) {
+        const int id = static_cast<int>(i) + 1;
+        coaches.push_back(club.emplaceCoach("Coach " + std::to_string(id), SPORTS[i % 6], id));
+    }
+
+    std::vector<Team*> teams;
+    for (size_t i = 0; i < config.teams; ++i) {
+        Coach* coach = coaches.empty() ? nullptr : coaches[i % coaches.size()];
+        teams.push_back(club.emplaceTeam(SPORTS[i % 6], coach, static_cast<int>(i) + 1));
+    }
+
+    const auto team_rank = zipfTable(config.teams, config.roster_skew);
+    for (size_t i = 0; i < config.members; ++i) {
+        const int id = static_cast<int>(i) + 1;
+        Member* member = club.emplaceMember(memberName(id), 16 + static_cast<int>(uniform(rng, 40)),
+                                            ROLES[uniform(rng, 3)], id);
+        if (!teams.empty()) {
+            teams[zipf(rng, team_rank)]->addMember(member);
+        }
+    }
+
+    const Date season = Date::fromCivil(2024, 1, 1);
+    for (size_t i = 0; i < config.events; ++i) {
+        const int start = FIRST_START + static_cast<int>(uniform(rng, START_WINDOW / 30)) * 30;
+        Event* event = club.emplaceEvent(season.addDays(static_cast<int>(uniform(rng, SEASON_DAYS))).toString(),
+                                         venueName(uniform(rng, config.venues)), eventName(i),
+                                         DateTime::formatTime(start), DateTime::formatTime(start + EVENT_MINUTES));
+        if (!teams.empty()) {
+            club.addTeamToEvent(event, teams[zipf(rng, team_rank)]);
+        }
+    }
+}
+
+// Generate one operation stream per thread for a config
+// Each stream tracks the members alive in its own club, so removals and sign-ups
+// mostly hit live members while lookups also probe ids that were never added
+// Throws an exception if the config is invalid
+Workload WorkloadDriver::generate(const WorkloadConfig& config) {
+    validate(config);
+    Workload workload;
+    workload.config = config;
+
+    unsigned total = 0;
+    for (auto weight : config.mix) {
+        total += weight;
+    }
+    const auto event_rank = zipfTable(config.events, config.roster_skew);
+
+    for (size_t thread = 0; thread < config.threads; ++thread) {
+        std::mt19937_64 rng(streamSeed(config.seed, thread));
+        std::vector<int> live;
+        for (size_t i = 0; i < config.members; ++i) {
+            live.push_back(static_cast<int>(i) + 1);
+        }
+        int next_id = static_cast<int>(config.members) + 1;
+
+        std::vector<Operation> stream;
+        stream.reserve(config.operations);
+        while (stream.size() < config.operations) {
+            size_t pick = uniform(rng, total);
+            size_t kind = 0;
+            while (pick >= config.mix[kind]) {
+                pick -= config.mix[kind++];
+            }
+            Operation operation{ static_cast<OperationKind>(kind), 0, 0, 0 };
+            if (live.empty() && (operation.kind == OperationKind::RemoveMember || operation.kind == OperationKind::SignUp)) {
+                operation.kind = OperationKind::AddMember;
+            }
+            if (operation.kind == OperationKind::SignUp && config.events == 0) {
+                operation.kind = OperationKind::FindMember;
+            }
+
+            switch (operation.kind) {
+            case OperationKind::FindMember:
+                operation.member = static_cast<int>(uniform(rng, static_cast<size_t>(next_id))) + 1;
+                break;
+            case OperationKind::AddMember:
+                operation.member = next_id++;
+                live.push_back(operation.member);
+                break;
+            case OperationKind::RemoveMember: {
+                const size_t slot = uniform(rng, live.size());
+                operation.member = live[slot];
+                live[slot] = live.back();
+                live.pop_back();
+                break;
+            }
+            case OperationKind::SignUp:
+                operation.member = live[uniform(rng, live.size())];
+                operation.target = static_cast<int>(zipf(rng, event_rank));
+                break;
+            case OperationKind::ScheduleCheck:
+                operation.target = static_cast<int>(uniform(rng, config.venues));
+                operation.minute = static_cast<int>(uniform(rng, SEASON_DAYS)) * DateTime::MINUTES_PER_DAY +
+                                   FIRST_START + static_cast<int>(uniform(rng, START_WINDOW));
+                break;
+            }
+            stream.push_back(operation);
+        }
+        workload.streams.push_back(std::move(stream));
+    }
+    return workload;
+}
+
+// Replay every stream on its own thread and club, and collect latency figures
+// Clubs are populated before the clock starts; all threads then start together
+// Throws an exception if the workload is invalid or an operation fails
+WorkloadReport WorkloadDriver::run(const Workload& workload) {
+    validate(workload.config);
+    if (workload.streams.size() != workload.config.threads) {
+        throw std::invalid_argument("Workload has a different number of streams than threads");
+    }
+
+    std::vector<StreamResult> results(workload.streams.size());
+    std::vector<std::exception_ptr> errors(workload.streams.size());
+    std::atomic<size_t> ready(0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < workload.streams.size(); ++i) {
+        threads.emplace_back([&workload, &results, &errors, &ready, i]() {
+            try {
+                runStream(workload.config, workload.streams[i], i, ready, results[i]);
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+                ready += workload.config.threads;  // release the others
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    WorkloadReport report{};
+    report.result_digest = 0xCBF29CE484222325ull;
+    for (size_t kind = 0; kind < OPERATION_KINDS; ++kind) {
+        std::vector<double> samples;
+        for (auto& result : results) {
+            samples.insert(samples.end(), result.latencies[kind].begin(), result.latencies[kind].end());
+        }
+        std::sort(samples.begin(), samples.end());
+        report.operations[kind] = { samples.size(), percentile(samples, 0.50), percentile(samples, 0.99),
+                                    percentile(samples, 0.999), samples.empty() ? 0 : samples.back() };
+        report.total_operations += samples.size();
+    }
+    for (const auto& result : results) {
+        report.seconds = std::max(report.seconds, result.seconds);
+        report.result_digest = mix(report.result_digest, result.digest);
+    }
+    report.throughput = report.seconds > 0 ? static_cast<double>(report.total_operations) / report.seconds : 0;
+    return report;
+}
+
+// Write a workload as text: a config line, then one line per operation under a
+// header for each stream
+void Workload::write(std::ostream& out) const {
+    out << "workload 1\n";
+    out << "config " << config.members << ' ' << config.coaches << ' ' << config.teams << ' ' << config.events << ' '
+        << config.venues << ' ' << std::setprecision(17) << config.roster_skew << ' ' << config.operations;
+    for (auto weight : config.mix) {
+        out << ' ' << weight;
+    }
+    out << ' ' << config.threads << ' ' << config.seed << '\n';
+    for (size_t i = 0; i < streams.size(); ++i) {
+        out << "stream " << i << ' ' << streams[i].size() << '\n';
+        for (const auto& operation : streams[i]) {
+            out << WorkloadDriver::kindName(operation.kind) << ' ' << operation.member << ' ' << operation.target << ' '
+                << operation.minute << '\n';
+        }
+    }
+}
+
+// Read a workload written by write()
+// Throws an exception if the text is malformed
+Workload Workload::read(std::istream& in) {
+    Workload workload;
+    WorkloadConfig& config = workload.config;
+    std::string word;
+    int version = 0;
+    if (!(in >> word >> version) || word != "workload" || version != 1) {
+        throw std::invalid_argument("Not a version 1 workload recording");
+    }
+    if (!(in >> word) || word != "config" ||
+        !(in >> config.members >> config.coaches >> config.teams >> config.events >> config.venues >>
+          config.roster_skew >> config.operations)) {
+        throw std::invalid_argument("Workload recording has a malformed config line");
+    }
+    for (auto& weight : config.mix) {
+        if (!(in >> weight)) {
+            throw std::invalid_argument("Workload recording has a malformed config line");
+        }
+    }
+    if (!(in >> config.threads >> config.seed)) {
+        throw std::invalid_argument("Workload recording has a malformed config line");
+    }
+    validate(config);
+
+    for (size_t i = 0; i < config.threads; ++i) {
+        size_t index = 0;
+        size_t count = 0;
+        if (!(in >> word >> index >> count) || word != "stream" || index != i) {
+            throw std::invalid_argument("Workload recording has a malformed stream header");
+        }
+        std::vector<Operation> stream;
+        stream.reserve(count);
+        for (size_t j = 0; j < count; ++j) {
+            Operation operation{};
+            if (!(in >> word >> operation.member >> operation.target >> operation.minute)) {
+                throw std::invalid_argument("Workload recording ends inside a stream");
+            }
+            operation.kind = kindFromName(word);
+            stream.push_back(operation);
+        }
+        workload.streams.push_back(std::move(stream));
+    }
+    return workload;
+}
+
+// Print a per-operation latency table and the totals
+void WorkloadReport::print(std::ostream& out) const {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(0);
+    text << std::left << std::setw(10) << "operation" << std::right << std::setw(10) << "count" << std::setw(12)
+         << "p50 ns" << std::setw(12) << "p99 ns" << std::setw(12) << "p999 ns" << std::setw(12) << "max ns" << '\n';
+    for (size_t kind = 0; kind < OPERATION_KINDS; ++kind) {
+        const auto& stats = operations[kind];
+        text << std::left << std::setw(10) << WorkloadDriver::kindName(static_cast<OperationKind>(kind)) << std::right
+             << std::setw(10) << stats.count << std::setw(12) << stats.p50 << std::setw(12) << stats.p99
+             << std::setw(12) << stats.p999 << std::setw(12) << stats.max << '\n';
+    }
+    text << total_operations << " operations in " << std::setprecision(3) << seconds << " s, " << std::setprecision(0)
+         << throughput << " ops/s, digest " << std::hex << result_digest << '\n';
+    out << text.str();
+}
@@ -0,0 +1,90 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "Club.h"
+
+// Operations a workload stream is made of
+enum class OperationKind {
+    FindMember,     // findMemberById
+    AddMember,      // emplaceMember
+    RemoveMember,   // removeMembers with one member
+    SignUp,         // addMembersToEvent with one member
+    ScheduleCheck   // hasScheduleConflict for a venue and time range
+};
+
+constexpr size_t OPERATION_KINDS = 5;
+
+// Shape of a synthetic club and of the operations run against it
+struct WorkloadConfig {
+    size_t members = 10000;
+    size_t coaches = 100;
+    size_t teams = 400;
+    size_t events = 1000;
+    size_t venues = 20;
+    double roster_skew = 1.0;  // Zipf exponent of team sizes and event popularity, 0 for uniform
+    size_t operations = 100000;  // per thread
+    std::array<unsigned, OPERATION_KINDS> mix = { { 60, 10, 10, 15, 5 } };  // relative weight per kind
+    size_t threads = 1;
+    std::uint64_t seed = 1;
+};
+
+// One operation; the arguments are ids and indexes so a stream can be written out and replayed
+struct Operation {
+    OperationKind kind;
+    int member;    // member id, or the id to add
+    int target;    // event index, or venue index for schedule checks
+    int minute;    // schedule checks: minutes since the first day of the season
+
+    bool operator==(const Operation& other) const {
+        return kind == other.kind && member == other.member && target == other.target && minute == other.minute;
+    }
+};
+
+// Per-thread operation streams over clubs built from the same config
+struct Workload {
+    WorkloadConfig config;
+    std::vector<std::vector<Operation>> streams;
+
+    void write(std::ostream& out) const;
+    static Workload read(std::istream& in);
+};
+
+// Latency figures of one operation kind, in nanoseconds
+struct OperationStats {
+    size_t count;
+    double p50;
+    double p99;
+    double p999;
+    double max;
+};
+
+// Outcome of running a workload
+struct WorkloadReport {
+    std::array<OperationStats, OPERATION_KINDS> operations;
+    size_t total_operations;
+    double seconds;                // wall time of the slowest thread
+    double throughput;             // operations per second over all threads
+    std::uint64_t result_digest;   // hash of every operation's result, equal across replays
+
+    void print(std::ostream& out) const;
+};
+
+// Builds synthetic clubs and operation streams, and runs streams against clubs
+// Each thread drives its own club: Club does no locking, so threads model independent
+// shards. Everything is derived from the config seed, so equal configs give equal clubs
+// and equal streams on every platform.
+class WorkloadDriver {
+public:
+    static const char* kindName(OperationKind kind);
+
+    static void populate(Club& club, const WorkloadConfig& config);
+    static Workload generate(const WorkloadConfig& config);
+    static WorkloadReport run(const Workload& workload);
+};
+
+#endif // WORKLOAD_H